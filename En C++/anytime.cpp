@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include "entidades.h"
+
+// Escala de punto fijo de la inflación: epsilon se guarda en sesentaicuatroavos para que las claves sigan
+// siendo enteras (prioridad g * 64 + epsilon * 64 * h en la parte alta, h en los 20 bits bajos)
+static const uint64_t ESCALA_EPSILON = 64;
+static const int BITS_DESEMPATE_ANYTIME = 20;
+
+// Expansiones entre dos consultas del reloj: acota el retraso sobre el plazo sin pagar una llamada por nodo
+static const size_t EXPANSIONES_ENTRE_RELOJ = 64;
+
+// Nodos y entradas de frontera que se reservan la primera vez: cubren las primeras iteraciones
+// de una consulta grande sin que el vector crezca con el plazo corriendo
+static const size_t NODOS_RESERVADOS_ANYTIME = 1 << 16;
+
+// Método que prepara una consulta nueva sobre un mapa con el número de celdas indicado
+void EspacioAnytime::empezar(size_t celdas) {
+    if (this->celdas.size() != celdas) {
+        // Primera consulta (o mapa de otro tamaño): un sello y un nodo por celda
+        this->celdas.assign(celdas, {0, -1});
+        nodos.reserve(std::min(celdas, NODOS_RESERVADOS_ANYTIME));
+        abiertos.reserve(std::min(celdas, NODOS_RESERVADOS_ANYTIME));
+        consulta = 0;
+    }
+    if (++consulta == 0) {
+        // El sello dio la vuelta: se limpian las marcas para no confundir celdas de consultas antiguas
+        for (CeldaAnytime& celda : this->celdas) celda.sello = 0;
+        consulta = 1;
+    }
+    nodos.clear();
+    abiertos.clear();
+    inconsistentes.clear();
+    frontera.clear();
+}
+
+// Método que devuelve la memoria que ocupa
+size_t EspacioAnytime::bytes() const {
+    return celdas.capacity() * sizeof(CeldaAnytime)
+         + nodos.capacity() * sizeof(NodoAnytime) + abiertos.capacity() * sizeof(std::pair<uint64_t, int>)
+         + (inconsistentes.capacity() + frontera.capacity()) * sizeof(int);
+}
+
+// Función de búsqueda anytime (ARA*): A* con la heurística inflada por epsilon que publica una primera
+// ruta enseguida y, mientras queda plazo, reduce epsilon y la mejora reutilizando el trabajo anterior.
+// En cada iteración las celdas cerradas cuyo coste mejora no se reabren: pasan a la lista de inconsistentes
+// y vuelven a la frontera al empezar la siguiente. La cota de suboptimalidad es el mínimo entre el epsilon
+// de la última iteración completa y g(destino) / mín(g + h) de la frontera y las inconsistentes.
+// El estado de las celdas vive en la memoria de trabajo de la grilla, así que la consulta solo paga por las
+// celdas que explora (la primera consulta sobre la grilla reserva un sello y un nodo por celda). Los obstáculos
+// se leen de la máscara de bits de visibilidad, que cabe en caché aunque el mapa no quepa.
+bool Grid::ARAStar(Celda& origen, Celda& destino, std::chrono::steady_clock::time_point plazo,
+                   const ConfiguracionAnytime& configuracion, ResultadoAnytime& resultado) {
+    auto inicio = std::chrono::steady_clock::now();
+    estadisticas.reiniciar(); // Restablecer las métricas de la consulta
+    MedicionMemoria memoria; // Medir la memoria que asigna la búsqueda
+    resultado = ResultadoAnytime();
+
+    int indiceDestino = destino.fila * columnas + destino.columna;
+    auto heuristica = [&](int celda) {
+        return (CosteBusqueda)(std::abs(celda / columnas - destino.fila) + std::abs(celda % columnas - destino.columna));
+    };
+    const MapaVisibilidad& mapa = mapaVisibilidad();
+    EspacioAnytime& espacio = espacioAnytime;
+    espacio.empezar((size_t)filas * columnas);
+    auto& nodos = espacio.nodos;
+    auto& inconsistentes = espacio.inconsistentes;
+    // Frontera como montículo mínimo sobre un vector (se recorre para la cota y al cambiar epsilon)
+    using Entrada = std::pair<uint64_t, int>;
+    auto& abiertos = espacio.abiertos;
+    auto mayorClave = [](const Entrada& a, const Entrada& b) { return a.first > b.first; };
+
+    double epsilonFinal = std::max(1.0, configuracion.epsilonFinal);
+    uint64_t epsilonFijo = (uint64_t)std::llround(std::max(epsilonFinal, configuracion.epsilonInicial) * ESCALA_EPSILON);
+    double epsilon = (double)epsilonFijo / ESCALA_EPSILON; // Inflación efectiva tras redondear
+    uint32_t iteracion = 1;
+    size_t expansionesSinReloj = 0;
+    int nodoDestino = -1;
+
+    auto prioridad = [&](const NodoAnytime& nodo) {
+        return (uint64_t)nodo.g * ESCALA_EPSILON + epsilonFijo * nodo.h;
+    };
+    // La entrada mínima se guarda fuera del montículo: con la heurística inflada el vecino que avanza hacia
+    // el destino suele ser el siguiente en salir, y así entra y sale en O(1) sin recorrer el montículo
+    Entrada primera;
+    bool hayPrimera = false;
+    auto apilar = [&](const Entrada& entrada) {
+        abiertos.push_back(entrada);
+        std::push_heap(abiertos.begin(), abiertos.end(), mayorClave);
+    };
+    auto insertar = [&](int nodo) {
+        Entrada entrada = {prioridad(nodos[nodo]) << BITS_DESEMPATE_ANYTIME | std::min<CosteBusqueda>(nodos[nodo].h, 0xFFFFF), nodo};
+        if (hayPrimera && entrada.first < primera.first) {
+            apilar(primera);
+            primera = entrada;
+        } else if (!hayPrimera && (abiertos.empty() || entrada.first <= abiertos.front().first)) {
+            primera = entrada;
+            hayPrimera = true;
+        } else {
+            apilar(entrada);
+        }
+        estadisticas.insercionesCola++;
+    };
+    auto cima = [&]() -> const Entrada& {
+        return hayPrimera ? primera : abiertos.front();
+    };
+    auto sacar = [&]() {
+        if (hayPrimera) {
+            hayPrimera = false;
+        } else {
+            std::pop_heap(abiertos.begin(), abiertos.end(), mayorClave);
+            abiertos.pop_back();
+        }
+    };
+    // Recorre todas las entradas de la frontera (la mínima y las del montículo)
+    auto recorrerAbiertos = [&](auto&& visitar) {
+        if (hayPrimera) visitar(primera);
+        for (const Entrada& entrada : abiertos) visitar(entrada);
+    };
+    // Una entrada es vigente si su prioridad coincide con la del nodo y el nodo sigue abierto
+    auto vigente = [&](const Entrada& entrada) {
+        const NodoAnytime& nodo = nodos[entrada.second];
+        return (entrada.first >> BITS_DESEMPATE_ANYTIME) == prioridad(nodo) && nodo.cerradoEn != iteracion;
+    };
+    auto prioridadDestino = [&]() {
+        return nodoDestino < 0 ? UINT64_MAX : prioridad(nodos[nodoDestino]);
+    };
+
+    // Expande hasta que el destino tiene la menor prioridad de la frontera; devuelve false si vence el plazo
+    auto mejorarRuta = [&]() {
+        while (hayPrimera || !abiertos.empty()) {
+            // El reloj no se consulta en la primera expansión: el plazo se comprueba al terminar cada tanda
+            if (++expansionesSinReloj % EXPANSIONES_ENTRE_RELOJ == 0 && std::chrono::steady_clock::now() >= plazo) {
+                return false;
+            }
+            Entrada entrada = cima();
+            if (vigente(entrada) && prioridadDestino() <= (entrada.first >> BITS_DESEMPATE_ANYTIME)) return true;
+            sacar();
+            estadisticas.extraccionesCola++;
+            if (!vigente(entrada)) continue; // Entrada obsoleta
+            int actual = entrada.second;
+            nodos[actual].cerradoEn = iteracion;
+            estadisticas.nodosExpandidos++;
+
+            int fila = nodos[actual].celda / columnas, columna = nodos[actual].celda % columnas;
+            CosteBusqueda nuevoG = nodos[actual].g + 1;
+            for (int d = 0; d < 4; d++) {
+                int nuevaFila = fila + DESPLAZAMIENTO_FLUJO[d][0];
+                int nuevaColumna = columna + DESPLAZAMIENTO_FLUJO[d][1];
+                if (nuevaFila < 0 || nuevaFila >= filas || nuevaColumna < 0 || nuevaColumna >= columnas) continue;
+                if (mapa.bloqueada(nuevaFila, nuevaColumna)) continue;
+                estadisticas.nodosGenerados++;
+                int vecina = nuevaFila * columnas + nuevaColumna;
+                CeldaAnytime& entradaCelda = espacio.celdas[vecina];
+                int nodo;
+                if (entradaCelda.sello == espacio.consulta) {
+                    nodo = entradaCelda.nodo;
+                } else {
+                    nodo = (int)nodos.size();
+                    entradaCelda = {espacio.consulta, nodo};
+                    nodos.push_back({vecina, -1, COSTE_INFINITO, heuristica(vecina), 0, 0});
+                    if (vecina == indiceDestino) nodoDestino = nodo;
+                }
+                NodoAnytime& vecino = nodos[nodo];
+                if (nuevoG >= vecino.g) continue;
+                vecino.g = nuevoG;
+                vecino.padre = actual;
+                if (vecino.cerradoEn != iteracion) {
+                    insertar(nodo);
+                } else if (vecino.inconsistenteEn != iteracion) {
+                    vecino.inconsistenteEn = iteracion;
+                    inconsistentes.push_back(nodo);
+                }
+            }
+            estadisticas.registrarFrontera(abiertos.size() + hayPrimera);
+        }
+        return true;
+    };
+
+    // Publica la ruta actual con su cota; con la iteración cortada por el plazo solo vale el epsilon anterior
+    auto publicar = [&](bool completa) {
+        if (nodoDestino < 0 || nodos[nodoDestino].g == COSTE_INFINITO) return;
+        CosteBusqueda costeDestino = nodos[nodoDestino].g;
+        CosteBusqueda minimo = COSTE_INFINITO;
+        recorrerAbiertos([&](const Entrada& entrada) {
+            if (vigente(entrada)) minimo = std::min(minimo, nodos[entrada.second].g + nodos[entrada.second].h);
+        });
+        for (int nodo : inconsistentes) minimo = std::min(minimo, nodos[nodo].g + nodos[nodo].h);
+        double cota = minimo == COSTE_INFINITO || minimo == 0 ? 1.0 : (double)costeDestino / minimo;
+        if (completa) cota = std::min(cota, epsilon);
+        else if (resultado.epsilon > 0) cota = std::min(cota, resultado.epsilon);
+        cota = std::max(1.0, cota);
+        if (!resultado.mejoras.empty() && resultado.mejoras.back().coste == costeDestino && resultado.mejoras.back().cota <= cota) return;
+        double tiempoMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+        resultado.mejoras.push_back({completa ? epsilon : resultado.epsilon, cota, costeDestino, tiempoMs, estadisticas.nodosExpandidos});
+        resultado.cota = cota;
+    };
+
+    int indiceOrigen = origen.fila * columnas + origen.columna;
+    nodos.push_back({indiceOrigen, -1, 0, heuristica(indiceOrigen), 0, 0});
+    espacio.celdas[indiceOrigen] = {espacio.consulta, 0};
+    if (indiceOrigen == indiceDestino) nodoDestino = 0;
+    insertar(0);
+
+    while (true) {
+        bool completa = mejorarRuta();
+        if (completa) resultado.epsilon = epsilon;
+        publicar(completa);
+        if (!completa) {
+            resultado.plazoAgotado = true;
+            break;
+        }
+        // Sin ruta (frontera agotada) o con la cota pedida ya demostrada no hay nada que mejorar
+        if (nodoDestino < 0 || resultado.cota <= epsilonFinal) break;
+        if (std::chrono::steady_clock::now() >= plazo) {
+            resultado.plazoAgotado = true;
+            break;
+        }
+
+        // Siguiente epsilon: el decremento configurado, sin pasar de la cota ya demostrada ni bajar del final
+        double siguiente = configuracion.decremento > 0 ? epsilon - configuracion.decremento : epsilonFinal;
+        siguiente = std::max(epsilonFinal, std::min(siguiente, resultado.cota));
+        // La frontera vigente y las inconsistentes forman la nueva frontera con las prioridades del nuevo epsilon
+        auto& frontera = espacio.frontera;
+        frontera.assign(inconsistentes.begin(), inconsistentes.end());
+        recorrerAbiertos([&](const Entrada& entrada) {
+            if (vigente(entrada)) frontera.push_back(entrada.second);
+        });
+        inconsistentes.clear();
+        abiertos.clear();
+        hayPrimera = false;
+        iteracion++;
+        epsilonFijo = (uint64_t)std::llround(siguiente * ESCALA_EPSILON);
+        epsilon = (double)epsilonFijo / ESCALA_EPSILON;
+        for (int nodo : frontera) insertar(nodo);
+    }
+
+    if (nodoDestino >= 0 && nodos[nodoDestino].g != COSTE_INFINITO) {
+        // Los padres siempre forman una ruta válida de coste a lo sumo g(destino), aunque el plazo corte una iteración
+        for (int nodo = nodoDestino; nodo >= 0; nodo = nodos[nodo].padre) resultado.ruta.push_back(nodos[nodo].celda);
+        std::reverse(resultado.ruta.begin(), resultado.ruta.end());
+        resultado.encontrada = true;
+        resultado.coste = (uint32_t)resultado.ruta.size() - 1;
+    }
+    estadisticas.bytesAuxiliares = memoria.bytesPico();
+    estadisticas.bytesVivos = memoria.bytesVivos();
+    estadisticas.asignaciones = memoria.asignaciones();
+    if (configuracion.marcarEnGrilla) {
+        EstadisticasBusqueda medidas = estadisticas;
+        marcarRutaIndices(resultado.ruta);
+        estadisticas = medidas;
+    }
+    estadisticas.longitudRuta = resultado.coste;
+    return resultado.encontrada;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "memoria.h"
+
+// Configuración de la búsqueda anytime: inflación inicial de la heurística, cuánto se reduce tras cada
+// solución y la inflación a la que se detiene (1: hasta demostrar que la ruta es óptima)
+struct ConfiguracionAnytime {
+    double epsilonInicial = 3.0;
+    double decremento = 0.5;
+    double epsilonFinal = 1.0;
+    // Marcar la ruta en la grilla como las demás búsquedas. Reiniciar la grilla cuesta lo mismo que recorrer
+    // todo el mapa; con false la consulta solo paga por las celdas exploradas y la ruta queda en el resultado
+    bool marcarEnGrilla = true;
+};
+
+// Estructura con una de las soluciones que publica la búsqueda anytime
+struct MejoraAnytime {
+    double epsilon;        // Inflación de la iteración que la encontró
+    double cota;           // Cota de suboptimalidad demostrada: coste <= cota * óptimo
+    uint32_t coste;        // Pasos de la ruta
+    double tiempoMs;       // Tiempo desde el inicio de la consulta
+    size_t expandidos;     // Nodos expandidos hasta entonces (todas las iteraciones)
+};
+
+// Estructura con el resultado de una búsqueda anytime
+struct ResultadoAnytime {
+    bool encontrada = false;     // Se publicó una ruta (aunque el plazo cortase alguna iteración)
+    bool plazoAgotado = false;   // La búsqueda se detuvo por el plazo y no por llegar a epsilonFinal
+    uint32_t coste = 0;          // Pasos de la mejor ruta (sin significado si no se publicó ninguna)
+    double epsilon = 0;          // Inflación de la última iteración completa (0 si ninguna terminó)
+    // Cota de suboptimalidad de la mejor ruta (1: óptima); infinita si no se publicó ninguna ruta
+    double cota = std::numeric_limits<double>::infinity();
+    std::vector<MejoraAnytime> mejoras; // Soluciones publicadas, de la primera a la última
+    std::vector<int> ruta;       // Índices (por filas) de la mejor ruta, del origen al destino
+};
+
+// Estado de búsqueda de una celda alcanzada por ARA*
+struct NodoAnytime {
+    int celda;                // Índice por filas
+    int padre;                // Nodo padre (-1 en el origen)
+    uint32_t g;
+    uint32_t h;
+    uint32_t cerradoEn;       // Iteración en la que se expandió por última vez (0: nunca)
+    uint32_t inconsistenteEn; // Iteración en la que se apuntó como inconsistente (0: nunca)
+};
+
+// Entrada por celda de la memoria de trabajo: sello y nodo juntos para leerlos con un solo acceso
+struct CeldaAnytime {
+    uint32_t sello; // Consulta en la que se alcanzó la celda
+    int32_t nodo;   // Nodo de la celda en la consulta de su sello
+};
+
+// Memoria de trabajo de ARA* que la grilla conserva entre consultas. Cada celda guarda el sello de la
+// consulta en la que se alcanzó y su nodo, así que empezar una consulta es O(1) (basta con cambiar de sello)
+// y los vectores conservan su capacidad: con el plazo corriendo no se reserva memoria ni se rehace una tabla.
+struct EspacioAnytime {
+    std::vector<CeldaAnytime, AsignadorContador<CeldaAnytime>> celdas;
+    uint32_t consulta = 0;
+    std::vector<NodoAnytime, AsignadorContador<NodoAnytime>> nodos;
+    std::vector<std::pair<uint64_t, int>, AsignadorContador<std::pair<uint64_t, int>>> abiertos;
+    std::vector<int, AsignadorContador<int>> inconsistentes;
+    std::vector<int, AsignadorContador<int>> frontera;
+
+    // Método que prepara una consulta nueva sobre un mapa con el número de celdas indicado
+    void empezar(size_t celdas);
+
+    // Método que devuelve la memoria que ocupa
+    size_t bytes() const;
+};
@@ -0,0 +1,59 @@
+#include <algorithm>
+#include "arboles.h"
+
+// Método que reconstruye, recorriendo el árbol, la ruta del origen al destino (índices por filas)
+bool ArbolCaminos::reconstruir(int destino, std::vector<int>& ruta) const {
+    ruta.clear();
+    if (!contiene(destino)) return false;
+    // Desplazamiento del índice según la dirección hacia el padre
+    const int desplazamiento[4] = {-columnas, columnas, -1, 1};
+    int actual = destino;
+    ruta.push_back(actual);
+    while (actual != origen) {
+        actual += desplazamiento[padres.obtener(actual)];
+        ruta.push_back(actual);
+    }
+    std::reverse(ruta.begin(), ruta.end());
+    return true;
+}
+
+// Constructor con el número máximo de árboles
+AlmacenArboles::AlmacenArboles(size_t capacidad) : capacidad(capacidad) {}
+
+// Método que busca el árbol de un origen para la versión del mapa indicada
+const ArbolCaminos* AlmacenArboles::buscar(int origen, uint64_t version) {
+    for (size_t k = 0; k < arboles.size(); k++) {
+        if (arboles[k].origen == origen && arboles[k].version == version) {
+            // Lo movemos al frente para que sea el último en expulsarse
+            std::rotate(arboles.begin(), arboles.begin() + k, arboles.begin() + k + 1);
+            aciertos++;
+            return &arboles.front();
+        }
+    }
+    fallos++;
+    return nullptr;
+}
+
+// Método que guarda un árbol nuevo, sustituyendo al del mismo origen o al más antiguo
+void AlmacenArboles::guardar(ArbolCaminos&& arbol) {
+    if (capacidad == 0) return;
+    arboles.erase(std::remove_if(arboles.begin(), arboles.end(),
+                                 [&](const ArbolCaminos& a) { return a.origen == arbol.origen || a.version != arbol.version; }),
+                  arboles.end());
+    if (arboles.size() >= capacidad) {
+        arboles.pop_back();
+    }
+    arboles.insert(arboles.begin(), std::move(arbol));
+}
+
+// Método que descarta todos los árboles
+void AlmacenArboles::vaciar() {
+    arboles.clear();
+}
+
+// Método que devuelve los bytes ocupados por todos los árboles
+size_t AlmacenArboles::bytes() const {
+    size_t total = 0;
+    for (const ArbolCaminos& arbol : arboles) total += arbol.bytes();
+    return total;
+}
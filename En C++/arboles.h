@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "direcciones.h"
+
+// Árbol de caminos mínimos desde un origen, guardado de forma compacta:
+// 2 bits por celda con la dirección hacia el padre y 1 bit que indica si la celda está en el árbol
+struct ArbolCaminos {
+    int origen = -1;      // Índice (por filas) de la raíz del árbol
+    uint64_t version = 0; // Versión del mapa con la que se calculó
+    bool completo = false; // La búsqueda exploró toda la región alcanzable (si falta una celda, no hay ruta)
+    int columnas = 0;
+    DireccionesEmpaquetadas<2> padres;
+    MapaBits enArbol;
+
+    // Método que indica si la celda tiene un camino conocido desde el origen
+    bool contiene(int indice) const {
+        return enArbol.contiene(indice);
+    }
+
+    // Método que reconstruye, recorriendo el árbol, la ruta del origen al destino (índices por filas)
+    bool reconstruir(int destino, std::vector<int>& ruta) const;
+
+    // Método que devuelve los bytes ocupados por el árbol
+    size_t bytes() const {
+        return padres.bytes() + enArbol.bytes();
+    }
+};
+
+// Clase que conserva los árboles de las últimas búsquedas para responder consultas
+// desde el mismo origen sin volver a buscar
+class AlmacenArboles {
+private:
+    std::vector<ArbolCaminos> arboles; // Del más reciente (delante) al más antiguo (detrás)
+    size_t capacidad;                  // Número máximo de árboles conservados
+    size_t aciertos = 0;
+    size_t fallos = 0;
+
+public:
+    // Constructor con el número máximo de árboles
+    explicit AlmacenArboles(size_t capacidad = 8);
+
+    // Método que busca el árbol de un origen para la versión del mapa indicada
+    const ArbolCaminos* buscar(int origen, uint64_t version);
+
+    // Método que guarda un árbol nuevo, sustituyendo al del mismo origen o al más antiguo
+    void guardar(ArbolCaminos&& arbol);
+
+    // Método que descarta todos los árboles
+    void vaciar();
+
+    // Métodos para consultar el uso del almacén
+    size_t obtenerAciertos() const { return aciertos; }
+    size_t obtenerFallos() const { return fallos; }
+    size_t bytes() const;
+};
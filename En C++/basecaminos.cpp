@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <fstream>
+#include <thread>
+#include "entidades.h"
+#include "basecaminos.h"
+
+// Identificador de los archivos de la base de caminos y versión de su formato
+const char FIRMA_BASE_CAMINOS[4] = {'P', 'F', 'C', 'P'};
+const uint32_t FORMATO_BASE_CAMINOS = 1;
+// Marca de "cualquier movimiento" en una fila: el propio origen y las celdas inalcanzables
+// no necesitan movimiento, así que se funden con el tramo anterior
+const uint8_t MOVIMIENTO_INDIFERENTE = 255;
+
+// Método que numera las celdas libres en orden DFS y calcula sus componentes
+void BaseCaminos::numerarCeldas(const Grid& grid) {
+    filas = grid.obtenerFilas();
+    columnas = grid.obtenerColumnas();
+    nodoCelda.assign((size_t)filas * columnas, -1);
+    celdaNodo.clear();
+    componente.clear();
+
+    std::vector<int> pila;
+    int componenteActual = 0;
+    for (int inicio = 0; inicio < filas * columnas; inicio++) {
+        if (nodoCelda[inicio] >= 0 || grid.obtenerCelda(inicio / columnas, inicio % columnas).estado == BLOQUEADO) continue;
+        pila.push_back(inicio);
+        while (!pila.empty()) {
+            int celda = pila.back();
+            pila.pop_back();
+            if (nodoCelda[celda] >= 0) continue;
+            nodoCelda[celda] = (int)celdaNodo.size();
+            celdaNodo.push_back(celda);
+            componente.push_back(componenteActual);
+            // Se apilan en orden inverso para visitar primero arriba, abajo, izquierda, derecha
+            for (int d = 3; d >= 0; d--) {
+                int nuevaFila = celda / columnas + DESPLAZAMIENTO_FLUJO[d][0];
+                int nuevaColumna = celda % columnas + DESPLAZAMIENTO_FLUJO[d][1];
+                if (nuevaFila < 0 || nuevaFila >= filas || nuevaColumna < 0 || nuevaColumna >= columnas) continue;
+                int vecina = nuevaFila * columnas + nuevaColumna;
+                if (nodoCelda[vecina] < 0 && grid.obtenerCelda(nuevaFila, nuevaColumna).estado != BLOQUEADO) {
+                    pila.push_back(vecina);
+                }
+            }
+        }
+        componenteActual++;
+    }
+}
+
+// Método que construye la base con un BFS desde cada celda libre, repartido entre hilos
+void BaseCaminos::construir(const Grid& grid) {
+    numerarCeldas(grid);
+    size_t n = celdaNodo.size();
+    std::vector<std::vector<uint32_t>> tramosOrigen(n);
+
+    // Vecinos de cada nodo por dirección (-1 si no hay), para que el BFS no toque la grilla
+    std::vector<int> vecinos(n * 4, -1);
+    for (size_t v = 0; v < n; v++) {
+        for (int d = 0; d < 4; d++) {
+            int nuevaFila = celdaNodo[v] / columnas + DESPLAZAMIENTO_FLUJO[d][0];
+            int nuevaColumna = celdaNodo[v] % columnas + DESPLAZAMIENTO_FLUJO[d][1];
+            if (nuevaFila < 0 || nuevaFila >= filas || nuevaColumna < 0 || nuevaColumna >= columnas) continue;
+            vecinos[v * 4 + d] = nodoCelda[nuevaFila * columnas + nuevaColumna];
+        }
+    }
+
+    unsigned hilos = std::max(1u, std::thread::hardware_concurrency());
+    hilos = (unsigned)std::min<size_t>(hilos, std::max<size_t>(1, n / 64));
+    auto tarea = [&](unsigned primero) {
+        // Memoria de trabajo del hilo: movimiento inicial por número DFS y cola del BFS
+        std::vector<uint8_t> movimiento(n);
+        std::vector<int> cola;
+        cola.reserve(n);
+        for (size_t origen = primero; origen < n; origen += hilos) {
+            std::fill(movimiento.begin(), movimiento.end(), MOVIMIENTO_INDIFERENTE);
+            cola.clear();
+            // Los vecinos del origen heredan su propia dirección; el resto, la de quien los alcanzó
+            for (int d = 0; d < 4; d++) {
+                int vecino = vecinos[origen * 4 + d];
+                if (vecino < 0) continue;
+                movimiento[vecino] = (uint8_t)d;
+                cola.push_back(vecino);
+            }
+            for (size_t frente = 0; frente < cola.size(); frente++) {
+                int nodo = cola[frente];
+                uint8_t heredado = movimiento[nodo];
+                for (int d = 0; d < 4; d++) {
+                    int vecino = vecinos[nodo * 4 + d];
+                    if (vecino < 0 || vecino == (int)origen || movimiento[vecino] != MOVIMIENTO_INDIFERENTE) continue;
+                    movimiento[vecino] = heredado;
+                    cola.push_back(vecino);
+                }
+            }
+
+            // Compresión por tramos: solo se guarda un tramo cuando cambia el movimiento
+            std::vector<uint32_t>& fila = tramosOrigen[origen];
+            uint8_t ultimo = MOVIMIENTO_INDIFERENTE;
+            for (size_t destino = 0; destino < n; destino++) {
+                uint8_t m = movimiento[destino];
+                if (m == MOVIMIENTO_INDIFERENTE || m == ultimo) continue;
+                fila.push_back(((fila.empty() ? 0u : (uint32_t)destino) << 2) | m);
+                ultimo = m;
+            }
+            fila.shrink_to_fit();
+        }
+    };
+    std::vector<std::thread> trabajadores;
+    for (unsigned k = 1; k < hilos; k++) {
+        trabajadores.emplace_back(tarea, k);
+    }
+    tarea(0);
+    for (std::thread& trabajador : trabajadores) {
+        trabajador.join();
+    }
+
+    // Unimos las filas en un único arreglo con sus desplazamientos
+    inicioFila.assign(n + 1, 0);
+    for (size_t origen = 0; origen < n; origen++) {
+        inicioFila[origen + 1] = inicioFila[origen] + tramosOrigen[origen].size();
+    }
+    tramos.clear();
+    tramos.reserve(inicioFila[n]);
+    for (std::vector<uint32_t>& fila : tramosOrigen) {
+        tramos.insert(tramos.end(), fila.begin(), fila.end());
+        std::vector<uint32_t>().swap(fila);
+    }
+
+    huella = huellaMapa(grid);
+    version = grid.obtenerVersion();
+    construida = true;
+}
+
+// Método que guarda la base en un archivo binario (en el orden de bytes de la máquina)
+bool BaseCaminos::guardar(const std::string& archivo) const {
+    if (!construida) return false; // Sin base no se abre (ni se trunca) el archivo
+    std::ofstream salida(archivo, std::ios::binary);
+    if (!salida) return false;
+    uint64_t nodos = celdaNodo.size();
+    uint64_t totalTramos = tramos.size();
+    salida.write(FIRMA_BASE_CAMINOS, sizeof(FIRMA_BASE_CAMINOS));
+    salida.write((const char*)&FORMATO_BASE_CAMINOS, sizeof(FORMATO_BASE_CAMINOS));
+    salida.write((const char*)&filas, sizeof(filas));
+    salida.write((const char*)&columnas, sizeof(columnas));
+    salida.write((const char*)&huella, sizeof(huella));
+    salida.write((const char*)&nodos, sizeof(nodos));
+    salida.write((const char*)&totalTramos, sizeof(totalTramos));
+    salida.write((const char*)celdaNodo.data(), nodos * sizeof(int));
+    salida.write((const char*)componente.data(), nodos * sizeof(int));
+    salida.write((const char*)inicioFila.data(), (nodos + 1) * sizeof(uint64_t));
+    salida.write((const char*)tramos.data(), totalTramos * sizeof(uint32_t));
+    return (bool)salida;
+}
+
+// Método que carga una base de un archivo binario y comprueba que corresponde a la grilla. Antes de
+// usarla se validan los índices: un archivo dañado con la huella correcta no debe leer fuera de los vectores
+bool BaseCaminos::cargar(const std::string& archivo, const Grid& grid) {
+    std::ifstream entrada(archivo, std::ios::binary);
+    if (!entrada) return false;
+    char firma[4];
+    uint32_t formato = 0;
+    int filasArchivo = 0, columnasArchivo = 0;
+    uint64_t huellaArchivo = 0, nodos = 0, totalTramos = 0;
+    entrada.read(firma, sizeof(firma));
+    entrada.read((char*)&formato, sizeof(formato));
+    entrada.read((char*)&filasArchivo, sizeof(filasArchivo));
+    entrada.read((char*)&columnasArchivo, sizeof(columnasArchivo));
+    entrada.read((char*)&huellaArchivo, sizeof(huellaArchivo));
+    entrada.read((char*)&nodos, sizeof(nodos));
+    entrada.read((char*)&totalTramos, sizeof(totalTramos));
+    if (!entrada || !std::equal(firma, firma + 4, FIRMA_BASE_CAMINOS) || formato != FORMATO_BASE_CAMINOS) return false;
+    if (filasArchivo != grid.obtenerFilas() || columnasArchivo != grid.obtenerColumnas()) return false;
+    if (huellaArchivo != huellaMapa(grid)) return false; // La base es de otro mapa
+    if (nodos > (uint64_t)filasArchivo * columnasArchivo) return false;
+
+    std::vector<int> celdas(nodos), componentes(nodos);
+    std::vector<uint64_t> inicios(nodos + 1);
+    std::vector<uint32_t> lista(totalTramos);
+    entrada.read((char*)celdas.data(), nodos * sizeof(int));
+    entrada.read((char*)componentes.data(), nodos * sizeof(int));
+    entrada.read((char*)inicios.data(), (nodos + 1) * sizeof(uint64_t));
+    entrada.read((char*)lista.data(), totalTramos * sizeof(uint32_t));
+    if (!entrada || inicios[0] != 0 || inicios[nodos] != totalTramos) return false;
+
+    // Cada número DFS corresponde a una celda libre distinta de la grilla
+    size_t totalCeldas = (size_t)filasArchivo * columnasArchivo;
+    std::vector<int> numeros(totalCeldas, -1);
+    for (size_t v = 0; v < nodos; v++) {
+        if (celdas[v] < 0 || (size_t)celdas[v] >= totalCeldas || numeros[celdas[v]] >= 0) return false;
+        if (grid.obtenerCelda(celdas[v] / columnasArchivo, celdas[v] % columnasArchivo).estado == BLOQUEADO) return false;
+        numeros[celdas[v]] = (int)v;
+    }
+    // Filas de tramos consecutivas; dentro de cada fila los números empiezan en 0 y crecen, y cada
+    // movimiento lleva desde la celda del origen a una celda libre dentro de la grilla
+    for (size_t v = 0; v < nodos; v++) {
+        if (inicios[v] > inicios[v + 1]) return false;
+    }
+    for (size_t v = 0; v < nodos; v++) {
+        int fila = celdas[v] / columnasArchivo, columna = celdas[v] % columnasArchivo;
+        for (uint64_t t = inicios[v]; t < inicios[v + 1]; t++) {
+            uint32_t numero = lista[t] >> 2;
+            if (numero >= nodos) return false;
+            if (t == inicios[v] ? numero != 0 : numero <= (lista[t - 1] >> 2)) return false;
+            int nuevaFila = fila + DESPLAZAMIENTO_FLUJO[lista[t] & 3u][0];
+            int nuevaColumna = columna + DESPLAZAMIENTO_FLUJO[lista[t] & 3u][1];
+            if (nuevaFila < 0 || nuevaFila >= filasArchivo || nuevaColumna < 0 || nuevaColumna >= columnasArchivo) return false;
+            if (numeros[(size_t)nuevaFila * columnasArchivo + nuevaColumna] < 0) return false;
+        }
+    }
+
+    filas = filasArchivo;
+    columnas = columnasArchivo;
+    huella = huellaArchivo;
+    celdaNodo = std::move(celdas);
+    componente = std::move(componentes);
+    inicioFila = std::move(inicios);
+    tramos = std::move(lista);
+    nodoCelda = std::move(numeros);
+    version = grid.obtenerVersion();
+    construida = true;
+    return true;
+}
+
+// Método que indica si la base corresponde a la versión actual del mapa de la grilla
+bool BaseCaminos::sincronizada(const Grid& grid) const {
+    return construida && version == grid.obtenerVersion()
+        && filas == grid.obtenerFilas() && columnas == grid.obtenerColumnas();
+}
+
+// Método que devuelve el primer movimiento de una ruta mínima: el del último tramo de la fila
+// del origen que empieza antes del número DFS del destino
+uint8_t BaseCaminos::primerMovimiento(int origen, int destino) const {
+    int nodoOrigen = nodoCelda[origen];
+    uint32_t clave = ((uint32_t)nodoCelda[destino] << 2) | 3u;
+    auto inicio = tramos.begin() + inicioFila[nodoOrigen];
+    auto fin = tramos.begin() + inicioFila[nodoOrigen + 1];
+    auto tramo = std::upper_bound(inicio, fin, clave);
+    return (uint8_t)(*(tramo - 1) & 3u);
+}
+
+// Método que extrae la ruta entre dos celdas como índices por filas, un movimiento por consulta
+bool BaseCaminos::extraerRuta(int origen, int destino, std::vector<int>& ruta) const {
+    ruta.clear();
+    if (nodoCelda[origen] < 0 || nodoCelda[destino] < 0) return false;
+    if (componente[nodoCelda[origen]] != componente[nodoCelda[destino]]) return false;
+    ruta.push_back(origen);
+    int actual = origen;
+    while (actual != destino) {
+        uint8_t m = primerMovimiento(actual, destino);
+        actual += DESPLAZAMIENTO_FLUJO[m][0] * columnas + DESPLAZAMIENTO_FLUJO[m][1];
+        ruta.push_back(actual);
+    }
+    return true;
+}
+
+// Método que devuelve los bytes ocupados por la base
+size_t BaseCaminos::bytes() const {
+    return (nodoCelda.size() + celdaNodo.size() + componente.size()) * sizeof(int)
+         + inicioFila.size() * sizeof(uint64_t) + tramos.size() * sizeof(uint32_t);
+}
+
+// Función de búsqueda con la base de caminos: la ruta se extrae consultando el primer movimiento
+// paso a paso (si la base no está sincronizada con la versión del mapa, se responde con BFS)
+bool Grid::buscarConBaseCaminos(const BaseCaminos& base, Celda& origen, Celda& destino) {
+    if (!base.sincronizada(*this)) {
+        return BFS(origen, destino);
+    }
+    MedicionMemoria memoria;
+    EstadisticasBusqueda medidas;
+    std::vector<int> ruta;
+    bool encontrada = base.extraerRuta(indiceCelda(origen), indiceCelda(destino), ruta);
+    marcarRutaIndices(ruta); // Misma representación RUTA que el resto de búsquedas
+    // Cada paso de la ruta es una consulta a la tabla (no se explora ningún vecino)
+    medidas.nodosExpandidos = ruta.empty() ? 0 : ruta.size() - 1;
+    medidas.longitudRuta = estadisticas.longitudRuta;
+    estadisticas = medidas;
+    estadisticas.bytesAuxiliares = memoria.bytesPico();
+    estadisticas.bytesVivos = memoria.bytesVivos();
+    estadisticas.asignaciones = memoria.asignaciones();
+    return encontrada;
+}
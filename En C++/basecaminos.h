@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Grid;
+
+// Clase con una base de caminos comprimida (CPD): para cada celda libre guarda el primer
+// movimiento de una ruta mínima hacia cualquier otra celda. Las celdas se numeran en orden
+// de recorrido en profundidad (DFS), así las celdas cercanas comparten número cercano y
+// primer movimiento, y cada fila se comprime en tramos (número inicial, movimiento).
+// Extraer una ruta cuesta una búsqueda binaria en una fila por paso, sin explorar la grilla.
+class BaseCaminos {
+private:
+    int filas = 0;
+    int columnas = 0;
+    uint64_t version = 0;   // Versión del mapa con la que está sincronizada
+    uint64_t huella = 0;    // Huella del mapa de celdas bloqueadas (para validar archivos)
+    bool construida = false;
+    std::vector<int> nodoCelda;   // Número DFS de cada celda (-1 si está bloqueada)
+    std::vector<int> celdaNodo;   // Celda (índice por filas) de cada número DFS
+    std::vector<int> componente;  // Componente conexa de cada número DFS
+    std::vector<uint64_t> inicioFila; // Primer tramo de la fila de cada origen
+    std::vector<uint32_t> tramos;     // (primer número DFS << 2) | movimiento, ordenados por número
+
+    // Método que numera las celdas libres en orden DFS y calcula sus componentes
+    void numerarCeldas(const Grid& grid);
+
+public:
+    // Método que construye la base con un BFS desde cada celda libre, repartido entre hilos
+    void construir(const Grid& grid);
+
+    // Método que guarda la base en un archivo binario; devuelve false si no se puede escribir
+    bool guardar(const std::string& archivo) const;
+
+    // Método que carga una base de un archivo binario; devuelve false si el archivo no es
+    // válido o no corresponde a las celdas bloqueadas de la grilla
+    bool cargar(const std::string& archivo, const Grid& grid);
+
+    // Método que indica si la base corresponde a la versión actual del mapa de la grilla
+    bool sincronizada(const Grid& grid) const;
+
+    // Método que devuelve el primer movimiento (FLUJO_ARRIBA..FLUJO_DERECHA) de una ruta mínima
+    // entre dos celdas libres distintas de la misma componente
+    uint8_t primerMovimiento(int origen, int destino) const;
+
+    // Método que extrae la ruta entre dos celdas como índices por filas, un movimiento por consulta;
+    // devuelve false si no existe
+    bool extraerRuta(int origen, int destino, std::vector<int>& ruta) const;
+
+    // Métodos para consultar el tamaño de la base
+    size_t numeroTramos() const { return tramos.size(); }
+    size_t bytes() const;
+};
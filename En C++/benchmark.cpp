@@ -0,0 +1,1041 @@
+// Suite de microbenchmarks para los algoritmos de la grilla (sin interfaz gráfica).
+// Recorre el producto de generadores de mapas, tamaños, densidades, disposiciones en memoria y algoritmos,
+// repite cada caso varias veces y resume los tiempos con media, mediana y desviación.
+// Uso:
+//   benchmark [--tamanos=64,128] [--densidades=0.1,0.3] [--generadores=abierto,aleatorio,laberinto,habitaciones,perlin]
+//             [--algoritmos=BFS,BFSArboles,DStarLite,CampoFlujo,BFSCacheado,Subobjetivos,Jerarquia,BaseCaminos,ThetaPerezoso,BFSSuavizado,DStarLiteLIFO,ARAStar,Kernel8Real,...]
+//             [--disposiciones=filas,mosaico,morton]
+//             [--repeticiones=5] [--semilla=1] [--filtro=texto] [--json=archivo]
+//             [--escenarios=archivo.scen] [--mapa=archivo.map] [--colas=operaciones]
+//             [--dinamico=agentes,lotes,cambios] [--cooperativo=agentes,ventana,pasos]
+//             [--mapf=agentes,...] [--pesos=1,1.5] [--tiempo-mapf=ms] [--guardar-mapf=directorio]
+//             [--anytime=plazoMs,...]
+// Con --escenarios se sustituyen los mapas generados por un mapa MovingAI y sus consultas: cada repetición
+// ejecuta todas las consultas y el tiempo que se informa es el medio por consulta.
+// Con --dinamico se registran agentes en cada mapa generado y se empujan lotes de cambios de obstáculos:
+// se compara la reparación incremental con repetir un BFS por agente tras cada lote.
+// Con --cooperativo se planifican muchos agentes a la vez con reservas espacio-tiempo (WHCA*) en cada mapa
+// generado y se comprueba que el plan no tiene choques.
+// Con --mapf se resuelven problemas multiagente con CBS (peso 1) y ECBS (peso mayor que 1) para cada número
+// de agentes indicado: los k primeros agentes de un archivo de escenarios en formato MAPF (el .scen de MovingAI),
+// que se genera sobre cada mapa generado o se lee con --escenarios. Con --guardar-mapf se escriben los
+// .map y .scen generados para compararlos con otros resolutores.
+// Con --anytime se ejecuta ARA* en cada mapa generado con cada plazo y se compara la cota de suboptimalidad
+// que informa con la real (respecto a la ruta óptima de BFS).
+// Con --colas solo se compara la cola de prioridad con claves (float, puntero) y con claves enteras empaquetadas.
+// Para comparar disposiciones en mapas grandes: --tamanos=8192 --disposiciones=filas,mosaico,morton
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "entidades.h"
+#include "contadores.h"
+#include "cache.h"
+
+// Estructura que describe un algoritmo registrado en la suite
+struct AlgoritmoBenchmark {
+    std::string nombre;
+    std::function<bool(Grid&, Celda&, Celda&)> ejecutar;
+    std::function<void(Grid&)> preparar = nullptr; // Preproceso opcional del mapa, medido aparte de las consultas
+};
+
+// Estructura con un mapa MovingAI y las consultas de su archivo de escenarios
+struct CargaEscenarios {
+    std::string nombre; // Nombre del archivo de escenarios, sin directorio ni extensión
+    MapaMovingAI mapa;
+    std::vector<EscenarioMovingAI> consultas;
+};
+
+// Estructura que describe un caso parametrizado de la suite
+struct CasoBenchmark {
+    std::string generador;
+    int tamano;
+    double densidad;
+    std::string disposicion;
+    const AlgoritmoBenchmark* algoritmo;
+    const CargaEscenarios* escenarios = nullptr; // Consultas MovingAI (en lugar de un mapa generado)
+
+    // Método que construye el nombre del caso al estilo de Google Benchmark
+    std::string nombre() const {
+        std::ostringstream texto;
+        if (escenarios) {
+            texto << algoritmo->nombre << "/escenario:" << escenarios->nombre << "/"
+                  << escenarios->mapa.alto << "x" << escenarios->mapa.ancho << "/disposicion:" << disposicion;
+            return texto.str();
+        }
+        texto << algoritmo->nombre << "/" << generador << "/" << tamano << "x" << tamano
+              << "/densidad:" << std::fixed << std::setprecision(2) << densidad
+              << "/disposicion:" << disposicion;
+        return texto.str();
+    }
+};
+
+// Estructura con el resumen estadístico de una serie de tiempos
+struct ResumenTiempos {
+    double media = 0;
+    double mediana = 0;
+    double desviacion = 0;
+    double minimo = 0;
+    double maximo = 0;
+};
+
+// Estructura con el resultado de todas las repeticiones de un caso
+struct ResultadoBenchmark {
+    CasoBenchmark caso;
+    std::vector<double> tiemposMs;     // Tiempo real de cada repetición
+    std::vector<double> tiemposCpuMs;  // Tiempo de CPU de cada repetición
+    EstadisticasBusqueda estadisticas; // Métricas algorítmicas (iguales en todas las repeticiones)
+    AcumuladoContadores contadores;    // Contadores de hardware acumulados
+    double tiempoPreparacionMs = -1;   // Tiempo del preproceso (negativo si el algoritmo no lo tiene)
+    size_t consultas = 1;              // Consultas por repetición (los tiempos son por consulta)
+    bool encontrada = false;
+};
+
+// Configuración leída de la línea de comandos
+struct ConfiguracionBenchmark {
+    std::vector<int> tamanos = {64, 128, 256};
+    std::vector<double> densidades = {0.1, 0.3};
+    std::vector<std::string> generadores = {"abierto", "aleatorio", "laberinto", "habitaciones", "perlin"};
+    std::vector<std::string> algoritmos = {"BFS", "DStarLite", "CampoFlujo"};
+    std::vector<std::string> disposiciones = {"filas"};
+    int repeticiones = 5;
+    uint64_t semilla = 1;
+    std::string filtro;
+    std::string archivoJSON;
+    std::string archivoEscenarios;
+    std::string archivoMapa; // Si está vacío, se usa el mapa que indica el archivo de escenarios
+    size_t operacionesColas = 0; // Si es mayor que 0, solo se mide la cola de prioridad con tantas extracciones
+    std::vector<int> dinamico;   // Agentes, lotes y cambios por lote del modo de obstáculos dinámicos
+    std::vector<int> cooperativo; // Agentes, ventana y pasos entre replanificaciones del modo cooperativo
+    std::vector<int> mapf;        // Números de agentes de los problemas multiagente (CBS/ECBS)
+    std::vector<double> pesos = {1.0, 1.5}; // Factores de suboptimalidad del modo multiagente
+    double tiempoMapfMs = 10000;  // Tiempo máximo por problema multiagente
+    std::string directorioMapf;   // Si no está vacío, se guardan ahí los mapas y escenarios generados
+    std::vector<double> plazosAnytime; // Plazos en milisegundos del modo anytime (ARA*)
+};
+
+// Función que separa una lista de valores separados por comas
+static std::vector<std::string> separarLista(const std::string& texto) {
+    std::vector<std::string> valores;
+    std::stringstream flujo(texto);
+    std::string valor;
+    while (std::getline(flujo, valor, ',')) {
+        if (!valor.empty()) valores.push_back(valor);
+    }
+    return valores;
+}
+
+// Función que traduce el nombre de una disposición en memoria a su valor
+static DisposicionMemoria convertirDisposicion(const std::string& nombre) {
+    if (nombre == "mosaico") return DISPOSICION_MOSAICO;
+    if (nombre == "morton") return DISPOSICION_MORTON;
+    return DISPOSICION_FILAS;
+}
+
+// Función que carga el archivo de escenarios y su mapa. Si no se indica el mapa, se busca el que nombra
+// el archivo de escenarios junto a él (con su ruta relativa o solo por nombre). Se descartan las consultas
+// con extremos fuera del mapa o bloqueados.
+static bool cargarEscenarios(const ConfiguracionBenchmark& configuracion, CargaEscenarios& carga) {
+    std::string archivoMapa;
+    if (!cargarEscenariosMovingAI(configuracion.archivoEscenarios, carga.consultas, archivoMapa)) {
+        std::cerr << "No se pueden leer los escenarios de " << configuracion.archivoEscenarios << std::endl;
+        return false;
+    }
+    size_t barra = configuracion.archivoEscenarios.find_last_of("/\\");
+    std::string directorio = barra == std::string::npos ? "" : configuracion.archivoEscenarios.substr(0, barra + 1);
+    std::string nombre = configuracion.archivoEscenarios.substr(directorio.size());
+    carga.nombre = nombre.substr(0, nombre.find('.'));
+
+    std::vector<std::string> candidatos;
+    if (!configuracion.archivoMapa.empty()) {
+        candidatos.push_back(configuracion.archivoMapa);
+    } else {
+        size_t barraMapa = archivoMapa.find_last_of("/\\");
+        candidatos.push_back(directorio + archivoMapa);
+        candidatos.push_back(directorio + archivoMapa.substr(barraMapa == std::string::npos ? 0 : barraMapa + 1));
+    }
+    bool cargado = false;
+    for (const std::string& candidato : candidatos) {
+        if (cargarMapaMovingAI(candidato, carga.mapa)) {
+            cargado = true;
+            break;
+        }
+    }
+    if (!cargado) {
+        std::cerr << "No se puede leer el mapa " << candidatos.front() << std::endl;
+        return false;
+    }
+
+    const MapaMovingAI& mapa = carga.mapa;
+    auto libre = [&](int fila, int columna) {
+        return fila >= 0 && fila < mapa.alto && columna >= 0 && columna < mapa.ancho
+            && !mapa.bloqueadas[(size_t)fila * mapa.ancho + columna];
+    };
+    carga.consultas.erase(std::remove_if(carga.consultas.begin(), carga.consultas.end(), [&](const EscenarioMovingAI& c) {
+        return !libre(c.filaOrigen, c.columnaOrigen) || !libre(c.filaDestino, c.columnaDestino)
+            || (c.filaOrigen == c.filaDestino && c.columnaOrigen == c.columnaDestino);
+    }), carga.consultas.end());
+    if (carga.consultas.empty()) {
+        std::cerr << "Ninguna consulta de " << configuracion.archivoEscenarios << " es valida en el mapa" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Función que aplica el generador del caso sobre la grilla
+static void generarMapa(Grid& grid, const CasoBenchmark& caso, uint64_t semilla) {
+    if (caso.generador == "aleatorio") {
+        grid.generarObstaculosAleatorios(caso.densidad, semilla);
+    } else if (caso.generador == "laberinto") {
+        grid.generarLaberinto(semilla);
+    } else if (caso.generador == "habitaciones") {
+        grid.generarHabitaciones(semilla);
+    } else if (caso.generador == "perlin") {
+        grid.generarTerrenoPerlin(16.0, 0.15, semilla);
+    }
+}
+
+// Función que elige como origen la primera celda libre y como destino la última (en orden de filas)
+static bool elegirExtremos(Grid& grid, Celda*& origen, Celda*& destino) {
+    origen = destino = nullptr;
+    for (int i = 0; i < grid.obtenerFilas() && !origen; i++) {
+        for (int j = 0; j < grid.obtenerColumnas() && !origen; j++) {
+            if (grid.obtenerCelda(i, j).estado != BLOQUEADO) origen = &grid.obtenerCelda(i, j);
+        }
+    }
+    for (int i = grid.obtenerFilas() - 1; i >= 0 && !destino; i--) {
+        for (int j = grid.obtenerColumnas() - 1; j >= 0 && !destino; j--) {
+            if (grid.obtenerCelda(i, j).estado != BLOQUEADO) destino = &grid.obtenerCelda(i, j);
+        }
+    }
+    if (!origen || !destino || origen == destino) return false;
+    origen->estado = ORIGEN;
+    destino->estado = DESTINO;
+    return true;
+}
+
+// Función que calcula media, mediana, desviación típica, mínimo y máximo
+static ResumenTiempos resumir(std::vector<double> valores) {
+    ResumenTiempos resumen;
+    if (valores.empty()) return resumen;
+    std::sort(valores.begin(), valores.end());
+    double suma = 0;
+    for (double v : valores) suma += v;
+    resumen.media = suma / valores.size();
+    size_t mitad = valores.size() / 2;
+    resumen.mediana = (valores.size() % 2) ? valores[mitad] : (valores[mitad - 1] + valores[mitad]) / 2;
+    double cuadrados = 0;
+    for (double v : valores) cuadrados += (v - resumen.media) * (v - resumen.media);
+    resumen.desviacion = valores.size() > 1 ? std::sqrt(cuadrados / (valores.size() - 1)) : 0;
+    resumen.minimo = valores.front();
+    resumen.maximo = valores.back();
+    return resumen;
+}
+
+// Función que ejecuta las repeticiones de un caso de escenarios MovingAI: cada repetición recorre
+// todas las consultas y guarda el tiempo medio por consulta
+static ResultadoBenchmark ejecutarEscenarios(const CasoBenchmark& caso, const ConfiguracionBenchmark& configuracion,
+                                             ContadoresHardware& contadores) {
+    ResultadoBenchmark resultado;
+    resultado.caso = caso;
+    const CargaEscenarios& carga = *caso.escenarios;
+    resultado.consultas = carga.consultas.size();
+
+    Grid grid(carga.mapa.alto, carga.mapa.ancho, convertirDisposicion(caso.disposicion));
+    grid.aplicarMapaMovingAI(carga.mapa);
+    if (caso.algoritmo->preparar) {
+        auto inicio = std::chrono::steady_clock::now();
+        caso.algoritmo->preparar(grid);
+        resultado.tiempoPreparacionMs =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+    }
+
+    // Cada consulta marca sus extremos como en la interfaz y los libera al terminar
+    auto recorrer = [&]() {
+        bool todas = true;
+        for (const EscenarioMovingAI& consulta : carga.consultas) {
+            Celda& origen = grid.obtenerCelda(consulta.filaOrigen, consulta.columnaOrigen);
+            Celda& destino = grid.obtenerCelda(consulta.filaDestino, consulta.columnaDestino);
+            origen.estado = ORIGEN;
+            destino.estado = DESTINO;
+            todas = caso.algoritmo->ejecutar(grid, origen, destino) && todas;
+            origen.estado = VACIO;
+            destino.estado = VACIO;
+        }
+        return todas;
+    };
+    recorrer(); // Calentamiento, fuera de la medición
+
+    for (int r = 0; r < configuracion.repeticiones; r++) {
+        auto inicio = std::chrono::steady_clock::now();
+        std::clock_t cpuInicio = std::clock();
+        contadores.iniciar();
+        resultado.encontrada = recorrer();
+        LecturaContadores lectura = contadores.detener();
+        std::clock_t cpuFin = std::clock();
+        auto fin = std::chrono::steady_clock::now();
+
+        double consultas = (double)std::max<size_t>(1, resultado.consultas);
+        resultado.tiemposMs.push_back(std::chrono::duration<double, std::milli>(fin - inicio).count() / consultas);
+        resultado.tiemposCpuMs.push_back((cpuFin - cpuInicio) * 1000.0 / CLOCKS_PER_SEC / consultas);
+        resultado.contadores.agregar(lectura);
+    }
+    resultado.estadisticas = grid.obtenerEstadisticas(); // Métricas de la última consulta
+    return resultado;
+}
+
+// Función que ejecuta todas las repeticiones de un caso
+static ResultadoBenchmark ejecutarCaso(const CasoBenchmark& caso, const ConfiguracionBenchmark& configuracion,
+                                       ContadoresHardware& contadores) {
+    if (caso.escenarios) return ejecutarEscenarios(caso, configuracion, contadores);
+    ResultadoBenchmark resultado;
+    resultado.caso = caso;
+
+    Grid grid(caso.tamano, caso.tamano, convertirDisposicion(caso.disposicion));
+    generarMapa(grid, caso, configuracion.semilla);
+    Celda* origen = nullptr;
+    Celda* destino = nullptr;
+    if (!elegirExtremos(grid, origen, destino)) return resultado;
+
+    // Preproceso del mapa (grafos, jerarquías, tablas), una vez por caso
+    if (caso.algoritmo->preparar) {
+        auto inicio = std::chrono::steady_clock::now();
+        caso.algoritmo->preparar(grid);
+        resultado.tiempoPreparacionMs =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+    }
+
+    // Ejecución de calentamiento, fuera de la medición
+    caso.algoritmo->ejecutar(grid, *origen, *destino);
+
+    for (int r = 0; r < configuracion.repeticiones; r++) {
+        auto inicio = std::chrono::steady_clock::now();
+        std::clock_t cpuInicio = std::clock();
+        contadores.iniciar();
+        resultado.encontrada = caso.algoritmo->ejecutar(grid, *origen, *destino);
+        LecturaContadores lectura = contadores.detener();
+        std::clock_t cpuFin = std::clock();
+        auto fin = std::chrono::steady_clock::now();
+
+        resultado.tiemposMs.push_back(std::chrono::duration<double, std::milli>(fin - inicio).count());
+        resultado.tiemposCpuMs.push_back((cpuFin - cpuInicio) * 1000.0 / CLOCKS_PER_SEC);
+        resultado.contadores.agregar(lectura);
+    }
+    resultado.estadisticas = grid.obtenerEstadisticas();
+    return resultado;
+}
+
+// Función que escribe una entrada de benchmark en formato JSON compatible con Google Benchmark
+static void escribirEntradaJSON(std::ostream& salida, const std::string& nombre, const std::string& tipo,
+                                const std::string& agregado, int repeticiones, int indice,
+                                double tiempo, double tiempoCpu, const ResultadoBenchmark& resultado) {
+    salida << "    {\n"
+           << "      \"name\": \"" << nombre << (agregado.empty() ? "" : "_" + agregado) << "\",\n"
+           << "      \"run_name\": \"" << nombre << "\",\n"
+           << "      \"run_type\": \"" << tipo << "\",\n"
+           << "      \"repetitions\": " << repeticiones << ",\n";
+    if (agregado.empty()) {
+        salida << "      \"repetition_index\": " << indice << ",\n";
+    } else {
+        salida << "      \"aggregate_name\": \"" << agregado << "\",\n";
+    }
+    salida << "      \"iterations\": 1,\n"
+           << "      \"real_time\": " << tiempo << ",\n"
+           << "      \"cpu_time\": " << tiempoCpu << ",\n"
+           << "      \"time_unit\": \"ms\",\n"
+           << "      \"found\": " << (resultado.encontrada ? "true" : "false") << ",\n"
+           << "      \"nodes_expanded\": " << resultado.estadisticas.nodosExpandidos << ",\n"
+           << "      \"nodes_generated\": " << resultado.estadisticas.nodosGenerados << ",\n"
+           << "      \"queue_pushes\": " << resultado.estadisticas.insercionesCola << ",\n"
+           << "      \"queue_pops\": " << resultado.estadisticas.extraccionesCola << ",\n"
+           << "      \"peak_frontier\": " << resultado.estadisticas.picoFrontera << ",\n"
+           << "      \"peak_bytes\": " << resultado.estadisticas.bytesAuxiliares << ",\n"
+           << "      \"live_bytes\": " << resultado.estadisticas.bytesVivos << ",\n"
+           << "      \"allocations\": " << resultado.estadisticas.asignaciones << ",\n"
+           << "      \"path_length\": " << resultado.estadisticas.longitudRuta;
+    if (resultado.tiempoPreparacionMs >= 0) {
+        salida << ",\n      \"preprocess_ms\": " << resultado.tiempoPreparacionMs;
+    }
+    if (resultado.consultas > 1) {
+        salida << ",\n      \"queries\": " << resultado.consultas;
+    }
+    if (resultado.estadisticas.comprobacionesVisibilidad > 0) {
+        salida << ",\n      \"los_checks\": " << resultado.estadisticas.comprobacionesVisibilidad;
+    }
+    const char* claves[NUM_CONTADORES] = {"cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"};
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        if (resultado.contadores.muestras[i] == 0) continue;
+        salida << ",\n      \"" << claves[i] << "\": "
+               << resultado.contadores.totales[i] / resultado.contadores.muestras[i];
+    }
+    salida << "\n    }";
+}
+
+// Función que escribe todos los resultados en un archivo JSON
+static void escribirJSON(const std::string& archivo, const std::vector<ResultadoBenchmark>& resultados,
+                         const ConfiguracionBenchmark& configuracion) {
+    std::ofstream salida(archivo);
+    if (!salida) {
+        std::cerr << "No se puede escribir " << archivo << std::endl;
+        return;
+    }
+    std::time_t ahora = std::time(nullptr);
+    char fecha[64];
+    std::strftime(fecha, sizeof(fecha), "%Y-%m-%dT%H:%M:%S", std::localtime(&ahora));
+    salida << std::setprecision(9);
+    salida << "{\n  \"context\": {\n"
+           << "    \"date\": \"" << fecha << "\",\n"
+           << "    \"executable\": \"benchmark\",\n"
+           << "    \"seed\": " << configuracion.semilla << ",\n"
+           << "    \"repetitions\": " << configuracion.repeticiones << "\n"
+           << "  },\n  \"benchmarks\": [\n";
+    bool primera = true;
+    for (const ResultadoBenchmark& resultado : resultados) {
+        std::string nombre = resultado.caso.nombre();
+        int repeticiones = (int)resultado.tiemposMs.size();
+        for (int r = 0; r < repeticiones; r++) {
+            if (!primera) salida << ",\n";
+            primera = false;
+            escribirEntradaJSON(salida, nombre, "iteration", "", repeticiones, r,
+                                resultado.tiemposMs[r], resultado.tiemposCpuMs[r], resultado);
+        }
+        ResumenTiempos real = resumir(resultado.tiemposMs);
+        ResumenTiempos cpu = resumir(resultado.tiemposCpuMs);
+        const char* nombres[] = {"mean", "median", "stddev", "min", "max"};
+        double reales[] = {real.media, real.mediana, real.desviacion, real.minimo, real.maximo};
+        double cpus[] = {cpu.media, cpu.mediana, cpu.desviacion, cpu.minimo, cpu.maximo};
+        for (int k = 0; k < 5 && repeticiones > 0; k++) {
+            if (!primera) salida << ",\n";
+            primera = false;
+            escribirEntradaJSON(salida, nombre, "aggregate", nombres[k], repeticiones, 0, reales[k], cpus[k], resultado);
+        }
+    }
+    salida << "\n  ]\n}\n";
+}
+
+// Función que mide una cola de prioridad con el patrón de Dijkstra en una grilla de coste unitario:
+// cada extracción inserta hasta 3 vecinas con coste + 1 (de forma determinista a partir de la semilla).
+// Devuelve los nanosegundos por extracción; la suma de control evita que se descarte el trabajo.
+template <class Entrada, class Crear, class Coste>
+static double medirCola(size_t operaciones, uint64_t semilla, Crear crear, Coste coste, uint64_t& control) {
+    std::priority_queue<Entrada, std::vector<Entrada>, std::greater<Entrada>> cola;
+    uint64_t estado = semilla | 1;
+    uint32_t siguiente = 0;
+    cola.push(crear(0, siguiente++));
+    auto inicio = std::chrono::steady_clock::now();
+    for (size_t k = 0; k < operaciones && !cola.empty(); k++) {
+        uint32_t actual = coste(cola.top());
+        cola.pop();
+        control += actual;
+        estado ^= estado << 13;
+        estado ^= estado >> 7;
+        estado ^= estado << 17;
+        int vecinas = cola.size() < 2 ? 3 : (int)(estado % 4);
+        for (int v = 0; v < vecinas && v < 3; v++) cola.push(crear(actual + 1, siguiente++));
+    }
+    auto fin = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(fin - inicio).count() / operaciones;
+}
+
+// Función que compara la cola con claves (float, puntero a celda) y con claves enteras empaquetadas
+static void compararColas(const ConfiguracionBenchmark& configuracion) {
+    std::vector<Celda> celdas(1);
+    std::cout << std::left << std::setw(40) << "Cola" << std::right << std::setw(14) << "Media ns/op"
+              << std::setw(14) << "Mediana ns/op" << std::endl;
+    std::cout << std::string(68, '-') << std::endl;
+    for (int tipo = 0; tipo < 2; tipo++) {
+        std::vector<double> tiempos;
+        uint64_t control = 0;
+        for (int r = 0; r < configuracion.repeticiones; r++) {
+            uint64_t semilla = configuracion.semilla + r;
+            if (tipo == 0) {
+                typedef std::pair<float, Celda*> EntradaFlotante;
+                tiempos.push_back(medirCola<EntradaFlotante>(configuracion.operacionesColas, semilla,
+                    [&](uint32_t g, uint32_t i) { return EntradaFlotante((float)g, &celdas[0] + (i & 1023)); },
+                    [](const EntradaFlotante& e) { return (uint32_t)e.first; }, control));
+            } else {
+                tiempos.push_back(medirCola<uint64_t>(configuracion.operacionesColas, semilla,
+                    [](uint32_t g, uint32_t i) { return claveCola(g, i); },
+                    [](uint64_t e) { return (uint32_t)(e >> 32); }, control));
+            }
+        }
+        ResumenTiempos resumen = resumir(tiempos);
+        std::cout << std::left << std::setw(40) << (tipo == 0 ? "pair<float, Celda*>" : "uint64_t (coste << 32 | indice)")
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << resumen.media << std::setw(14) << resumen.mediana
+                  << "  (control " << control << ")" << std::endl;
+    }
+}
+
+// Función que elige una celda libre al azar (o -1 si no la encuentra)
+static int celdaLibreAlAzar(Grid& grid, std::mt19937_64& azar) {
+    int total = grid.obtenerFilas() * grid.obtenerColumnas();
+    for (int intento = 0; intento < 1000; intento++) {
+        int indice = (int)(azar() % total);
+        if (grid.obtenerCelda(indice / grid.obtenerColumnas(), indice % grid.obtenerColumnas()).estado != BLOQUEADO) {
+            return indice;
+        }
+    }
+    return -1;
+}
+
+// Función que compara, en cada mapa generado, la reparación incremental de las rutas de los agentes
+// con repetir un BFS por agente tras cada lote de cambios (los lotes son los mismos en ambos casos)
+static void ejecutarDinamico(const ConfiguracionBenchmark& configuracion) {
+    int numeroAgentes = configuracion.dinamico[0];
+    int lotes = configuracion.dinamico.size() > 1 ? configuracion.dinamico[1] : 50;
+    int cambiosPorLote = configuracion.dinamico.size() > 2 ? configuracion.dinamico[2] : 16;
+    std::cout << std::left << std::setw(44) << "Mapa" << std::right << std::setw(16) << "Incremental ms"
+              << std::setw(12) << "BFS ms" << std::setw(16) << "Replanif./lote" << std::setw(14) << "Expandidos" << std::endl;
+    std::cout << std::string(102, '-') << std::endl;
+    for (const std::string& generador : configuracion.generadores) {
+        for (int tamano : configuracion.tamanos) {
+            CasoBenchmark caso{generador, tamano, configuracion.densidades.empty() ? 0.0 : configuracion.densidades[0], "filas", nullptr};
+            Grid grid(tamano, tamano);
+            generarMapa(grid, caso, configuracion.semilla);
+            std::mt19937_64 azar(configuracion.semilla);
+            std::vector<std::pair<int, int>> extremos;
+            for (int k = 0; k < numeroAgentes; k++) {
+                int origen = celdaLibreAlAzar(grid, azar), destino = celdaLibreAlAzar(grid, azar);
+                if (origen < 0 || destino < 0) continue;
+                grid.registrarAgente(grid.obtenerCelda(origen / tamano, origen % tamano),
+                                     grid.obtenerCelda(destino / tamano, destino % tamano));
+                extremos.push_back({origen, destino});
+            }
+
+            std::vector<double> incremental, completo;
+            size_t replanificados = 0, expandidos = 0;
+            uint64_t marcaTiempo = 1;
+            for (int lote = 0; lote < lotes; lote++) {
+                std::vector<CambioCelda> cambios;
+                for (int c = 0; c < cambiosPorLote; c++) {
+                    int indice = (int)(azar() % ((size_t)tamano * tamano));
+                    cambios.push_back({indice / tamano, indice % tamano, azar() % 2 == 0, marcaTiempo++});
+                }
+                auto inicio = std::chrono::steady_clock::now();
+                replanificados += grid.empujarCambios(cambios).size();
+                auto fin = std::chrono::steady_clock::now();
+                incremental.push_back(std::chrono::duration<double, std::milli>(fin - inicio).count());
+                expandidos += grid.obtenerEstadisticas().nodosExpandidos;
+
+                grid.activarReutilizacionArboles(false);
+                inicio = std::chrono::steady_clock::now();
+                for (const auto& extremo : extremos) {
+                    grid.BFS(grid.obtenerCelda(extremo.first / tamano, extremo.first % tamano),
+                             grid.obtenerCelda(extremo.second / tamano, extremo.second % tamano));
+                }
+                fin = std::chrono::steady_clock::now();
+                completo.push_back(std::chrono::duration<double, std::milli>(fin - inicio).count());
+            }
+            std::ostringstream nombre;
+            nombre << generador << "/" << tamano << "x" << tamano << "/agentes:" << extremos.size();
+            std::cout << std::left << std::setw(44) << nombre.str() << std::right << std::fixed << std::setprecision(4)
+                      << std::setw(16) << resumir(incremental).media << std::setw(12) << resumir(completo).media
+                      << std::setw(16) << std::setprecision(2) << (double)replanificados / lotes
+                      << std::setw(14) << expandidos / lotes << std::endl;
+        }
+    }
+}
+
+// Función que elige extremos distintos para cada agente: ningún origen ni destino se repite
+static void elegirExtremosAgentes(Grid& grid, int agentes, std::mt19937_64& azar,
+                                  std::vector<std::pair<int, int>>& extremos) {
+    std::vector<char> origenUsado((size_t)grid.obtenerFilas() * grid.obtenerColumnas(), 0);
+    std::vector<char> destinoUsado(origenUsado.size(), 0);
+    extremos.clear();
+    for (int k = 0; k < agentes * 4 && (int)extremos.size() < agentes; k++) {
+        int origen = celdaLibreAlAzar(grid, azar), destino = celdaLibreAlAzar(grid, azar);
+        if (origen < 0 || destino < 0 || origenUsado[origen] || destinoUsado[destino]) continue;
+        origenUsado[origen] = destinoUsado[destino] = 1;
+        extremos.push_back({origen, destino});
+    }
+}
+
+// Función que planifica muchos agentes con reservas espacio-tiempo en cada mapa generado
+static void ejecutarCooperativo(const ConfiguracionBenchmark& configuracion) {
+    int numeroAgentes = configuracion.cooperativo[0];
+    int ventana = configuracion.cooperativo.size() > 1 ? configuracion.cooperativo[1] : 16;
+    int pasos = configuracion.cooperativo.size() > 2 ? configuracion.cooperativo[2] : ventana / 2;
+    std::cout << std::left << std::setw(44) << "Mapa" << std::right << std::setw(12) << "Tiempo ms"
+              << std::setw(11) << "Instantes" << std::setw(12) << "En destino" << std::setw(12) << "Conflictos"
+              << std::setw(9) << "Choques" << std::setw(14) << "Expandidos" << std::setw(14) << "Bytes tabla" << std::endl;
+    std::cout << std::string(128, '-') << std::endl;
+    for (const std::string& generador : configuracion.generadores) {
+        for (int tamano : configuracion.tamanos) {
+            CasoBenchmark caso{generador, tamano, configuracion.densidades.empty() ? 0.0 : configuracion.densidades[0], "filas", nullptr};
+            Grid grid(tamano, tamano);
+            generarMapa(grid, caso, configuracion.semilla);
+            std::mt19937_64 azar(configuracion.semilla);
+            std::vector<std::pair<int, int>> extremos;
+            elegirExtremosAgentes(grid, numeroAgentes, azar, extremos);
+
+            PlanificadorCooperativo planificador;
+            planificador.configurar(ventana, pasos);
+            for (const auto& extremo : extremos) planificador.agregarAgente(extremo.first, extremo.second);
+            auto inicio = std::chrono::steady_clock::now();
+            planificador.resolver(grid, 4 * tamano);
+            auto fin = std::chrono::steady_clock::now();
+
+            std::vector<std::vector<int>> trayectorias;
+            for (size_t a = 0; a < planificador.numeroAgentes(); a++) trayectorias.push_back(planificador.trayectoria((int)a));
+            const EstadisticasCooperativas& medidas = planificador.obtenerEstadisticas();
+            std::ostringstream nombre;
+            nombre << generador << "/" << tamano << "x" << tamano << "/agentes:" << extremos.size() << "/ventana:" << ventana;
+            std::cout << std::left << std::setw(44) << nombre.str() << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(12) << std::chrono::duration<double, std::milli>(fin - inicio).count()
+                      << std::setw(11) << medidas.instantes << std::setw(12) << medidas.agentesEnDestino
+                      << std::setw(12) << medidas.conflictos << std::setw(9) << contarChoques(grid, trayectorias)
+                      << std::setw(14) << medidas.nodosExpandidos << std::setw(14) << medidas.bytesReservas << std::endl;
+        }
+    }
+}
+
+// Función que resuelve los problemas multiagente de un mapa con cada peso: para cada número de agentes se toman
+// las primeras consultas del escenario; con un peso, al primer problema sin resolver se pasa al siguiente
+static void resolverMAPF(const ConfiguracionBenchmark& configuracion, SolverConflictos& solver, const std::string& mapa,
+                         Grid& grid, const std::vector<EscenarioMovingAI>& consultas) {
+    int columnas = grid.obtenerColumnas();
+    for (double peso : configuracion.pesos) {
+        for (int agentes : configuracion.mapf) {
+            if ((size_t)agentes > consultas.size()) break;
+            solver.configurar(peso, 0, configuracion.tiempoMapfMs);
+            solver.vaciarAgentes();
+            for (int a = 0; a < agentes; a++) {
+                const EscenarioMovingAI& c = consultas[a];
+                solver.agregarAgente(c.filaOrigen * columnas + c.columnaOrigen, c.filaDestino * columnas + c.columnaDestino);
+            }
+            auto inicio = std::chrono::steady_clock::now();
+            bool resuelto = solver.resolver(grid);
+            auto fin = std::chrono::steady_clock::now();
+
+            size_t choques = 0;
+            if (resuelto) {
+                std::vector<std::vector<int>> trayectorias;
+                for (int a = 0; a < agentes; a++) trayectorias.push_back(solver.trayectoria(a));
+                choques = contarChoques(grid, trayectorias);
+            }
+            const EstadisticasConflictos& medidas = solver.obtenerEstadisticas();
+            std::ostringstream nombre;
+            nombre << mapa << "/agentes:" << agentes << "/peso:" << std::fixed << std::setprecision(2) << peso;
+            std::cout << std::left << std::setw(44) << nombre.str() << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(12) << std::chrono::duration<double, std::milli>(fin - inicio).count()
+                      << std::setw(10) << (resuelto ? "si" : "no") << std::setw(9) << medidas.coste
+                      << std::setw(9) << medidas.cotaInferior << std::setw(10) << medidas.conflictosRaiz
+                      << std::setw(11) << medidas.nodosGenerados << std::setw(14) << medidas.expandidosBajos
+                      << std::setw(9) << choques << std::endl;
+            if (!resuelto) break;
+        }
+    }
+}
+
+// Función que ejecuta el modo multiagente sobre el archivo de escenarios indicado o, si no hay, sobre un
+// escenario MAPF generado para cada mapa (agentes con origen y destino distintos y alcanzables)
+static bool ejecutarMAPF(const ConfiguracionBenchmark& configuracion) {
+    SolverConflictos solver;
+    std::cout << "Hilos del nivel bajo: " << solver.obtenerEstadisticas().hilos << std::endl;
+    std::cout << std::left << std::setw(44) << "Problema" << std::right << std::setw(12) << "Tiempo ms"
+              << std::setw(10) << "Resuelto" << std::setw(9) << "Coste" << std::setw(9) << "Cota"
+              << std::setw(10) << "Conf.raiz" << std::setw(11) << "Nodos CT" << std::setw(14) << "Expandidos"
+              << std::setw(9) << "Choques" << std::endl;
+    std::cout << std::string(128, '-') << std::endl;
+
+    if (!configuracion.archivoEscenarios.empty()) {
+        CargaEscenarios carga;
+        if (!cargarEscenarios(configuracion, carga)) return false;
+        Grid grid(carga.mapa.alto, carga.mapa.ancho);
+        grid.aplicarMapaMovingAI(carga.mapa);
+        resolverMAPF(configuracion, solver, carga.nombre, grid, carga.consultas);
+        return true;
+    }
+
+    int maximoAgentes = configuracion.mapf.back();
+    for (const std::string& generador : configuracion.generadores) {
+        for (int tamano : configuracion.tamanos) {
+            CasoBenchmark caso{generador, tamano, configuracion.densidades.empty() ? 0.0 : configuracion.densidades[0], "filas", nullptr};
+            Grid grid(tamano, tamano);
+            generarMapa(grid, caso, configuracion.semilla);
+            MapaMovingAI mapa;
+            grid.exportarMapaMovingAI(mapa);
+            std::mt19937_64 azar(configuracion.semilla);
+            std::vector<std::pair<int, int>> extremos;
+            elegirExtremosAgentes(grid, maximoAgentes, azar, extremos);
+
+            // Como en los escenarios MAPF publicados, se descartan los agentes sin ruta y se anota su longitud óptima
+            std::vector<EscenarioMovingAI> consultas;
+            grid.activarReutilizacionArboles(false);
+            for (const auto& extremo : extremos) {
+                Celda& origen = grid.obtenerCelda(extremo.first / tamano, extremo.first % tamano);
+                Celda& destino = grid.obtenerCelda(extremo.second / tamano, extremo.second % tamano);
+                if (extremo.first == extremo.second || !grid.BFS(origen, destino)) continue;
+                double longitud = (double)grid.extraerRuta(origen, destino).size() - 1;
+                consultas.push_back({extremo.first / tamano, extremo.first % tamano,
+                                     extremo.second / tamano, extremo.second % tamano, longitud});
+            }
+            grid.aplicarMapaMovingAI(mapa);
+
+            std::ostringstream nombre;
+            nombre << generador << "-" << tamano;
+            if (!configuracion.directorioMapf.empty()) {
+                std::string base = configuracion.directorioMapf + "/" + nombre.str();
+                if (!guardarMapaMovingAI(base + ".map", mapa)
+                    || !guardarEscenariosMovingAI(base + "-random-1.scen", nombre.str() + ".map", mapa, consultas)) {
+                    std::cerr << "No se puede escribir " << base << ".map o su escenario" << std::endl;
+                    return false;
+                }
+            }
+            resolverMAPF(configuracion, solver, nombre.str(), grid, consultas);
+        }
+    }
+    return true;
+}
+
+// Función que ejecuta ARA* con cada plazo en cada mapa generado (de la primera a la última celda libre) y
+// compara el coste y la cota que informa con la ruta óptima
+static void ejecutarAnytime(const ConfiguracionBenchmark& configuracion) {
+    std::cout << std::left << std::setw(44) << "Consulta" << std::right << std::setw(12) << "Tiempo ms"
+              << std::setw(9) << "Coste" << std::setw(9) << "Optimo" << std::setw(9) << "Cota"
+              << std::setw(9) << "Real" << std::setw(9) << "Epsilon" << std::setw(9) << "Mejoras"
+              << std::setw(14) << "Expandidos" << std::setw(8) << "Plazo" << std::endl;
+    std::cout << std::string(128, '-') << std::endl;
+    for (const std::string& generador : configuracion.generadores) {
+        for (int tamano : configuracion.tamanos) {
+            CasoBenchmark caso{generador, tamano, configuracion.densidades.empty() ? 0.0 : configuracion.densidades[0], "filas", nullptr};
+            Grid grid(tamano, tamano);
+            generarMapa(grid, caso, configuracion.semilla);
+            Celda* origen = nullptr;
+            Celda* destino = nullptr;
+            if (!elegirExtremos(grid, origen, destino)) continue;
+            grid.activarReutilizacionArboles(false);
+            if (!grid.BFS(*origen, *destino)) continue;
+            size_t optimo = grid.obtenerEstadisticas().longitudRuta;
+
+            // La ruta queda en el resultado: sin reiniciar la grilla la consulta solo paga por lo que explora
+            ConfiguracionAnytime anytime;
+            anytime.marcarEnGrilla = false;
+            // La primera consulta sobre la grilla reserva la memoria de trabajo de ARA* (un sello por celda);
+            // con el plazo ya vencido solo hace esa reserva, que no se mide
+            ResultadoAnytime preparacion;
+            grid.ARAStar(*origen, *destino, std::chrono::steady_clock::now(), anytime, preparacion);
+            for (double plazoMs : configuracion.plazosAnytime) {
+                ResultadoAnytime resultado;
+                auto inicio = std::chrono::steady_clock::now();
+                auto plazo = inicio + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double, std::milli>(plazoMs));
+                grid.ARAStar(*origen, *destino, plazo, anytime, resultado);
+                auto fin = std::chrono::steady_clock::now();
+                std::ostringstream nombre;
+                nombre << generador << "/" << tamano << "x" << tamano << "/plazo:" << plazoMs << "ms";
+                std::cout << std::left << std::setw(44) << nombre.str() << std::right << std::fixed << std::setprecision(3)
+                          << std::setw(12) << std::chrono::duration<double, std::milli>(fin - inicio).count();
+                // Sin ruta publicada no hay coste ni cota que informar
+                if (resultado.encontrada) {
+                    std::cout << std::setw(9) << resultado.coste << std::setw(9) << optimo << std::setprecision(2)
+                              << std::setw(9) << resultado.cota << std::setw(9) << (double)resultado.coste / optimo;
+                } else {
+                    std::cout << std::setw(9) << "-" << std::setw(9) << optimo << std::setw(18) << "sin ruta" << std::setprecision(2);
+                }
+                std::cout << std::setw(9) << resultado.epsilon << std::setw(9) << resultado.mejoras.size()
+                          << std::setw(14) << grid.obtenerEstadisticas().nodosExpandidos
+                          << std::setw(8) << (resultado.plazoAgotado ? "si" : "no") << std::endl;
+            }
+        }
+    }
+}
+
+// Función que lee los argumentos de la línea de comandos
+static bool leerArgumentos(int argc, char** argv, ConfiguracionBenchmark& configuracion) {
+    for (int k = 1; k < argc; k++) {
+        std::string argumento = argv[k];
+        size_t igual = argumento.find('=');
+        std::string clave = argumento.substr(0, igual);
+        std::string valor = igual == std::string::npos ? "" : argumento.substr(igual + 1);
+        if (clave == "--tamanos") {
+            configuracion.tamanos.clear();
+            for (const std::string& v : separarLista(valor)) configuracion.tamanos.push_back(std::stoi(v));
+        } else if (clave == "--densidades") {
+            configuracion.densidades.clear();
+            for (const std::string& v : separarLista(valor)) configuracion.densidades.push_back(std::stod(v));
+        } else if (clave == "--generadores") {
+            configuracion.generadores = separarLista(valor);
+        } else if (clave == "--algoritmos") {
+            configuracion.algoritmos = separarLista(valor);
+        } else if (clave == "--disposiciones") {
+            configuracion.disposiciones = separarLista(valor);
+            for (const std::string& d : configuracion.disposiciones) {
+                if (d != "filas" && d != "mosaico" && d != "morton") {
+                    std::cerr << "Disposicion desconocida: " << d << std::endl;
+                    return false;
+                }
+            }
+        } else if (clave == "--repeticiones") {
+            configuracion.repeticiones = std::max(1, std::stoi(valor));
+        } else if (clave == "--semilla") {
+            configuracion.semilla = std::stoull(valor);
+        } else if (clave == "--filtro") {
+            configuracion.filtro = valor;
+        } else if (clave == "--json") {
+            configuracion.archivoJSON = valor;
+        } else if (clave == "--escenarios") {
+            configuracion.archivoEscenarios = valor;
+        } else if (clave == "--mapa") {
+            configuracion.archivoMapa = valor;
+        } else if (clave == "--dinamico") {
+            configuracion.dinamico.clear();
+            for (const std::string& v : separarLista(valor)) configuracion.dinamico.push_back(std::max(1, std::stoi(v)));
+        } else if (clave == "--cooperativo") {
+            configuracion.cooperativo.clear();
+            for (const std::string& v : separarLista(valor)) configuracion.cooperativo.push_back(std::max(1, std::stoi(v)));
+        } else if (clave == "--mapf") {
+            configuracion.mapf.clear();
+            for (const std::string& v : separarLista(valor)) configuracion.mapf.push_back(std::max(1, std::stoi(v)));
+            std::sort(configuracion.mapf.begin(), configuracion.mapf.end());
+        } else if (clave == "--pesos") {
+            configuracion.pesos.clear();
+            for (const std::string& v : separarLista(valor)) configuracion.pesos.push_back(std::max(1.0, std::stod(v)));
+        } else if (clave == "--tiempo-mapf") {
+            configuracion.tiempoMapfMs = std::stod(valor);
+        } else if (clave == "--guardar-mapf") {
+            configuracion.directorioMapf = valor;
+        } else if (clave == "--anytime") {
+            configuracion.plazosAnytime.clear();
+            for (const std::string& v : separarLista(valor)) configuracion.plazosAnytime.push_back(std::stod(v));
+        } else if (clave == "--colas") {
+            configuracion.operacionesColas = std::stoull(valor);
+        } else {
+            std::cerr << "Argumento desconocido: " << argumento << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    ConfiguracionBenchmark configuracion;
+    if (!leerArgumentos(argc, argv, configuracion)) return 1;
+    if (configuracion.operacionesColas > 0) {
+        compararColas(configuracion);
+        return 0;
+    }
+    if (!configuracion.dinamico.empty()) {
+        ejecutarDinamico(configuracion);
+        return 0;
+    }
+    if (!configuracion.cooperativo.empty()) {
+        ejecutarCooperativo(configuracion);
+        return 0;
+    }
+    if (!configuracion.mapf.empty()) {
+        return ejecutarMAPF(configuracion) ? 0 : 1;
+    }
+    if (!configuracion.plazosAnytime.empty()) {
+        ejecutarAnytime(configuracion);
+        return 0;
+    }
+
+    // Caché compartida por el caso BFSCacheado: se vacía al preparar cada caso (los mapas generados de
+    // casos distintos pueden tener la misma versión), la ejecución de calentamiento la llena
+    // y las repeticiones miden el coste de un acierto
+    auto cache = std::make_shared<CacheRutas>(64 * 1024 * 1024);
+    // Grafo de subobjetivos del mapa del caso actual (se construye en el preproceso)
+    auto subobjetivos = std::make_shared<GrafoSubobjetivos>();
+    // Jerarquía de contracción del mapa del caso actual (se construye en el preproceso)
+    auto jerarquia = std::make_shared<JerarquiaContraccion>();
+    // Base de caminos comprimida del mapa del caso actual (se construye en el preproceso)
+    auto baseCaminos = std::make_shared<BaseCaminos>();
+
+    // Algoritmos disponibles en la suite; los nuevos motores se registran aquí
+    std::vector<AlgoritmoBenchmark> registrados = {
+        {"BFS", [](Grid& grid, Celda& origen, Celda& destino) {
+            grid.activarReutilizacionArboles(false);
+            return grid.BFS(origen, destino);
+        }},
+        {"BFSArboles", [](Grid& grid, Celda& origen, Celda& destino) {
+            grid.activarReutilizacionArboles(true);
+            return grid.BFS(origen, destino);
+        }},
+        {"DStarLite", [](Grid& grid, Celda& origen, Celda& destino) {
+            grid.establecerDesempate(DESEMPATE_MENOR_H);
+            return grid.DStarLite(origen, destino);
+        }},
+        {"Dijkstra", [](Grid& grid, Celda& origen, Celda& destino) {
+            ResultadoMultiple resultado;
+            return grid.DijkstraMultiple({&origen}, {}, {&destino}, resultado);
+        }},
+        {"BFSSuavizado", [](Grid& grid, Celda& origen, Celda& destino) {
+            grid.activarReutilizacionArboles(false);
+            bool existe = grid.BFS(origen, destino);
+            grid.suavizarRuta(grid.extraerRuta(origen, destino));
+            return existe;
+        }},
+        {"BFSCacheado", [cache](Grid& grid, Celda& origen, Celda& destino) {
+            bool existe = false;
+            std::vector<int> ruta;
+            int o = grid.indiceCelda(origen), d = grid.indiceCelda(destino); // Solo BFS usa la caché (algoritmo 0)
+            if (cache->buscar(0, o, d, grid.obtenerVersion(), existe, ruta)) {
+                grid.marcarRutaIndices(ruta);
+                return existe;
+            }
+            grid.activarReutilizacionArboles(false);
+            existe = grid.BFS(origen, destino);
+            cache->guardar(0, o, d, grid.obtenerVersion(), existe, grid.extraerRuta(origen, destino));
+            return existe;
+        }, [cache](Grid&) { cache->vaciar(); }},
+        {"CampoFlujo", [](Grid& grid, Celda& origen, Celda& destino) {
+            CampoFlujo campo;
+            grid.calcularCampoFlujo(destino, campo);
+            return grid.seguirCampoFlujo(origen, campo);
+        }},
+        {"Subobjetivos", [subobjetivos](Grid& grid, Celda& origen, Celda& destino) {
+            return grid.buscarConSubobjetivos(*subobjetivos, origen, destino);
+        }, [subobjetivos](Grid& grid) { subobjetivos->construir(grid); }},
+        {"Jerarquia", [jerarquia](Grid& grid, Celda& origen, Celda& destino) {
+            return grid.buscarConJerarquia(*jerarquia, origen, destino);
+        }, [jerarquia](Grid& grid) { jerarquia->construir(grid); }},
+        {"BaseCaminos", [baseCaminos](Grid& grid, Celda& origen, Celda& destino) {
+            return grid.buscarConBaseCaminos(*baseCaminos, origen, destino);
+        }, [baseCaminos](Grid& grid) { baseCaminos->construir(grid); }},
+        {"ThetaPerezoso", [](Grid& grid, Celda& origen, Celda& destino) {
+            std::vector<int> puntos;
+            return grid.ThetaPerezoso(origen, destino, puntos);
+        }},
+    };
+
+    // D* Lite con cada política de desempate entre celdas con el mismo f (DStarLite usa la de menor h)
+    const std::pair<const char*, PoliticaDesempate> desempates[] = {
+        {"DStarLiteSinDesempate", DESEMPATE_NINGUNO}, {"DStarLiteFIFO", DESEMPATE_FIFO},
+        {"DStarLiteLIFO", DESEMPATE_LIFO}, {"DStarLiteMenorHLIFO", DESEMPATE_MENOR_H_LIFO},
+    };
+    for (const auto& desempate : desempates) {
+        PoliticaDesempate politica = desempate.second;
+        registrados.push_back({desempate.first, [politica](Grid& grid, Celda& origen, Celda& destino) {
+            grid.establecerDesempate(politica);
+            return grid.DStarLite(origen, destino);
+        }});
+    }
+
+    // ARA* hasta la ruta óptima (ARAStar), con plazo de 1 ms (ARAStarPlazo1ms) y solo la primera ruta con
+    // epsilon 3 (ARAStarPrimera); el plazo se cuenta desde el inicio de cada consulta
+    const std::pair<const char*, double> variantesAnytime[] = {
+        {"ARAStar", 0}, {"ARAStarPlazo1ms", 1.0}, {"ARAStarPrimera", 0},
+    };
+    for (const auto& variante : variantesAnytime) {
+        std::string nombre = variante.first;
+        double plazoMs = variante.second;
+        ConfiguracionAnytime anytime;
+        if (nombre == "ARAStarPrimera") anytime.epsilonFinal = anytime.epsilonInicial;
+        registrados.push_back({nombre, [anytime, plazoMs](Grid& grid, Celda& origen, Celda& destino) {
+            auto inicio = std::chrono::steady_clock::now();
+            auto plazo = plazoMs > 0 ? inicio + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                           std::chrono::duration<double, std::milli>(plazoMs))
+                                     : std::chrono::steady_clock::time_point::max();
+            ResultadoAnytime resultado;
+            return grid.ARAStar(origen, destino, plazo, anytime, resultado);
+        }});
+    }
+
+    // Núcleos especializados: Kernel<4|8><Unitario|Terreno|Real>[Dijkstra|Ponderado], por ejemplo
+    // Kernel4Unitario (A* con Manhattan) o Kernel8RealDijkstra. Con coste de terreno o real, la malla
+    // se prepara con un terreno determinista de 1 a 8 derivado del índice de la celda.
+    const char* nombresConectividad[2] = {"4", "8"};
+    const char* nombresCoste[3] = {"Unitario", "Terreno", "Real"};
+    const char* nombresHeuristica[3] = {"Dijkstra", "", "Ponderado"};
+    for (int v = 0; v < 2; v++) {
+        for (int c = 0; c < 3; c++) {
+            for (int h = 0; h < 3; h++) {
+                ConfiguracionKernel kernel;
+                kernel.conectividad = (Conectividad)v;
+                kernel.coste = (ModeloCoste)c;
+                kernel.heuristica = (PoliticaHeuristica)h;
+                auto malla = std::make_shared<MallaBusqueda>();
+                std::string nombre = std::string("Kernel") + nombresConectividad[v] + nombresCoste[c] + nombresHeuristica[h];
+                registrados.push_back({nombre, [malla, kernel](Grid& grid, Celda& origen, Celda& destino) {
+                    return grid.buscarConKernel(*malla, kernel, origen, destino);
+                }, [malla, kernel](Grid& grid) {
+                    if (kernel.coste == COSTE_UNITARIO) {
+                        malla->construir(grid);
+                        return;
+                    }
+                    std::vector<uint8_t> terreno((size_t)grid.obtenerFilas() * grid.obtenerColumnas());
+                    for (size_t i = 0; i < terreno.size(); i++) {
+                        terreno[i] = (uint8_t)(1 + ((uint32_t)i * 2654435761u >> 29));
+                    }
+                    malla->construir(grid, &terreno);
+                }});
+            }
+        }
+    }
+
+    // Con escenarios MovingAI, el mapa y las consultas sustituyen a los generadores
+    CargaEscenarios carga;
+    if (!configuracion.archivoEscenarios.empty() && !cargarEscenarios(configuracion, carga)) return 1;
+
+    // Construimos el producto de parámetros (la densidad solo afecta al generador aleatorio)
+    std::vector<CasoBenchmark> casos;
+    for (const std::string& nombreAlgoritmo : configuracion.algoritmos) {
+        auto algoritmo = std::find_if(registrados.begin(), registrados.end(),
+                                      [&](const AlgoritmoBenchmark& a) { return a.nombre == nombreAlgoritmo; });
+        if (algoritmo == registrados.end()) {
+            std::cerr << "Algoritmo desconocido: " << nombreAlgoritmo << std::endl;
+            return 1;
+        }
+        if (!configuracion.archivoEscenarios.empty()) {
+            for (const std::string& disposicion : configuracion.disposiciones) {
+                CasoBenchmark caso{"escenario", 0, 0.0, disposicion, &*algoritmo, &carga};
+                if (caso.nombre().find(configuracion.filtro) == std::string::npos) continue;
+                casos.push_back(caso);
+            }
+            continue;
+        }
+        for (const std::string& generador : configuracion.generadores) {
+            for (int tamano : configuracion.tamanos) {
+                std::vector<double> densidades = generador == "aleatorio" ? configuracion.densidades : std::vector<double>{0.0};
+                for (double densidad : densidades) {
+                    for (const std::string& disposicion : configuracion.disposiciones) {
+                        CasoBenchmark caso{generador, tamano, densidad, disposicion, &*algoritmo};
+                        if (caso.nombre().find(configuracion.filtro) == std::string::npos) continue;
+                        casos.push_back(caso);
+                    }
+                }
+            }
+        }
+    }
+
+    ContadoresHardware contadores;
+    std::vector<ResultadoBenchmark> resultados;
+
+    std::cout << std::left << std::setw(68) << "Caso" << std::right
+              << std::setw(12) << "Media ms" << std::setw(12) << "Mediana ms" << std::setw(12) << "Desv. ms"
+              << std::setw(12) << "Expandidos" << std::setw(12) << "Pico bytes" << std::setw(8) << "Ruta" << std::endl;
+    std::cout << std::string(136, '-') << std::endl;
+    for (const CasoBenchmark& caso : casos) {
+        ResultadoBenchmark resultado = ejecutarCaso(caso, configuracion, contadores);
+        ResumenTiempos resumen = resumir(resultado.tiemposMs);
+        std::cout << std::left << std::setw(68) << caso.nombre() << std::right << std::fixed << std::setprecision(4)
+                  << std::setw(12) << resumen.media << std::setw(12) << resumen.mediana << std::setw(12) << resumen.desviacion
+                  << std::setw(12) << resultado.estadisticas.nodosExpandidos
+                  << std::setw(12) << resultado.estadisticas.bytesAuxiliares
+                  << std::setw(8) << (resultado.encontrada ? std::to_string(resultado.estadisticas.longitudRuta) : "-");
+        if (resultado.tiempoPreparacionMs >= 0) {
+            std::cout << "  (preproceso " << resultado.tiempoPreparacionMs << " ms)";
+        }
+        if (resultado.consultas > 1) {
+            std::cout << "  (" << resultado.consultas << " consultas, tiempos por consulta)";
+        }
+        std::cout << std::endl;
+        resultados.push_back(resultado);
+    }
+
+    if (!configuracion.archivoJSON.empty()) {
+        escribirJSON(configuracion.archivoJSON, resultados, configuracion);
+        std::cout << "\nResultados escritos en " << configuracion.archivoJSON << std::endl;
+    }
+    return 0;
+}
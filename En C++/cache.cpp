@@ -0,0 +1,125 @@
+#include <algorithm>
+#include "cache.h"
+
+// Constructor con el límite de memoria en bytes
+CacheRutas::CacheRutas(size_t capacidadBytes) : capacidadBytes(capacidadBytes) {}
+
+// Método que estima la memoria ocupada por una entrada (nodo de la lista, nodo del índice y ruta)
+size_t CacheRutas::bytesEntrada(const EntradaRuta& entrada) {
+    return sizeof(EntradaRuta) + 2 * sizeof(void*)
+         + sizeof(ClaveRuta) + sizeof(std::list<EntradaRuta>::iterator) + 2 * sizeof(void*)
+         + entrada.ruta.capacity() * sizeof(int);
+}
+
+// Método que expulsa las entradas menos usadas hasta respetar la capacidad
+void CacheRutas::expulsarSobrantes() {
+    while (estadisticas.bytesUsados > capacidadBytes && !recientes.empty()) {
+        EntradaRuta& ultima = recientes.back();
+        estadisticas.bytesUsados -= bytesEntrada(ultima);
+        indice.erase(ultima.clave);
+        recientes.pop_back();
+        estadisticas.expulsiones++;
+    }
+    estadisticas.entradas = recientes.size();
+}
+
+// Método que busca una ruta; devuelve true si está en caché (existe indica si hay ruta)
+bool CacheRutas::buscar(int algoritmo, int origen, int destino, uint64_t version, bool& existe, std::vector<int>& ruta) {
+    std::lock_guard<std::mutex> bloqueo(cerrojo);
+    auto encontrada = indice.find({algoritmo, origen, destino, version});
+    if (encontrada == indice.end()) {
+        estadisticas.fallos++;
+        return false;
+    }
+    // La entrada pasa a ser la más reciente
+    recientes.splice(recientes.begin(), recientes, encontrada->second);
+    existe = encontrada->second->existe;
+    ruta = encontrada->second->ruta;
+    estadisticas.aciertos++;
+    return true;
+}
+
+// Método que guarda el resultado de una búsqueda
+void CacheRutas::guardar(int algoritmo, int origen, int destino, uint64_t version, bool existe, const std::vector<int>& ruta) {
+    std::lock_guard<std::mutex> bloqueo(cerrojo);
+    ClaveRuta clave{algoritmo, origen, destino, version};
+    auto encontrada = indice.find(clave);
+    if (encontrada != indice.end()) {
+        estadisticas.bytesUsados -= bytesEntrada(*encontrada->second);
+        recientes.erase(encontrada->second);
+        indice.erase(encontrada);
+    }
+    recientes.push_front({clave, existe, ruta});
+    indice[clave] = recientes.begin();
+    estadisticas.bytesUsados += bytesEntrada(recientes.front());
+    expulsarSobrantes();
+}
+
+// Método que se llama cuando una celda pasa a estar bloqueada y el mapa cambia de versión
+void CacheRutas::notificarBloqueo(int celda, uint64_t versionAnterior, uint64_t versionNueva) {
+    std::lock_guard<std::mutex> bloqueo(cerrojo);
+    for (auto entrada = recientes.begin(); entrada != recientes.end();) {
+        if (entrada->clave.version < versionAnterior) {
+            // Entrada de una versión ya superada: nadie volverá a pedirla
+            estadisticas.bytesUsados -= bytesEntrada(*entrada);
+            indice.erase(entrada->clave);
+            entrada = recientes.erase(entrada);
+            continue;
+        }
+        if (entrada->clave.version != versionAnterior) {
+            ++entrada;
+            continue;
+        }
+        indice.erase(entrada->clave);
+        bool cruza = std::find(entrada->ruta.begin(), entrada->ruta.end(), celda) != entrada->ruta.end();
+        if (cruza) {
+            // La ruta atraviesa la celda bloqueada: ya no es válida
+            estadisticas.bytesUsados -= bytesEntrada(*entrada);
+            entrada = recientes.erase(entrada);
+            estadisticas.invalidaciones++;
+        } else {
+            // Bloquear una celda fuera de la ruta no puede acortar caminos: la ruta sigue siendo óptima
+            entrada->clave.version = versionNueva;
+            indice[entrada->clave] = entrada;
+            ++entrada;
+        }
+    }
+    estadisticas.entradas = recientes.size();
+}
+
+// Método que descarta las entradas de versiones anteriores a la indicada
+void CacheRutas::descartarAnteriores(uint64_t version) {
+    std::lock_guard<std::mutex> bloqueo(cerrojo);
+    for (auto entrada = recientes.begin(); entrada != recientes.end();) {
+        if (entrada->clave.version < version) {
+            estadisticas.bytesUsados -= bytesEntrada(*entrada);
+            indice.erase(entrada->clave);
+            entrada = recientes.erase(entrada);
+        } else {
+            ++entrada;
+        }
+    }
+    estadisticas.entradas = recientes.size();
+}
+
+// Método que vacía la caché
+void CacheRutas::vaciar() {
+    std::lock_guard<std::mutex> bloqueo(cerrojo);
+    recientes.clear();
+    indice.clear();
+    estadisticas.bytesUsados = 0;
+    estadisticas.entradas = 0;
+}
+
+// Método para cambiar el límite de memoria
+void CacheRutas::cambiarCapacidad(size_t bytes) {
+    std::lock_guard<std::mutex> bloqueo(cerrojo);
+    capacidadBytes = bytes;
+    expulsarSobrantes();
+}
+
+// Método que devuelve una copia de los contadores de uso
+EstadisticasCache CacheRutas::obtenerEstadisticas() const {
+    std::lock_guard<std::mutex> bloqueo(cerrojo);
+    return estadisticas;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Clave de una ruta cacheada: algoritmo que la calculó, índices de las celdas extremo y versión del mapa.
+// El algoritmo forma parte de la clave porque dos motores pueden devolver rutas distintas de igual coste
+struct ClaveRuta {
+    int algoritmo;
+    int origen;
+    int destino;
+    uint64_t version;
+
+    bool operator==(const ClaveRuta& otra) const {
+        return algoritmo == otra.algoritmo && origen == otra.origen && destino == otra.destino &&
+               version == otra.version;
+    }
+};
+
+// Función hash para usar ClaveRuta en tablas hash
+struct HashClaveRuta {
+    size_t operator()(const ClaveRuta& clave) const {
+        uint64_t x = ((uint64_t)(uint32_t)clave.origen << 32) ^ (uint32_t)clave.destino;
+        x ^= (clave.version + ((uint64_t)(uint32_t)clave.algoritmo << 48)) * 0x9E3779B97F4A7C15ull;
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDull;
+        return (size_t)(x ^ (x >> 33));
+    }
+};
+
+// Estructura con los contadores de uso de la caché
+struct EstadisticasCache {
+    size_t aciertos = 0;
+    size_t fallos = 0;
+    size_t expulsiones = 0;    // Entradas expulsadas por el límite de memoria (LRU)
+    size_t invalidaciones = 0; // Entradas descartadas porque su ruta cruza una celda editada
+    size_t entradas = 0;
+    size_t bytesUsados = 0;
+};
+
+// Clase que guarda rutas ya calculadas con expulsión LRU y un límite de memoria configurable.
+// Todas las operaciones son seguras entre hilos.
+class CacheRutas {
+private:
+    // Entrada de la caché: la ruta (índices de celdas) o la constancia de que no hay ruta
+    struct EntradaRuta {
+        ClaveRuta clave;
+        bool existe;
+        std::vector<int> ruta;
+    };
+
+    mutable std::mutex cerrojo;
+    size_t capacidadBytes;
+    std::list<EntradaRuta> recientes; // De la más usada (delante) a la menos usada (detrás)
+    std::unordered_map<ClaveRuta, std::list<EntradaRuta>::iterator, HashClaveRuta> indice;
+    EstadisticasCache estadisticas;
+
+    // Método que estima la memoria ocupada por una entrada
+    static size_t bytesEntrada(const EntradaRuta& entrada);
+
+    // Método que expulsa las entradas menos usadas hasta respetar la capacidad
+    void expulsarSobrantes();
+
+public:
+    // Constructor con el límite de memoria en bytes
+    explicit CacheRutas(size_t capacidadBytes);
+
+    // Método que busca la ruta que calculó un algoritmo (identificador elegido por quien usa la caché);
+    // devuelve true si está en caché (existe indica si hay ruta)
+    bool buscar(int algoritmo, int origen, int destino, uint64_t version, bool& existe, std::vector<int>& ruta);
+
+    // Método que guarda el resultado de una búsqueda (ruta vacía y existe = false si no hay ruta)
+    void guardar(int algoritmo, int origen, int destino, uint64_t version, bool existe, const std::vector<int>& ruta);
+
+    // Método que se llama cuando una celda pasa a estar bloqueada y el mapa cambia de versión:
+    // las rutas que la cruzan se descartan y el resto sigue siendo óptimo en la nueva versión.
+    // Las entradas de versiones anteriores a versionAnterior también se descartan
+    void notificarBloqueo(int celda, uint64_t versionAnterior, uint64_t versionNueva);
+
+    // Método que descarta las entradas de versiones anteriores a la indicada
+    void descartarAnteriores(uint64_t version);
+
+    // Método que vacía la caché
+    void vaciar();
+
+    // Método para cambiar el límite de memoria
+    void cambiarCapacidad(size_t bytes);
+
+    // Método que devuelve una copia de los contadores de uso
+    EstadisticasCache obtenerEstadisticas() const;
+};
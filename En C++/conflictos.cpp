@@ -0,0 +1,469 @@
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include "entidades.h"
+#include "conflictos.h"
+
+// Desplazamientos de las cinco acciones de un agente: las cuatro direcciones y esperar
+static const int ACCIONES[5][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}, {0, 0}};
+
+// Bit de la tabla de restricciones que prohíbe estar en la celda (los bits 0 a 3 prohíben salir en cada dirección)
+static const int32_t RESTRICCION_VERTICE = 1 << 4;
+
+// Constructor que crea los hilos (0: uno por núcleo); el hilo que llama cuenta como uno de ellos
+GrupoHilos::GrupoHilos(unsigned hilos) {
+    if (hilos == 0) hilos = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned k = 1; k < hilos; k++) {
+        trabajadores.emplace_back(&GrupoHilos::trabajar, this, k);
+    }
+}
+
+// Destructor que despierta a los trabajadores para que terminen y los espera
+GrupoHilos::~GrupoHilos() {
+    {
+        std::lock_guard<std::mutex> bloqueo(cerrojo);
+        terminar = true;
+    }
+    avisoTrabajo.notify_all();
+    for (std::thread& trabajador : trabajadores) {
+        trabajador.join();
+    }
+}
+
+// Método que reparte las tareas pendientes de la ronda al hilo indicado
+void GrupoHilos::repartir(unsigned hilo) {
+    for (size_t tarea = siguienteTarea++; tarea < totalTareas; tarea = siguienteTarea++) {
+        (*funcion)(tarea, hilo);
+    }
+}
+
+// Método que ejecuta cada trabajador: espera una ronda, la reparte y avisa al terminar
+void GrupoHilos::trabajar(unsigned hilo) {
+    uint64_t vista = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> bloqueo(cerrojo);
+            avisoTrabajo.wait(bloqueo, [&] { return terminar || ronda != vista; });
+            if (terminar) return;
+            vista = ronda;
+        }
+        repartir(hilo);
+        std::lock_guard<std::mutex> bloqueo(cerrojo);
+        if (--ocupados == 0) avisoFin.notify_one();
+    }
+}
+
+// Método que ejecuta funcion(tarea, hilo) para cada tarea de 0 a tareas - 1 y espera a que terminen
+void GrupoHilos::ejecutar(size_t tareas, const std::function<void(size_t, unsigned)>& funcionTarea) {
+    if (trabajadores.empty() || tareas <= 1) {
+        for (size_t tarea = 0; tarea < tareas; tarea++) funcionTarea(tarea, 0);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> bloqueo(cerrojo);
+        funcion = &funcionTarea;
+        totalTareas = tareas;
+        siguienteTarea = 0;
+        ocupados = trabajadores.size();
+        ronda++;
+    }
+    avisoTrabajo.notify_all();
+    repartir(0);
+    std::unique_lock<std::mutex> bloqueo(cerrojo);
+    avisoFin.wait(bloqueo, [&] { return ocupados == 0; });
+}
+
+// Constructor que crea el grupo de hilos del nivel bajo (0: uno por núcleo)
+SolverConflictos::SolverConflictos(unsigned numeroHilos) : hilos(numeroHilos) {
+    espacios.resize(hilos.numeroHilos());
+}
+
+// Método que configura el factor de suboptimalidad, el límite de nodos y el tiempo máximo
+void SolverConflictos::configurar(double pesoSuboptimo, size_t nodosMaximos, double tiempoMaximoMs) {
+    peso = std::max(1.0, pesoSuboptimo);
+    limiteNodos = nodosMaximos;
+    limiteMs = tiempoMaximoMs;
+}
+
+// Método que borra los agentes registrados
+void SolverConflictos::vaciarAgentes() {
+    origenes.clear();
+    destinos.clear();
+    trayectorias.clear();
+    extremosRepetidos = false;
+}
+
+// Método que registra un agente (índices de celda por filas); los orígenes y los destinos deben ser distintos
+int SolverConflictos::agregarAgente(int origen, int destino) {
+    // Dos agentes en la misma celda al empezar o al terminar siempre chocan: el árbol de restricciones
+    // crecería hasta agotar los límites sin encontrar solución
+    if (std::find(origenes.begin(), origenes.end(), origen) != origenes.end() ||
+        std::find(destinos.begin(), destinos.end(), destino) != destinos.end()) {
+        extremosRepetidos = true;
+        return -1;
+    }
+    origenes.push_back(origen);
+    destinos.push_back(destino);
+    return (int)origenes.size() - 1;
+}
+
+// Método que calcula con un BFS inverso la distancia de cada celda al destino del agente. Es la heurística
+// exacta del nivel bajo sin restricciones y acota el instante hasta el que tiene sentido buscar.
+void SolverConflictos::calcularDistancias(int agente) {
+    std::vector<Coste>& distancia = distancias[agente];
+    distancia.assign((size_t)filas * columnas, COSTE_INFINITO);
+    std::vector<int> cola;
+    cola.reserve(distancia.size());
+    distancia[destinos[agente]] = 0;
+    cola.push_back(destinos[agente]);
+    for (size_t k = 0; k < cola.size(); k++) {
+        int celda = cola[k];
+        int fila = celda / columnas, columna = celda % columnas;
+        for (int d = 0; d < 4; d++) {
+            int nuevaFila = fila + ACCIONES[d][0];
+            int nuevaColumna = columna + ACCIONES[d][1];
+            if (nuevaFila < 0 || nuevaFila >= filas || nuevaColumna < 0 || nuevaColumna >= columnas) continue;
+            int vecina = nuevaFila * columnas + nuevaColumna;
+            if (bloqueadas.contiene(vecina) || distancia[vecina] != COSTE_INFINITO) continue;
+            distancia[vecina] = distancia[celda] + 1;
+            cola.push_back(vecina);
+        }
+    }
+    distanciaMaxima[agente] = distancia[cola.back()];
+}
+
+// Método que reúne la ruta y la cota vigentes de cada agente en un nodo del árbol: la del antepasado más
+// cercano que replanificó al agente o, si ninguno lo hizo, la de la raíz
+void SolverConflictos::recogerRutas(int nodo, std::vector<const std::vector<int>*>& rutas,
+                                    std::vector<Coste>* cotas) const {
+    size_t agentes = origenes.size();
+    rutas.assign(agentes, nullptr);
+    if (cotas) cotas->assign(cotasRaiz.begin(), cotasRaiz.end());
+    for (int k = nodo; k >= 0; k = nodos[k].padre) {
+        int agente = nodos[k].restriccion.agente;
+        if (agente < 0 || rutas[agente]) continue;
+        rutas[agente] = &nodos[k].ruta;
+        if (cotas) (*cotas)[agente] = nodos[k].cotaAgente;
+    }
+    for (size_t a = 0; a < agentes; a++) {
+        if (!rutas[a]) rutas[a] = &rutasRaiz[a];
+    }
+}
+
+// Método que busca los conflictos entre las rutas (los agentes que ya llegaron esperan en su destino).
+// Recorre los instantes en orden, así que las ramas corresponden al conflicto más temprano.
+size_t SolverConflictos::detectarConflictos(const std::vector<const std::vector<int>*>& rutas,
+                                            TablaEspacioTiempo& ocupacion, RestriccionAgente ramas[2]) const {
+    size_t duracion = 0;
+    for (const std::vector<int>* ruta : rutas) duracion = std::max(duracion, ruta->size());
+    auto celdaEn = [&](size_t agente, size_t t) {
+        const std::vector<int>& ruta = *rutas[agente];
+        return ruta[std::min(t, ruta.size() - 1)];
+    };
+
+    size_t conflictos = 0;
+    for (size_t t = 0; t < duracion; t++) {
+        ocupacion.vaciar(rutas.size());
+        for (size_t a = 0; a < rutas.size(); a++) {
+            int celda = celdaEn(a, t);
+            int otro = ocupacion.buscar(TablaEspacioTiempo::clave(celda, 0));
+            if (otro < 0) {
+                ocupacion.insertar(TablaEspacioTiempo::clave(celda, 0), (int32_t)a);
+                continue;
+            }
+            if (conflictos++ == 0) {
+                ramas[0] = {otro, celda, -1, (int)t};
+                ramas[1] = {(int)a, celda, -1, (int)t};
+            }
+        }
+        if (t == 0) continue;
+        // Intercambios: el agente que ahora está donde estaba a venía de donde a está ahora
+        for (size_t a = 0; a < rutas.size(); a++) {
+            int anterior = celdaEn(a, t - 1), celda = celdaEn(a, t);
+            if (anterior == celda) continue;
+            int otro = ocupacion.buscar(TablaEspacioTiempo::clave(anterior, 0));
+            if (otro < 0 || (size_t)otro <= a || celdaEn(otro, t - 1) != celda) continue;
+            if (conflictos++ == 0) {
+                ramas[0] = {(int)a, anterior, celda, (int)t - 1};
+                ramas[1] = {otro, celda, anterior, (int)t - 1};
+            }
+        }
+    }
+    return conflictos;
+}
+
+// Método que prepara las tablas con las que el nivel bajo cuenta los conflictos con las rutas del nodo:
+// cuántos agentes ocupan cada (celda, instante) y desde qué instante espera cada agente en su destino
+void SolverConflictos::prepararTablaConflictos(const std::vector<const std::vector<int>*>& rutas) {
+    size_t entradas = 0;
+    for (const std::vector<int>* ruta : rutas) entradas += ruta->size();
+    tablaConflictos.vaciar(entradas);
+    llegadas.vaciar(rutas.size());
+    for (const std::vector<int>* ruta : rutas) {
+        for (size_t t = 0; t < ruta->size(); t++) {
+            uint64_t clave = TablaEspacioTiempo::clave((*ruta)[t], (int)t);
+            tablaConflictos.insertar(clave, std::max(0, tablaConflictos.buscar(clave)) + 1);
+        }
+        llegadas.insertar(TablaEspacioTiempo::clave(ruta->back(), 0), (int32_t)ruta->size() - 1);
+    }
+}
+
+// Método que busca la ruta de un agente con A* espacio-tiempo y lista focal: entre los nodos abiertos
+// con f a lo sumo peso * fmínimo se expande el que tiene menos conflictos con las rutas del nodo (con
+// peso 1 es A* que desempata por conflictos). La cota es el f mínimo de los abiertos al terminar.
+bool SolverConflictos::buscarRuta(int agente, int padre, const RestriccionAgente* nueva,
+                                  const std::vector<int>* rutaAnterior, EspacioHilo& espacio,
+                                  std::vector<int>& ruta, Coste& cota) const {
+    espacio.busquedas++;
+    int origen = origenes[agente], destino = destinos[agente];
+    const std::vector<Coste>& h = distancias[agente];
+    ruta.clear();
+    if (h[origen] == COSTE_INFINITO) return false;
+
+    // Tabla de restricciones del agente: las de sus antepasados en el árbol más la nueva
+    TablaEspacioTiempo& restricciones = espacio.restricciones;
+    restricciones.vaciar(16);
+    int ultimaMeta = -1;     // Último instante en el que el agente no puede estar en su destino
+    int ultimoInstante = -1; // Último instante con alguna restricción
+    auto anadir = [&](const RestriccionAgente& r) {
+        int32_t bits = RESTRICCION_VERTICE;
+        if (r.hacia >= 0) {
+            int diferencia = r.hacia - r.celda;
+            bits = diferencia == -columnas ? 1 : diferencia == columnas ? 2 : diferencia == -1 ? 4 : 8;
+        } else if (r.celda == destino) {
+            ultimaMeta = std::max(ultimaMeta, r.instante);
+        }
+        uint64_t clave = TablaEspacioTiempo::clave(r.celda, r.instante);
+        restricciones.insertar(clave, std::max(0, restricciones.buscar(clave)) | bits);
+        ultimoInstante = std::max(ultimoInstante, r.instante);
+    };
+    if (nueva) anadir(*nueva);
+    for (int k = padre; k >= 0; k = nodos[k].padre) {
+        if (nodos[k].restriccion.agente == agente) anadir(nodos[k].restriccion);
+    }
+    // Pasada la última restricción, cualquier celda alcanzable llega al destino en distanciaMaxima pasos
+    int limiteInstante = ultimoInstante + 1 + (int)distanciaMaxima[agente];
+
+    auto conflictosEn = [&](int celda, int instante) {
+        uint32_t conflictos = 0;
+        int32_t ocupantes = tablaConflictos.buscar(TablaEspacioTiempo::clave(celda, instante));
+        if (ocupantes > 0) {
+            conflictos += ocupantes;
+            if (rutaAnterior && (size_t)instante < rutaAnterior->size() && (*rutaAnterior)[instante] == celda) conflictos--;
+        }
+        int32_t llegada = llegadas.buscar(TablaEspacioTiempo::clave(celda, 0));
+        if (llegada >= 0 && instante > llegada && celda != destino) conflictos++;
+        return conflictos;
+    };
+    auto acotar = [&](Coste f) { return (Coste)std::floor(peso * f + 1e-9); };
+
+    std::vector<NodoBajo>& nodosBajos = espacio.nodos;
+    auto& abiertos = espacio.abiertos;
+    auto& focal = espacio.focal;
+    typedef std::tuple<uint32_t, Coste, int, int> EntradaFocal;
+    std::greater<EntradaFocal> mayor;
+    nodosBajos.clear();
+    abiertos.clear();
+    focal.clear();
+    espacio.visitados.vaciar(256);
+
+    auto agregar = [&](int celda, int instante, int nodoPadre, uint32_t conflictos, Coste limite) {
+        int indice = (int)nodosBajos.size();
+        nodosBajos.push_back({celda, instante, nodoPadre, conflictos});
+        espacio.visitados.insertar(TablaEspacioTiempo::clave(celda, instante), indice);
+        Coste f = instante + h[celda];
+        abiertos.insert({f, indice});
+        if (f <= limite) {
+            focal.push_back(EntradaFocal(conflictos, f, -instante, indice));
+            std::push_heap(focal.begin(), focal.end(), mayor);
+        }
+    };
+    Coste fMinimo = h[origen];
+    Coste limite = acotar(fMinimo);
+    agregar(origen, 0, -1, 0, limite);
+
+    while (!abiertos.empty()) {
+        // Si sube el f mínimo, la lista focal admite los abiertos que quedan bajo el nuevo límite
+        Coste menor = abiertos.begin()->first;
+        if (menor > fMinimo) {
+            Coste nuevoLimite = acotar(menor);
+            for (auto it = abiertos.upper_bound({limite, INT_MAX}); it != abiertos.end() && it->first <= nuevoLimite; ++it) {
+                const NodoBajo& nodo = nodosBajos[it->second];
+                focal.push_back(EntradaFocal(nodo.conflictos, it->first, -nodo.instante, it->second));
+                std::push_heap(focal.begin(), focal.end(), mayor);
+            }
+            fMinimo = menor;
+            limite = nuevoLimite;
+        }
+        std::pop_heap(focal.begin(), focal.end(), mayor);
+        int actual = std::get<3>(focal.back());
+        focal.pop_back();
+        NodoBajo nodo = nodosBajos[actual];
+        abiertos.erase({nodo.instante + h[nodo.celda], actual});
+
+        if (nodo.celda == destino && nodo.instante > ultimaMeta) {
+            ruta.resize(nodo.instante + 1);
+            for (int n = actual; n >= 0; n = nodosBajos[n].padre) ruta[nodosBajos[n].instante] = nodosBajos[n].celda;
+            cota = fMinimo;
+            return true;
+        }
+        if (nodo.instante >= limiteInstante) continue;
+        espacio.expandidos++;
+
+        int fila = nodo.celda / columnas, columna = nodo.celda % columnas;
+        int32_t prohibidas = std::max(0, restricciones.buscar(TablaEspacioTiempo::clave(nodo.celda, nodo.instante)));
+        for (int d = 0; d < 5; d++) {
+            if (d < 4 && (prohibidas >> d) & 1) continue;
+            int nuevaFila = fila + ACCIONES[d][0];
+            int nuevaColumna = columna + ACCIONES[d][1];
+            if (nuevaFila < 0 || nuevaFila >= filas || nuevaColumna < 0 || nuevaColumna >= columnas) continue;
+            int vecina = nuevaFila * columnas + nuevaColumna;
+            if (bloqueadas.contiene(vecina) || h[vecina] == COSTE_INFINITO) continue;
+            uint64_t clave = TablaEspacioTiempo::clave(vecina, nodo.instante + 1);
+            if (std::max(0, restricciones.buscar(clave)) & RESTRICCION_VERTICE) continue;
+            if (espacio.visitados.buscar(clave) >= 0) continue; // Todas las llegadas a (celda, t) cuestan lo mismo
+            agregar(vecina, nodo.instante + 1, actual, nodo.conflictos + conflictosEn(vecina, nodo.instante + 1), limite);
+        }
+    }
+    return false;
+}
+
+// Método que busca rutas sin conflictos para todos los agentes
+bool SolverConflictos::resolver(const Grid& grid) {
+    auto inicio = std::chrono::steady_clock::now();
+    filas = grid.obtenerFilas();
+    columnas = grid.obtenerColumnas();
+    bloqueadas.redimensionar((size_t)filas * columnas);
+    for (int i = 0; i < filas; i++) {
+        for (int j = 0; j < columnas; j++) {
+            if (grid.obtenerCelda(i, j).estado == BLOQUEADO) bloqueadas.marcar((size_t)i * columnas + j);
+        }
+    }
+    estadisticas = EstadisticasConflictos();
+    estadisticas.hilos = hilos.numeroHilos();
+    for (EspacioHilo& espacio : espacios) espacio.busquedas = espacio.expandidos = 0;
+    size_t agentes = origenes.size();
+    trayectorias.assign(agentes, std::vector<int>());
+    nodos.clear();
+    if (extremosRepetidos) return false;
+
+    // Raíz: distancias y rutas individuales de todos los agentes en paralelo
+    distancias.assign(agentes, std::vector<Coste>());
+    distanciaMaxima.assign(agentes, 0);
+    rutasRaiz.assign(agentes, std::vector<int>());
+    cotasRaiz.assign(agentes, 0);
+    tablaConflictos.vaciar();
+    llegadas.vaciar();
+    std::vector<char> encontradas(agentes, 0);
+    hilos.ejecutar(agentes, [&](size_t agente, unsigned hilo) {
+        calcularDistancias((int)agente);
+        encontradas[agente] = buscarRuta((int)agente, -1, nullptr, nullptr, espacios[hilo], rutasRaiz[agente], cotasRaiz[agente]);
+    });
+    bool factible = std::find(encontradas.begin(), encontradas.end(), 0) == encontradas.end();
+
+    // Los nodos abiertos se ordenan por cota (para el límite de la lista focal) y por coste (para
+    // incorporarlos a la lista focal cuando sube el límite); la lista focal, por conflictos y coste
+    std::set<std::pair<Coste, int>> abiertosCota, abiertosCoste;
+    typedef std::tuple<size_t, Coste, int> EntradaFocal; // (conflictos, coste, nodo)
+    std::set<EntradaFocal> focal;
+    auto acotar = [&](Coste cota) { return (Coste)std::floor(peso * cota + 1e-9); };
+    Coste limite = 0;
+    auto abrir = [&](int indice) {
+        const NodoConflictos& nodo = nodos[indice];
+        abiertosCota.insert({nodo.cota, indice});
+        abiertosCoste.insert({nodo.coste, indice});
+        if (nodo.coste <= limite) focal.insert(EntradaFocal(nodo.conflictos, nodo.coste, indice));
+    };
+
+    std::vector<const std::vector<int>*> rutas;
+    std::vector<Coste> cotas;
+    RestriccionAgente ramas[2];
+    if (factible) {
+        NodoConflictos raiz{-1, {-1, -1, -1, -1}, {}, 0, 0, 0, 0};
+        for (size_t a = 0; a < agentes; a++) {
+            raiz.coste += (Coste)rutasRaiz[a].size() - 1;
+            raiz.cota += cotasRaiz[a];
+        }
+        nodos.push_back(raiz);
+        recogerRutas(0, rutas, nullptr);
+        nodos[0].conflictos = estadisticas.conflictosRaiz = detectarConflictos(rutas, espacios[0].ocupacion, ramas);
+        limite = acotar(nodos[0].cota);
+        abrir(0);
+        estadisticas.nodosGenerados = 1;
+    }
+
+    ResultadoHijo hijos[2];
+    int solucion = -1;
+    while (!abiertosCota.empty()) {
+        double transcurrido = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+        if ((limiteNodos > 0 && estadisticas.nodosGenerados >= limiteNodos) || (limiteMs > 0 && transcurrido >= limiteMs)) break;
+
+        Coste nuevoLimite = acotar(abiertosCota.begin()->first);
+        if (nuevoLimite > limite) {
+            for (auto it = abiertosCoste.upper_bound({limite, INT_MAX}); it != abiertosCoste.end() && it->first <= nuevoLimite; ++it) {
+                focal.insert(EntradaFocal(nodos[it->second].conflictos, it->first, it->second));
+            }
+            limite = nuevoLimite;
+        }
+        int actual;
+        if (!focal.empty()) {
+            actual = std::get<2>(*focal.begin());
+            focal.erase(focal.begin());
+        } else {
+            actual = abiertosCota.begin()->second; // Solo por redondeo: el nodo de menor cota siempre cabe
+        }
+        estadisticas.cotaInferior = abiertosCota.begin()->first;
+        abiertosCota.erase({nodos[actual].cota, actual});
+        abiertosCoste.erase({nodos[actual].coste, actual});
+        estadisticas.nodosExpandidos++;
+
+        recogerRutas(actual, rutas, &cotas);
+        if (nodos[actual].conflictos == 0) {
+            solucion = actual;
+            break;
+        }
+        detectarConflictos(rutas, espacios[0].ocupacion, ramas);
+        prepararTablaConflictos(rutas);
+
+        // Los dos hijos se replanifican en paralelo; cada uno cuenta después sus propios conflictos
+        hilos.ejecutar(2, [&](size_t rama, unsigned hilo) {
+            const RestriccionAgente& restriccion = ramas[rama];
+            int agente = restriccion.agente;
+            ResultadoHijo& hijo = hijos[rama];
+            hijo.encontrada = buscarRuta(agente, actual, &restriccion, rutas[agente], espacios[hilo], hijo.ruta, hijo.cota);
+            if (!hijo.encontrada) return;
+            std::vector<const std::vector<int>*> rutasHijo(rutas);
+            rutasHijo[agente] = &hijo.ruta;
+            RestriccionAgente descartadas[2];
+            hijo.conflictos = detectarConflictos(rutasHijo, espacios[hilo].ocupacion, descartadas);
+        });
+        for (int rama = 0; rama < 2; rama++) {
+            ResultadoHijo& hijo = hijos[rama];
+            if (!hijo.encontrada) continue;
+            int agente = ramas[rama].agente;
+            // La cota anterior sigue siendo válida con más restricciones
+            Coste cotaAgente = std::max(hijo.cota, cotas[agente]);
+            const NodoConflictos& padre = nodos[actual];
+            NodoConflictos nuevo{actual, ramas[rama], std::move(hijo.ruta), cotaAgente,
+                                 padre.coste - ((Coste)rutas[agente]->size() - 1),
+                                 padre.cota - cotas[agente] + cotaAgente, hijo.conflictos};
+            nuevo.coste += (Coste)nuevo.ruta.size() - 1;
+            nodos.push_back(std::move(nuevo));
+            estadisticas.nodosGenerados++;
+            abrir((int)nodos.size() - 1);
+        }
+    }
+
+    for (const EspacioHilo& espacio : espacios) {
+        estadisticas.busquedasBajas += espacio.busquedas;
+        estadisticas.expandidosBajos += espacio.expandidos;
+    }
+    if (solucion < 0) return false;
+    recogerRutas(solucion, rutas, nullptr);
+    for (size_t a = 0; a < agentes; a++) trayectorias[a] = *rutas[a];
+    estadisticas.resuelto = true;
+    estadisticas.coste = nodos[solucion].coste;
+    estadisticas.cotaInferior = std::min(estadisticas.cotaInferior, estadisticas.coste);
+    return true;
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include "cooperativo.h"
+
+class Grid;
+
+// Clase con un grupo de hilos que se crean una sola vez y se reparten tareas numeradas.
+// El hilo que llama a ejecutar también trabaja y espera a que terminen todas las tareas.
+class GrupoHilos {
+private:
+    std::vector<std::thread> trabajadores;
+    std::mutex cerrojo;
+    std::condition_variable avisoTrabajo;
+    std::condition_variable avisoFin;
+    const std::function<void(size_t, unsigned)>* funcion = nullptr;
+    size_t totalTareas = 0;
+    std::atomic<size_t> siguienteTarea{0};
+    size_t ocupados = 0;    // Trabajadores que aún no terminaron la ronda actual
+    uint64_t ronda = 0;     // Número de la ronda de tareas en curso
+    bool terminar = false;
+
+    // Método que reparte las tareas pendientes de la ronda al hilo indicado
+    void repartir(unsigned hilo);
+
+    // Método que ejecuta cada trabajador: espera una ronda, la reparte y avisa al terminar
+    void trabajar(unsigned hilo);
+
+public:
+    // Constructor que crea los hilos (0: uno por núcleo); el hilo que llama cuenta como uno de ellos
+    explicit GrupoHilos(unsigned hilos = 0);
+    ~GrupoHilos();
+
+    // Método que ejecuta funcion(tarea, hilo) para cada tarea de 0 a tareas - 1 y espera a que terminen
+    void ejecutar(size_t tareas, const std::function<void(size_t, unsigned)>& funcion);
+
+    // Método que devuelve el número de hilos, incluido el que llama
+    unsigned numeroHilos() const { return (unsigned)trabajadores.size() + 1; }
+};
+
+// Estructura con una restricción de un agente: no puede estar en la celda en el instante indicado o,
+// si hacia no es -1, no puede pasar de la celda (en el instante) a la celda hacia (en el siguiente)
+struct RestriccionAgente {
+    int agente;
+    int celda;
+    int hacia;
+    int instante;
+};
+
+// Estructura con los contadores de una resolución por búsqueda basada en conflictos
+struct EstadisticasConflictos {
+    bool resuelto = false;
+    uint32_t coste = 0;                // Suma de las longitudes de las rutas de la solución
+    uint32_t cotaInferior = 0;         // Cota inferior del coste óptimo al terminar
+    size_t nodosGenerados = 0;         // Nodos del árbol de restricciones creados
+    size_t nodosExpandidos = 0;        // Nodos del árbol de restricciones en los que se buscó un conflicto
+    size_t busquedasBajas = 0;         // Búsquedas espacio-tiempo de un agente
+    size_t expandidosBajos = 0;        // Nodos expandidos en esas búsquedas
+    size_t conflictosRaiz = 0;         // Conflictos de las rutas individuales
+    unsigned hilos = 1;
+};
+
+// Clase que resuelve el problema de rutas de varios agentes con búsqueda basada en conflictos (CBS).
+// El nivel alto es un árbol de restricciones: cada nodo tiene una ruta por agente, se busca el primer
+// conflicto (dos agentes en la misma celda o intercambiándose en el mismo instante) y se crean dos hijos
+// que prohíben a uno u otro agente ese movimiento; el nivel bajo replanifica con A* espacio-tiempo al
+// agente restringido. Con peso 1 la solución es óptima en suma de costes. Con peso w > 1 se usa ECBS: el
+// nivel bajo y el alto eligen, entre los nodos con coste a lo sumo w veces la cota inferior (lista focal),
+// el que tiene menos conflictos, y la solución cuesta como mucho w veces la óptima.
+// Las restricciones y las rutas no se copian en cada nodo: cada nodo guarda solo la restricción que añade,
+// la ruta nueva de su agente y el índice de su padre, así que las tablas de restricciones de cada agente se
+// comparten entre todos los descendientes. Las búsquedas del nivel bajo se reparten en un grupo de hilos:
+// las rutas iniciales de todos los agentes y los dos hijos de cada nodo se calculan en paralelo.
+class SolverConflictos {
+private:
+    typedef uint32_t Coste;
+
+    // Nodo de la búsqueda espacio-tiempo de un agente (el coste es el instante)
+    struct NodoBajo {
+        int celda;
+        int instante;
+        int padre;
+        uint32_t conflictos; // Conflictos con las rutas de los demás agentes hasta este nodo
+    };
+
+    // Memoria de trabajo de cada hilo; se reutiliza entre búsquedas
+    struct EspacioHilo {
+        TablaEspacioTiempo restricciones; // (celda, instante) -> bits de acciones prohibidas
+        TablaEspacioTiempo visitados;     // (celda, instante) -> nodo
+        TablaEspacioTiempo ocupacion;     // Celda -> agente, al buscar conflictos
+        std::vector<NodoBajo> nodos;
+        std::set<std::pair<Coste, int>> abiertos; // (f, nodo)
+        std::vector<std::tuple<uint32_t, Coste, int, int>> focal; // (conflictos, f, -instante, nodo)
+        size_t busquedas = 0;
+        size_t expandidos = 0;
+    };
+
+    // Nodo del árbol de restricciones
+    struct NodoConflictos {
+        int padre;                      // -1 en la raíz
+        RestriccionAgente restriccion;  // Restricción que añade (agente -1 en la raíz)
+        std::vector<int> ruta;          // Nueva ruta del agente restringido
+        Coste cotaAgente;               // Cota inferior del coste de esa ruta
+        Coste coste;                    // Suma de costes de todas las rutas
+        Coste cota;                     // Suma de cotas de todas las rutas
+        size_t conflictos;              // Conflictos entre las rutas del nodo
+    };
+
+    // Resultado de replanificar al agente de un hijo
+    struct ResultadoHijo {
+        bool encontrada = false;
+        std::vector<int> ruta;
+        Coste cota = 0;
+        size_t conflictos = 0;
+    };
+
+    int filas = 0;
+    int columnas = 0;
+    double peso = 1.0;              // Factor de suboptimalidad (1: CBS óptimo)
+    size_t limiteNodos = 0;         // Nodos máximos del árbol de restricciones (0: sin límite)
+    double limiteMs = 0;            // Tiempo máximo de resolución en milisegundos (0: sin límite)
+    MapaBits bloqueadas;
+    std::vector<int> origenes;
+    std::vector<int> destinos;
+    bool extremosRepetidos = false; // Se intentó registrar un agente con el origen o el destino de otro
+    std::vector<std::vector<Coste>> distancias; // Distancia de cada celda al destino de cada agente
+    std::vector<Coste> distanciaMaxima;         // Mayor distancia finita de cada agente
+    std::vector<std::vector<int>> rutasRaiz;
+    std::vector<Coste> cotasRaiz;
+    std::deque<NodoConflictos> nodos;
+    std::vector<EspacioHilo> espacios;
+    TablaEspacioTiempo tablaConflictos; // (celda, instante) -> agentes que pasan por ella en el nodo actual
+    TablaEspacioTiempo llegadas;        // Celda -> instante desde el que un agente espera en ella (su destino)
+    std::vector<std::vector<int>> trayectorias;
+    EstadisticasConflictos estadisticas;
+    GrupoHilos hilos;
+
+    // Método que calcula con un BFS inverso la distancia de cada celda al destino del agente
+    void calcularDistancias(int agente);
+
+    // Método que reúne la ruta y la cota vigentes de cada agente en un nodo del árbol
+    void recogerRutas(int nodo, std::vector<const std::vector<int>*>& rutas, std::vector<Coste>* cotas) const;
+
+    // Método que busca los conflictos entre las rutas; devuelve cuántos hay y deja en ramas las
+    // restricciones que resuelven el primero (el más temprano)
+    size_t detectarConflictos(const std::vector<const std::vector<int>*>& rutas, TablaEspacioTiempo& ocupacion,
+                              RestriccionAgente ramas[2]) const;
+
+    // Método que prepara las tablas con las que el nivel bajo cuenta los conflictos con las rutas del nodo
+    void prepararTablaConflictos(const std::vector<const std::vector<int>*>& rutas);
+
+    // Método que busca la ruta de un agente con las restricciones del nodo padre más la nueva
+    // (padre -1: sin restricciones); rutaAnterior es su ruta en el padre, que no cuenta como conflicto
+    bool buscarRuta(int agente, int padre, const RestriccionAgente* nueva, const std::vector<int>* rutaAnterior,
+                    EspacioHilo& espacio, std::vector<int>& ruta, Coste& cota) const;
+
+public:
+    // Constructor que crea el grupo de hilos del nivel bajo (0: uno por núcleo)
+    explicit SolverConflictos(unsigned numeroHilos = 0);
+
+    // Método que configura el factor de suboptimalidad (1: CBS; mayor que 1: ECBS), el límite de
+    // nodos del árbol de restricciones y el tiempo máximo en milisegundos (0: sin límite)
+    void configurar(double pesoSuboptimo, size_t nodosMaximos = 0, double tiempoMaximoMs = 0);
+
+    // Método que borra los agentes registrados
+    void vaciarAgentes();
+
+    // Método que registra un agente (índices de celda por filas) y devuelve su identificador. Los orígenes y
+    // los destinos deben ser distintos: si se repite alguno, el agente no se registra, devuelve -1 y resolver
+    // falla hasta vaciar los agentes (el problema no tiene solución)
+    int agregarAgente(int origen, int destino);
+
+    // Método que busca rutas sin conflictos para todos los agentes; devuelve true si las encuentra
+    // antes de agotar los límites (las trayectorias quedan vacías si no o si había extremos repetidos)
+    bool resolver(const Grid& grid);
+
+    // Métodos de consulta
+    size_t numeroAgentes() const { return origenes.size(); }
+    const std::vector<int>& trayectoria(int agente) const { return trayectorias[agente]; }
+    const EstadisticasConflictos& obtenerEstadisticas() const { return estadisticas; }
+};
@@ -0,0 +1,149 @@
+#include "contadores.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+// Función que abre un contador de hardware para el hilo actual en cualquier CPU
+static int abrirContador(uint32_t tipo, uint64_t configuracion) {
+    perf_event_attr atributos;
+    std::memset(&atributos, 0, sizeof(atributos));
+    atributos.size = sizeof(atributos);
+    atributos.type = tipo;
+    atributos.config = configuracion;
+    atributos.disabled = 1;       // Se activa explícitamente con iniciar()
+    atributos.exclude_kernel = 1; // Solo medimos el código de usuario
+    atributos.exclude_hv = 1;
+    // Pedimos los tiempos activo/en ejecución para escalar si el núcleo multiplexa contadores
+    atributos.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0);
+}
+
+// Función que construye la configuración de un contador de caché (lecturas fallidas)
+static uint64_t configuracionCache(uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+#endif
+
+// Constructor que abre los contadores para el proceso actual
+ContadoresHardware::ContadoresHardware() {
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        descriptores[i] = -1;
+    }
+#ifdef __linux__
+    descriptores[CONTADOR_CICLOS] = abrirContador(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    descriptores[CONTADOR_INSTRUCCIONES] = abrirContador(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    descriptores[CONTADOR_FALLOS_L1] = abrirContador(PERF_TYPE_HW_CACHE, configuracionCache(PERF_COUNT_HW_CACHE_L1D));
+    descriptores[CONTADOR_FALLOS_LLC] = abrirContador(PERF_TYPE_HW_CACHE, configuracionCache(PERF_COUNT_HW_CACHE_LL));
+    descriptores[CONTADOR_FALLOS_RAMA] = abrirContador(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+}
+
+// Destructor que cierra los descriptores abiertos
+ContadoresHardware::~ContadoresHardware() {
+#ifdef __linux__
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        if (descriptores[i] >= 0) close(descriptores[i]);
+    }
+#endif
+}
+
+// Método que indica si al menos un contador está disponible
+bool ContadoresHardware::disponible() const {
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        if (descriptores[i] >= 0) return true;
+    }
+    return false;
+}
+
+// Método para poner a cero y activar los contadores justo antes de la búsqueda
+void ContadoresHardware::iniciar() {
+#ifdef __linux__
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        if (descriptores[i] < 0) continue;
+        ioctl(descriptores[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(descriptores[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+// Método para detener los contadores y devolver los valores medidos
+LecturaContadores ContadoresHardware::detener() {
+    LecturaContadores lectura;
+#ifdef __linux__
+    // Primero detenemos todos para no medir la lectura de los demás
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        if (descriptores[i] >= 0) ioctl(descriptores[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        if (descriptores[i] < 0) continue;
+        uint64_t datos[3]; // valor, tiempo activo, tiempo en ejecución
+        if (read(descriptores[i], datos, sizeof(datos)) != (ssize_t)sizeof(datos) || datos[2] == 0) {
+            continue;
+        }
+        // Escalamos el valor si el contador solo estuvo en ejecución parte del tiempo
+        double escala = (double)datos[1] / (double)datos[2];
+        lectura.valores[i] = (uint64_t)(datos[0] * escala);
+        lectura.validos[i] = true;
+    }
+#endif
+    return lectura;
+}
+
+// Método para añadir la lectura de una consulta al acumulado
+void AcumuladoContadores::agregar(const LecturaContadores& lectura) {
+    consultas++;
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        if (!lectura.validos[i]) continue;
+        totales[i] += lectura.valores[i];
+        muestras[i]++;
+    }
+}
+
+// Función que devuelve el nombre legible de un contador
+const char* nombreContador(int tipo) {
+    switch (tipo) {
+        case CONTADOR_CICLOS: return "Ciclos";
+        case CONTADOR_INSTRUCCIONES: return "Instrucciones";
+        case CONTADOR_FALLOS_L1: return "Fallos de cache L1d";
+        case CONTADOR_FALLOS_LLC: return "Fallos de cache LLC";
+        case CONTADOR_FALLOS_RAMA: return "Fallos de prediccion de saltos";
+        default: return "Desconocido";
+    }
+}
+
+// Función que muestra las lecturas de una consulta en formato de texto
+void mostrarContadores(std::ostream& salida, const LecturaContadores& lectura) {
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        salida << nombreContador(i) << ": ";
+        if (lectura.validos[i]) {
+            salida << lectura.valores[i];
+        } else {
+            salida << "no disponible";
+        }
+        salida << std::endl;
+    }
+    // Instrucciones por ciclo, si ambos contadores son válidos
+    if (lectura.validos[CONTADOR_CICLOS] && lectura.validos[CONTADOR_INSTRUCCIONES] && lectura.valores[CONTADOR_CICLOS] > 0) {
+        salida << "IPC: " << (double)lectura.valores[CONTADOR_INSTRUCCIONES] / lectura.valores[CONTADOR_CICLOS] << std::endl;
+    }
+}
+
+// Función que muestra los totales y promedios acumulados de un algoritmo
+void mostrarAcumulado(std::ostream& salida, const std::string& algoritmo, const AcumuladoContadores& acumulado) {
+    salida << "\n--- Contadores de hardware acumulados " << algoritmo
+           << " (" << acumulado.consultas << " consultas) ---" << std::endl;
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        salida << nombreContador(i) << ": ";
+        if (acumulado.muestras[i] > 0) {
+            salida << "total " << acumulado.totales[i]
+                   << ", promedio " << acumulado.totales[i] / acumulado.muestras[i];
+        } else {
+            salida << "no disponible";
+        }
+        salida << std::endl;
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Tipos de contadores de hardware que se miden alrededor de cada búsqueda
+enum TipoContador {
+    CONTADOR_CICLOS = 0,
+    CONTADOR_INSTRUCCIONES,
+    CONTADOR_FALLOS_L1,
+    CONTADOR_FALLOS_LLC,
+    CONTADOR_FALLOS_RAMA,
+    NUM_CONTADORES
+};
+
+// Estructura con los valores leídos de los contadores en una medición
+struct LecturaContadores {
+    uint64_t valores[NUM_CONTADORES] = {}; // Valor de cada contador (escalado si hubo multiplexación)
+    bool validos[NUM_CONTADORES] = {};     // Indica si el contador pudo leerse
+};
+
+// Clase que envuelve los contadores de rendimiento de Linux (perf_event_open).
+// En otras plataformas, o si el núcleo no permite abrirlos, las mediciones quedan vacías.
+class ContadoresHardware {
+private:
+    int descriptores[NUM_CONTADORES]; // Descriptor de archivo de cada contador (-1 si no está disponible)
+
+public:
+    // Constructor que abre los contadores para el proceso actual
+    ContadoresHardware();
+
+    // Destructor que cierra los descriptores abiertos
+    ~ContadoresHardware();
+
+    ContadoresHardware(const ContadoresHardware&) = delete;
+    ContadoresHardware& operator=(const ContadoresHardware&) = delete;
+
+    // Método que indica si al menos un contador está disponible
+    bool disponible() const;
+
+    // Método para poner a cero y activar los contadores justo antes de la búsqueda
+    void iniciar();
+
+    // Método para detener los contadores y devolver los valores medidos
+    LecturaContadores detener();
+};
+
+// Estructura que acumula las lecturas de varias consultas de un mismo algoritmo
+struct AcumuladoContadores {
+    uint64_t consultas = 0;
+    uint64_t totales[NUM_CONTADORES] = {};
+    uint64_t muestras[NUM_CONTADORES] = {}; // Consultas en las que cada contador fue válido
+
+    // Método para añadir la lectura de una consulta al acumulado
+    void agregar(const LecturaContadores& lectura);
+};
+
+// Función que devuelve el nombre legible de un contador
+const char* nombreContador(int tipo);
+
+// Función que muestra las lecturas de una consulta en formato de texto
+void mostrarContadores(std::ostream& salida, const LecturaContadores& lectura);
+
+// Función que muestra los totales y promedios acumulados de un algoritmo
+void mostrarAcumulado(std::ostream& salida, const std::string& algoritmo, const AcumuladoContadores& acumulado);
@@ -0,0 +1,367 @@
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include "entidades.h"
+#include "cooperativo.h"
+
+// Desplazamientos de las cinco acciones de un agente: las cuatro direcciones y esperar
+static const int ACCIONES[5][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}, {0, 0}};
+
+// Método que vacía la tabla y reserva sitio para el número de entradas indicado
+void TablaEspacioTiempo::vaciar(size_t entradasPrevistas) {
+    size_t capacidad = 16;
+    while (capacidad < entradasPrevistas * 2) capacidad *= 2;
+    if (capacidad > claves.size()) {
+        claves.assign(capacidad, 0);
+        valores.assign(capacidad, -1);
+        generaciones.assign(capacidad, 0);
+        generacion = 1;
+        mascara = capacidad - 1;
+    } else if (++generacion == 0) {
+        // La generación dio la vuelta: se limpian las marcas para no confundir casillas antiguas
+        std::fill(generaciones.begin(), generaciones.end(), 0);
+        generacion = 1;
+    }
+    ocupadas = 0;
+}
+
+// Método que duplica la capacidad y vuelve a insertar las entradas vigentes
+void TablaEspacioTiempo::crecer() {
+    std::vector<uint64_t> clavesAntiguas;
+    std::vector<int32_t> valoresAntiguos;
+    for (size_t i = 0; i < claves.size(); i++) {
+        if (generaciones[i] != generacion) continue;
+        clavesAntiguas.push_back(claves[i]);
+        valoresAntiguos.push_back(valores[i]);
+    }
+    size_t capacidad = std::max<size_t>(16, claves.size() * 2);
+    claves.assign(capacidad, 0);
+    valores.assign(capacidad, -1);
+    generaciones.assign(capacidad, 0);
+    generacion = 1;
+    mascara = capacidad - 1;
+    ocupadas = 0;
+    for (size_t i = 0; i < clavesAntiguas.size(); i++) {
+        insertar(clavesAntiguas[i], valoresAntiguos[i]);
+    }
+}
+
+// Método que guarda el valor de la clave (lo sustituye si ya estaba)
+void TablaEspacioTiempo::insertar(uint64_t clave, int32_t valor) {
+    if ((ocupadas + 1) * 2 > claves.size()) crecer();
+    size_t i = dispersar(clave) & mascara;
+    while (generaciones[i] == generacion && claves[i] != clave) {
+        i = (i + 1) & mascara;
+    }
+    if (generaciones[i] != generacion) {
+        generaciones[i] = generacion;
+        claves[i] = clave;
+        ocupadas++;
+    }
+    valores[i] = valor;
+}
+
+// Método que devuelve el valor de la clave, o -1 si no está
+int32_t TablaEspacioTiempo::buscar(uint64_t clave) const {
+    if (claves.empty()) return -1;
+    size_t i = dispersar(clave) & mascara;
+    while (generaciones[i] == generacion) {
+        if (claves[i] == clave) return valores[i];
+        i = (i + 1) & mascara;
+    }
+    return -1;
+}
+
+// Método que configura el tamaño de la ventana, los pasos entre replanificaciones y el límite de expansiones
+void PlanificadorCooperativo::configurar(int ventanaInstantes, int pasos, size_t expansionesMaximas) {
+    ventana = std::max(1, ventanaInstantes);
+    pasosReplanificacion = std::min(std::max(1, pasos), ventana);
+    limiteExpansiones = expansionesMaximas;
+}
+
+// Método que borra los agentes registrados
+void PlanificadorCooperativo::vaciarAgentes() {
+    origenes.clear();
+    destinos.clear();
+    trayectorias.clear();
+}
+
+// Método que registra un agente (índices de celda por filas); la prioridad es el orden de registro
+int PlanificadorCooperativo::agregarAgente(int origen, int destino) {
+    origenes.push_back(origen);
+    destinos.push_back(destino);
+    return (int)origenes.size() - 1;
+}
+
+// Método que calcula con A* la ruta individual de un agente sobre el mapa sin otros agentes
+// (los costes se guardan en la tabla hash, así que solo se paga por las celdas exploradas)
+void PlanificadorCooperativo::calcularRutaIndividual(int agente) {
+    int origen = origenes[agente], destino = destinos[agente];
+    std::vector<int>& ruta = rutasIndividuales[agente];
+    ruta.clear();
+    auto h = [&](int celda) {
+        return (CosteBusqueda)(std::abs(celda / columnas - destino / columnas) + std::abs(celda % columnas - destino % columnas));
+    };
+    nodos.clear();
+    visitados.vaciar(64);
+    typedef std::pair<uint64_t, int> EntradaCola; // (clave empaquetada (f, h), nodo)
+    std::priority_queue<EntradaCola, std::vector<EntradaCola>, std::greater<EntradaCola>> abiertos;
+    nodos.push_back({origen, 0, -1});
+    visitados.insertar(TablaEspacioTiempo::clave(origen, 0), 0);
+    abiertos.push({claveCola(h(origen), h(origen)), 0});
+    while (!abiertos.empty()) {
+        EntradaCola entrada = abiertos.top();
+        abiertos.pop();
+        NodoEspacioTiempo nodo = nodos[entrada.second];
+        if ((CosteBusqueda)(entrada.first >> 32) != nodo.instante + h(nodo.celda)) continue; // Entrada obsoleta
+        if (nodo.celda == destino) {
+            for (int n = entrada.second; n >= 0; n = nodos[n].padre) ruta.push_back(nodos[n].celda);
+            std::reverse(ruta.begin(), ruta.end());
+            return;
+        }
+        estadisticas.nodosExpandidos++;
+        int fila = nodo.celda / columnas, columna = nodo.celda % columnas;
+        for (int d = 0; d < 4; d++) {
+            int nuevaFila = fila + ACCIONES[d][0];
+            int nuevaColumna = columna + ACCIONES[d][1];
+            if (nuevaFila < 0 || nuevaFila >= filas || nuevaColumna < 0 || nuevaColumna >= columnas) continue;
+            int vecina = nuevaFila * columnas + nuevaColumna;
+            if (bloqueadas.contiene(vecina)) continue;
+            // La tabla guarda el nodo de cada celda (instante 0: la clave solo depende de la celda)
+            uint64_t clave = TablaEspacioTiempo::clave(vecina, 0);
+            int existente = visitados.buscar(clave);
+            if (existente >= 0 && nodos[existente].instante <= nodo.instante + 1) continue;
+            if (existente >= 0) {
+                nodos[existente].instante = nodo.instante + 1;
+                nodos[existente].padre = entrada.second;
+            } else {
+                existente = (int)nodos.size();
+                visitados.insertar(clave, existente);
+                nodos.push_back({vecina, nodo.instante + 1, entrada.second});
+            }
+            abiertos.push({claveCola(nodo.instante + 1 + h(vecina), h(vecina)), existente});
+        }
+    }
+}
+
+// Método que indica si un agente puede pasar de la celda desde (instante t) a la celda hacia (t + 1):
+// la celda de llegada no está reservada por otro agente y no se intercambia la celda con ninguno
+bool PlanificadorCooperativo::movimientoLibre(int agente, int desde, int hacia, int instante) const {
+    int ocupante = reservas.buscar(TablaEspacioTiempo::clave(hacia, instante + 1));
+    if (ocupante >= 0 && ocupante != agente) return false;
+    if (desde != hacia) {
+        int otro = reservas.buscar(TablaEspacioTiempo::clave(hacia, instante));
+        if (otro >= 0 && otro != agente && reservas.buscar(TablaEspacioTiempo::clave(desde, instante + 1)) == otro) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Método que busca con A* espacio-tiempo el plan de un agente en la ventana. Termina al extraer un nodo
+// del final de la ventana o el destino si el agente puede quedarse en él hasta el final; si la búsqueda
+// se agota, se toma el nodo que llegó más lejos en el tiempo y más cerca del destino entre aquellos en
+// los que el agente puede esperar hasta el último paso que se ejecuta (la raíz siempre puede).
+void PlanificadorCooperativo::planificarAgente(int agente, int posicion, std::vector<int>& plan) {
+    int destino = destinos[agente];
+    // Guía: la celda de la ruta individual una ventana por delante del progreso y lo que falta desde ella
+    const std::vector<int>& ruta = rutasIndividuales[agente];
+    int guia = destino;
+    CosteBusqueda restante = 0;
+    if (!ruta.empty()) {
+        size_t indiceGuia = std::min(ruta.size() - 1, (size_t)progreso[agente] + ventana);
+        guia = ruta[indiceGuia];
+        restante = (CosteBusqueda)(ruta.size() - 1 - indiceGuia);
+    }
+    auto h = [&](int celda) {
+        return (CosteBusqueda)(std::abs(celda / columnas - guia / columnas) + std::abs(celda % columnas - guia % columnas)) + restante;
+    };
+    nodos.clear();
+    visitados.vaciar(64);
+    typedef std::pair<uint64_t, int> EntradaCola; // (clave empaquetada (f, h), nodo)
+    std::priority_queue<EntradaCola, std::vector<EntradaCola>, std::greater<EntradaCola>> abiertos;
+    nodos.push_back({posicion, 0, -1});
+    visitados.insertar(TablaEspacioTiempo::clave(posicion, 0), 0);
+    abiertos.push({claveCola(h(posicion), h(posicion)), 0});
+
+    int elegido = -1;
+    size_t expansiones = 0;
+    while (!abiertos.empty()) {
+        int actual = abiertos.top().second;
+        abiertos.pop();
+        NodoEspacioTiempo nodo = nodos[actual];
+        if (nodo.instante == ventana) {
+            elegido = actual;
+            break;
+        }
+        if (nodo.celda == destino) {
+            bool puedeQuedarse = true;
+            for (int t = nodo.instante; t < ventana && puedeQuedarse; t++) {
+                puedeQuedarse = movimientoLibre(agente, destino, destino, t);
+            }
+            if (puedeQuedarse) {
+                elegido = actual;
+                break;
+            }
+        }
+        if (limiteExpansiones > 0 && expansiones >= limiteExpansiones) break;
+        expansiones++;
+
+        int fila = nodo.celda / columnas, columna = nodo.celda % columnas;
+        for (const auto& accion : ACCIONES) {
+            int nuevaFila = fila + accion[0];
+            int nuevaColumna = columna + accion[1];
+            if (nuevaFila < 0 || nuevaFila >= filas || nuevaColumna < 0 || nuevaColumna >= columnas) continue;
+            int vecina = nuevaFila * columnas + nuevaColumna;
+            if (bloqueadas.contiene(vecina) || !movimientoLibre(agente, nodo.celda, vecina, nodo.instante)) continue;
+            uint64_t clave = TablaEspacioTiempo::clave(vecina, nodo.instante + 1);
+            if (visitados.buscar(clave) >= 0) continue; // Todas las llegadas a (celda, t) cuestan lo mismo
+            visitados.insertar(clave, (int32_t)nodos.size());
+            nodos.push_back({vecina, nodo.instante + 1, actual});
+            abiertos.push({claveCola(nodo.instante + 1 + h(vecina), h(vecina)), (int)nodos.size() - 1});
+        }
+    }
+    estadisticas.nodosExpandidos += expansiones;
+    estadisticas.busquedas++;
+
+    if (elegido < 0) {
+        estadisticas.conflictos++;
+        elegido = 0;
+        for (size_t n = 1; n < nodos.size(); n++) {
+            const NodoEspacioTiempo& candidato = nodos[n];
+            const NodoEspacioTiempo& mejor = nodos[elegido];
+            if (candidato.instante < mejor.instante
+                || (candidato.instante == mejor.instante && h(candidato.celda) >= h(mejor.celda))) {
+                continue;
+            }
+            bool puedeEsperar = true;
+            for (int t = candidato.instante; t < pasosReplanificacion && puedeEsperar; t++) {
+                puedeEsperar = movimientoLibre(agente, candidato.celda, candidato.celda, t);
+            }
+            if (puedeEsperar) elegido = (int)n;
+        }
+    }
+
+    // Reconstrucción: una celda por instante y espera en la última hasta el final de la ventana
+    plan.assign(ventana + 1, nodos[elegido].celda);
+    for (int n = elegido; n >= 0; n = nodos[n].padre) {
+        plan[nodos[n].instante] = nodos[n].celda;
+    }
+}
+
+// Método que planifica y simula a todos los agentes hasta que llegan a su destino o se alcanza el número
+// máximo de instantes; devuelve true si todos llegaron
+bool PlanificadorCooperativo::resolver(const Grid& grid, int instantesMaximos) {
+    filas = grid.obtenerFilas();
+    columnas = grid.obtenerColumnas();
+    bloqueadas.redimensionar((size_t)filas * columnas);
+    for (int i = 0; i < filas; i++) {
+        for (int j = 0; j < columnas; j++) {
+            if (grid.obtenerCelda(i, j).estado == BLOQUEADO) bloqueadas.marcar((size_t)i * columnas + j);
+        }
+    }
+    estadisticas = EstadisticasCooperativas();
+
+    size_t agentes = origenes.size();
+    std::vector<int> posiciones(origenes);
+    trayectorias.assign(agentes, std::vector<int>());
+    for (size_t a = 0; a < agentes; a++) trayectorias[a].push_back(origenes[a]);
+    std::vector<std::vector<int>> planes(agentes);
+    rutasIndividuales.assign(agentes, std::vector<int>());
+    progreso.assign(agentes, 0);
+    for (size_t a = 0; a < agentes; a++) calcularRutaIndividual((int)a);
+
+    int instante = 0;
+    while (instante < instantesMaximos && posiciones != destinos) {
+        // Las reservas de la ventana son relativas a su inicio: la tabla solo cubre ventana + 1 instantes.
+        // Cada agente retiene su celda actual durante los pasos que se van a ejecutar hasta que planifica,
+        // así que siempre puede quedarse quieto y el plan ejecutado nunca tiene choques. Más allá de esos
+        // pasos los agentes con prioridad pueden pedirle la celda y el agente tendrá que apartarse.
+        reservas.vaciar(agentes * (ventana + pasosReplanificacion + 1));
+        for (size_t a = 0; a < agentes; a++) {
+            for (int t = 0; t <= pasosReplanificacion; t++) {
+                reservas.insertar(TablaEspacioTiempo::clave(posiciones[a], t), (int32_t)a);
+            }
+        }
+        // Orden de prioridad: primero los agentes que no han llegado y después los que esperan en su destino
+        std::vector<int> orden;
+        for (size_t a = 0; a < agentes; a++) if (posiciones[a] != destinos[a]) orden.push_back((int)a);
+        for (size_t a = 0; a < agentes; a++) if (posiciones[a] == destinos[a]) orden.push_back((int)a);
+        for (int a : orden) {
+            for (int t = 1; t <= pasosReplanificacion; t++) {
+                reservas.insertar(TablaEspacioTiempo::clave(posiciones[a], t), -1); // Libera su propia retención
+            }
+            planificarAgente(a, posiciones[a], planes[a]);
+            for (int t = 1; t <= ventana; t++) {
+                reservas.insertar(TablaEspacioTiempo::clave(planes[a][t], t), a);
+            }
+        }
+        estadisticas.ventanas++;
+        estadisticas.bytesReservas = std::max(estadisticas.bytesReservas, reservas.bytes());
+
+        int pasos = std::min(pasosReplanificacion, instantesMaximos - instante);
+        for (size_t a = 0; a < agentes; a++) {
+            for (int t = 1; t <= pasos; t++) trayectorias[a].push_back(planes[a][t]);
+            posiciones[a] = planes[a][pasos];
+            // El progreso avanza si el agente está en una celda de su ruta un poco más adelante
+            const std::vector<int>& ruta = rutasIndividuales[a];
+            size_t limite = std::min(ruta.size(), (size_t)progreso[a] + ventana + pasos + 1);
+            for (size_t k = progreso[a]; k < limite; k++) {
+                if (ruta[k] == posiciones[a]) progreso[a] = (int)k;
+            }
+        }
+        instante += pasos;
+    }
+
+    estadisticas.instantes = instante;
+    for (size_t a = 0; a < agentes; a++) {
+        if (posiciones[a] == destinos[a]) estadisticas.agentesEnDestino++;
+    }
+    return estadisticas.agentesEnDestino == agentes;
+}
+
+// Función que comprueba un conjunto de trayectorias y devuelve el número de choques (0 si el plan es válido).
+// Las trayectorias más cortas se completan esperando en su última celda.
+size_t contarChoques(const Grid& grid, const std::vector<std::vector<int>>& trayectorias) {
+    int columnas = grid.obtenerColumnas();
+    size_t duracion = 0;
+    for (const std::vector<int>& trayectoria : trayectorias) duracion = std::max(duracion, trayectoria.size());
+    auto celdaEn = [&](size_t agente, size_t t) {
+        const std::vector<int>& trayectoria = trayectorias[agente];
+        return trayectoria[std::min(t, trayectoria.size() - 1)];
+    };
+
+    size_t choques = 0;
+    TablaEspacioTiempo ocupacion;
+    for (size_t t = 0; t < duracion; t++) {
+        ocupacion.vaciar(trayectorias.size());
+        for (size_t a = 0; a < trayectorias.size(); a++) {
+            if (trayectorias[a].empty()) continue;
+            int celda = celdaEn(a, t);
+            if (grid.obtenerCelda(celda / columnas, celda % columnas).estado == BLOQUEADO) choques++;
+            if (t > 0) {
+                int anterior = celdaEn(a, t - 1);
+                if (std::abs(anterior / columnas - celda / columnas) + std::abs(anterior % columnas - celda % columnas) > 1) {
+                    choques++; // Salto entre celdas no vecinas
+                }
+            }
+            int otro = ocupacion.buscar(TablaEspacioTiempo::clave(celda, 0));
+            if (otro >= 0) {
+                choques++; // Dos agentes en la misma celda
+            } else {
+                ocupacion.insertar(TablaEspacioTiempo::clave(celda, 0), (int32_t)a);
+            }
+        }
+        if (t == 0) continue;
+        // Intercambios: el agente que ahora está donde estaba a venía de donde a está ahora
+        for (size_t a = 0; a < trayectorias.size(); a++) {
+            if (trayectorias[a].empty()) continue;
+            int anterior = celdaEn(a, t - 1), celda = celdaEn(a, t);
+            if (anterior == celda) continue;
+            int otro = ocupacion.buscar(TablaEspacioTiempo::clave(anterior, 0));
+            if (otro >= 0 && (size_t)otro > a && celdaEn(otro, t - 1) == celda) choques++;
+        }
+    }
+    return choques;
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "direcciones.h"
+
+class Grid;
+
+// Clase con una tabla hash de direccionamiento abierto (sondeo lineal) de claves de 64 bits a enteros.
+// Sirve para reservas espacio-tiempo, con clave (instante << 32 | celda). Vaciarla es O(1): cada
+// casilla guarda la generación en la que se escribió y las de generaciones anteriores cuentan como vacías.
+class TablaEspacioTiempo {
+private:
+    std::vector<uint64_t> claves;
+    std::vector<int32_t> valores;
+    std::vector<uint32_t> generaciones;
+    uint32_t generacion = 1;
+    size_t mascara = 0;
+    size_t ocupadas = 0;
+
+    // Función que dispersa la clave por toda la tabla
+    static size_t dispersar(uint64_t clave) {
+        clave ^= clave >> 33;
+        clave *= 0xFF51AFD7ED558CCDull;
+        return (size_t)(clave ^ (clave >> 33));
+    }
+
+    // Método que duplica la capacidad y vuelve a insertar las entradas vigentes
+    void crecer();
+
+public:
+    // Función que construye la clave de una celda en un instante
+    static uint64_t clave(int celda, int instante) { return (uint64_t)(uint32_t)instante << 32 | (uint32_t)celda; }
+
+    // Método que vacía la tabla y reserva sitio para el número de entradas indicado
+    void vaciar(size_t entradasPrevistas = 0);
+
+    // Método que guarda el valor de la clave (lo sustituye si ya estaba)
+    void insertar(uint64_t clave, int32_t valor);
+
+    // Método que devuelve el valor de la clave, o -1 si no está
+    int32_t buscar(uint64_t clave) const;
+
+    // Métodos de consulta del tamaño
+    size_t tamano() const { return ocupadas; }
+    size_t bytes() const { return claves.size() * (sizeof(uint64_t) + sizeof(int32_t) + sizeof(uint32_t)); }
+};
+
+// Estructura con los contadores de una resolución cooperativa
+struct EstadisticasCooperativas {
+    size_t nodosExpandidos = 0;     // Nodos espacio-tiempo expandidos en todas las búsquedas
+    size_t busquedas = 0;           // Búsquedas de ventana realizadas (una por agente y ventana)
+    size_t ventanas = 0;            // Replanificaciones de todo el grupo
+    size_t agentesEnDestino = 0;    // Agentes que terminaron en su destino
+    size_t conflictos = 0;          // Búsquedas sin plan completo en la ventana (el agente espera o avanza menos)
+    size_t bytesReservas = 0;       // Memoria de la tabla de reservas
+    int instantes = 0;              // Duración del plan (instante en que se detuvo la simulación)
+};
+
+// Clase que planifica rutas para muchos agentes con A* cooperativo por ventanas (WHCA*).
+// Los agentes se planifican en orden de prioridad (el de registro, con los que ya llegaron al final)
+// sobre el espacio-tiempo: cada uno
+// reserva sus celdas en cada instante de la ventana y los siguientes evitan esas reservas y los
+// intercambios de celda con ellas. Tras planificar la ventana, todos avanzan unos pasos y se
+// vuelve a planificar desde las nuevas posiciones, de modo que la tabla solo guarda unos pocos instantes.
+// Como guía, cada agente calcula al empezar su ruta individual sin tener en cuenta a los demás; la
+// heurística de la ventana es la distancia de Manhattan a la celda de esa ruta que está una ventana
+// por delante de su progreso más lo que queda de ruta desde ella (así no se atasca en las habitaciones).
+class PlanificadorCooperativo {
+private:
+    // Nodo de la búsqueda espacio-tiempo (el instante es relativo al inicio de la ventana)
+    struct NodoEspacioTiempo {
+        int celda;
+        int instante;
+        int padre; // Índice del nodo padre (-1 en la raíz)
+    };
+
+    int filas = 0;
+    int columnas = 0;
+    int ventana = 16;               // Instantes que cubre cada búsqueda
+    int pasosReplanificacion = 8;   // Instantes que se ejecutan antes de volver a planificar
+    size_t limiteExpansiones = 0;   // Expansiones máximas por búsqueda (0: sin límite)
+    MapaBits bloqueadas;
+    std::vector<int> origenes;
+    std::vector<int> destinos;
+    std::vector<std::vector<int>> trayectorias; // Celda de cada agente en cada instante
+    std::vector<std::vector<int>> rutasIndividuales; // Ruta de cada agente ignorando a los demás
+    std::vector<int> progreso;      // Posición en su ruta individual hasta la que ha llegado cada agente
+    TablaEspacioTiempo reservas;    // (celda, instante) -> agente que la ocupa
+    TablaEspacioTiempo visitados;   // (celda, instante) -> nodo, de la búsqueda en curso
+    std::vector<NodoEspacioTiempo> nodos;
+    EstadisticasCooperativas estadisticas;
+
+    // Método que calcula con A* la ruta individual de un agente sobre el mapa sin otros agentes
+    void calcularRutaIndividual(int agente);
+
+    // Método que indica si un agente puede pasar de la celda desde (instante t) a la celda hacia (t + 1)
+    bool movimientoLibre(int agente, int desde, int hacia, int instante) const;
+
+    // Método que busca el plan de un agente en la ventana y lo deja en plan (ventana + 1 celdas)
+    void planificarAgente(int agente, int posicion, std::vector<int>& plan);
+
+public:
+    // Método que configura el tamaño de la ventana, los pasos entre replanificaciones y el límite
+    // de expansiones por búsqueda
+    void configurar(int ventanaInstantes, int pasos, size_t expansionesMaximas = 0);
+
+    // Método que borra los agentes registrados
+    void vaciarAgentes();
+
+    // Método que registra un agente (índices de celda por filas); la prioridad es el orden de registro
+    int agregarAgente(int origen, int destino);
+
+    // Método que planifica y simula a todos los agentes hasta que llegan a su destino o se alcanza
+    // el número máximo de instantes; devuelve true si todos llegaron
+    bool resolver(const Grid& grid, int instantesMaximos);
+
+    // Métodos de consulta
+    size_t numeroAgentes() const { return origenes.size(); }
+    const std::vector<int>& trayectoria(int agente) const { return trayectorias[agente]; }
+    const EstadisticasCooperativas& obtenerEstadisticas() const { return estadisticas; }
+};
+
+// Función que comprueba un conjunto de trayectorias: pasos entre celdas vecinas (o esperas) sobre celdas
+// libres y sin dos agentes en la misma celda ni intercambiando celdas en el mismo instante.
+// Devuelve el número de choques encontrados (0 si el plan es válido).
+size_t contarChoques(const Grid& grid, const std::vector<std::vector<int>>& trayectorias);
@@ -0,0 +1,312 @@
+#include <algorithm>
+#include <cstdlib>
+#include "entidades.h"
+#include "dinamico.h"
+
+// Coste de una celda sin ruta hasta la meta
+static const uint32_t SIN_RUTA = UINT32_MAX;
+
+// Método que copia el mapa de la grilla y marca todos los agentes para repetir su búsqueda
+void ReplanificadorAgentes::sincronizar(const Grid& grid) {
+    filas = grid.obtenerFilas();
+    columnas = grid.obtenerColumnas();
+    bloqueadas.redimensionar((size_t)filas * columnas);
+    for (int i = 0; i < filas; i++) {
+        for (int j = 0; j < columnas; j++) {
+            if (grid.obtenerCelda(i, j).estado == BLOQUEADO) bloqueadas.marcar((size_t)i * columnas + j);
+        }
+    }
+    for (Agente& agente : agentes) {
+        agente.reinicioCompleto = true;
+        agente.pendientes.clear();
+    }
+    version = grid.obtenerVersion();
+    construido = true;
+}
+
+// Método que devuelve la distancia de Manhattan entre dos celdas
+ReplanificadorAgentes::Coste ReplanificadorAgentes::distancia(int a, int b) const {
+    return std::abs(a / columnas - b / columnas) + std::abs(a % columnas - b % columnas);
+}
+
+// Método que devuelve la clave de D* Lite de una celda: (min(g, rhs) + h + km, min(g, rhs)),
+// empaquetada para que el montículo la ordene con una comparación entera
+uint64_t ReplanificadorAgentes::calcularClave(const Agente& agente, int celda) const {
+    Coste minimo = std::min(agente.g[celda], agente.rhs[celda]);
+    if (minimo == SIN_RUTA) return claveCola(SIN_RUTA, SIN_RUTA);
+    return claveCola(minimo + distancia(agente.posicion, celda) + agente.km, minimo);
+}
+
+// Método que recalcula rhs de una celda a partir de sus vecinas libres y la devuelve a la cola si
+// queda inconsistente (las entradas antiguas de la celda se descartan al extraerlas)
+void ReplanificadorAgentes::actualizarVertice(Agente& agente, int celda) {
+    if (celda == agente.meta) {
+        agente.rhs[celda] = bloqueadas.contiene(celda) ? SIN_RUTA : 0;
+    } else {
+        Coste mejor = SIN_RUTA;
+        if (!bloqueadas.contiene(celda)) {
+            int fila = celda / columnas, columna = celda % columnas;
+            for (int d = 0; d < 4; d++) {
+                int nuevaFila = fila + DESPLAZAMIENTO_FLUJO[d][0];
+                int nuevaColumna = columna + DESPLAZAMIENTO_FLUJO[d][1];
+                if (nuevaFila < 0 || nuevaFila >= filas || nuevaColumna < 0 || nuevaColumna >= columnas) continue;
+                int vecina = nuevaFila * columnas + nuevaColumna;
+                if (bloqueadas.contiene(vecina) || agente.g[vecina] == SIN_RUTA) continue;
+                mejor = std::min(mejor, agente.g[vecina] + 1);
+            }
+        }
+        agente.rhs[celda] = mejor;
+    }
+    if (agente.g[celda] != agente.rhs[celda]) {
+        agente.abiertos.push({calcularClave(agente, celda), celda});
+        medidas.insercionesCola++;
+    }
+}
+
+// Método que propaga los costes desde la cola hasta que la posición del agente es consistente
+// y ninguna celda de la cola puede mejorarla
+void ReplanificadorAgentes::calcularRuta(Agente& agente) {
+    while (!agente.abiertos.empty()) {
+        EntradaCola entrada = agente.abiertos.top();
+        if (entrada.first >= calcularClave(agente, agente.posicion)
+            && agente.rhs[agente.posicion] == agente.g[agente.posicion]) {
+            break;
+        }
+        agente.abiertos.pop();
+        medidas.extraccionesCola++;
+        int celda = entrada.second;
+        if (agente.g[celda] == agente.rhs[celda]) continue; // Entrada obsoleta: la celda ya es consistente
+        uint64_t claveNueva = calcularClave(agente, celda);
+        if (entrada.first < claveNueva) {
+            // La clave creció (por km o por un aumento de coste): se vuelve a encolar con la nueva
+            agente.abiertos.push({claveNueva, celda});
+            medidas.insercionesCola++;
+            continue;
+        }
+        medidas.nodosExpandidos++;
+        if (agente.g[celda] > agente.rhs[celda]) {
+            agente.g[celda] = agente.rhs[celda]; // Sobreconsistente: el coste baja
+        } else {
+            agente.g[celda] = SIN_RUTA;          // Infraconsistente: se invalida y se recalcula
+            actualizarVertice(agente, celda);
+        }
+        int fila = celda / columnas, columna = celda % columnas;
+        for (int d = 0; d < 4; d++) {
+            int nuevaFila = fila + DESPLAZAMIENTO_FLUJO[d][0];
+            int nuevaColumna = columna + DESPLAZAMIENTO_FLUJO[d][1];
+            if (nuevaFila < 0 || nuevaFila >= filas || nuevaColumna < 0 || nuevaColumna >= columnas) continue;
+            medidas.nodosGenerados++;
+            actualizarVertice(agente, nuevaFila * columnas + nuevaColumna);
+        }
+        medidas.registrarFrontera(agente.abiertos.size());
+    }
+}
+
+// Método que incorpora los cambios pendientes, repara la búsqueda y extrae la nueva ruta
+// descendiendo por g desde la posición del agente
+void ReplanificadorAgentes::reparar(Agente& agente) {
+    size_t total = (size_t)filas * columnas;
+    if (agente.reinicioCompleto) {
+        agente.g.assign(total, SIN_RUTA);
+        agente.rhs.assign(total, SIN_RUTA);
+        agente.abiertos = decltype(agente.abiertos)();
+        agente.km = 0;
+        agente.ultimaPosicion = agente.posicion;
+        agente.pendientes.clear();
+        agente.reinicioCompleto = false;
+        actualizarVertice(agente, agente.meta);
+    } else if (!agente.pendientes.empty()) {
+        // Las claves de la cola se calcularon desde la posición anterior: km compensa lo que el agente avanzó
+        agente.km += distancia(agente.ultimaPosicion, agente.posicion);
+        agente.ultimaPosicion = agente.posicion;
+        for (int celda : agente.pendientes) {
+            actualizarVertice(agente, celda);
+            int fila = celda / columnas, columna = celda % columnas;
+            for (int d = 0; d < 4; d++) {
+                int nuevaFila = fila + DESPLAZAMIENTO_FLUJO[d][0];
+                int nuevaColumna = columna + DESPLAZAMIENTO_FLUJO[d][1];
+                if (nuevaFila < 0 || nuevaFila >= filas || nuevaColumna < 0 || nuevaColumna >= columnas) continue;
+                actualizarVertice(agente, nuevaFila * columnas + nuevaColumna);
+            }
+        }
+        agente.pendientes.clear();
+    }
+    calcularRuta(agente);
+
+    agente.ruta.clear();
+    if (agente.rhs[agente.posicion] != SIN_RUTA && !bloqueadas.contiene(agente.posicion)) {
+        int celda = agente.posicion;
+        agente.ruta.push_back(celda);
+        while (celda != agente.meta && agente.ruta.size() <= total) {
+            int siguiente = -1;
+            Coste mejor = SIN_RUTA;
+            int fila = celda / columnas, columna = celda % columnas;
+            for (int d = 0; d < 4; d++) {
+                int nuevaFila = fila + DESPLAZAMIENTO_FLUJO[d][0];
+                int nuevaColumna = columna + DESPLAZAMIENTO_FLUJO[d][1];
+                if (nuevaFila < 0 || nuevaFila >= filas || nuevaColumna < 0 || nuevaColumna >= columnas) continue;
+                int vecina = nuevaFila * columnas + nuevaColumna;
+                if (!bloqueadas.contiene(vecina) && agente.g[vecina] < mejor) {
+                    mejor = agente.g[vecina];
+                    siguiente = vecina;
+                }
+            }
+            if (siguiente < 0) break;
+            celda = siguiente;
+            agente.ruta.push_back(celda);
+        }
+        if (celda != agente.meta) agente.ruta.clear();
+    }
+    agente.celdasRuta = agente.ruta;
+    std::sort(agente.celdasRuta.begin(), agente.celdasRuta.end());
+    medidas.longitudRuta = agente.ruta.empty() ? 0 : agente.ruta.size() - 1;
+}
+
+// Método que registra un agente entre dos celdas (índices por filas) y calcula su ruta; devuelve su identificador
+int ReplanificadorAgentes::registrarAgente(const Grid& grid, int origen, int destino) {
+    medidas.reiniciar();
+    if (!construido || version != grid.obtenerVersion()
+        || filas != grid.obtenerFilas() || columnas != grid.obtenerColumnas()) {
+        sincronizar(grid);
+        for (Agente& otro : agentes) {
+            if (otro.activo) reparar(otro);
+        }
+    }
+    agentes.emplace_back();
+    Agente& agente = agentes.back();
+    agente.activo = true;
+    agente.posicion = origen;
+    agente.meta = destino;
+    reparar(agente);
+    return (int)agentes.size() - 1;
+}
+
+// Método que da de baja un agente (su identificador no se reutiliza)
+void ReplanificadorAgentes::eliminarAgente(int agente) {
+    Agente vacio;
+    std::swap(agentes[agente], vacio);
+}
+
+// Método que avanza un agente a otra celda y recorta su ruta desde ella
+void ReplanificadorAgentes::moverAgente(const Grid& grid, int agente, int posicion) {
+    medidas.reiniciar();
+    Agente& datos = agentes[agente];
+    datos.posicion = posicion;
+    if (!construido || version != grid.obtenerVersion()) {
+        sincronizar(grid);
+        for (Agente& otro : agentes) {
+            if (otro.activo) reparar(otro);
+        }
+        return;
+    }
+    // Si la nueva posición está en la ruta, basta con recortarla; si no, la búsqueda se repara desde ella
+    auto enRuta = std::find(datos.ruta.begin(), datos.ruta.end(), posicion);
+    if (enRuta != datos.ruta.end()) {
+        datos.ruta.erase(datos.ruta.begin(), enRuta);
+        datos.celdasRuta = datos.ruta;
+        std::sort(datos.celdasRuta.begin(), datos.celdasRuta.end());
+    } else {
+        datos.km += distancia(datos.ultimaPosicion, posicion);
+        datos.ultimaPosicion = posicion;
+        reparar(datos);
+    }
+}
+
+// Método que recibe las celdas cuyo estado bloqueado cambió en la grilla y repara las rutas afectadas
+std::vector<int> ReplanificadorAgentes::notificarCambios(const Grid& grid, const std::vector<int>& cambiadas,
+                                                         uint64_t versionAnterior) {
+    medidas.reiniciar();
+    std::vector<int> replanificados;
+    if (!construido || version != versionAnterior
+        || filas != grid.obtenerFilas() || columnas != grid.obtenerColumnas()) {
+        sincronizar(grid);
+        for (size_t k = 0; k < agentes.size(); k++) {
+            if (!agentes[k].activo) continue;
+            reparar(agentes[k]);
+            replanificados.push_back((int)k);
+        }
+        return replanificados;
+    }
+
+    for (int celda : cambiadas) {
+        if (grid.obtenerCelda(celda / columnas, celda % columnas).estado == BLOQUEADO) bloqueadas.marcar(celda);
+        else bloqueadas.desmarcar(celda);
+    }
+    version = grid.obtenerVersion();
+
+    for (size_t k = 0; k < agentes.size(); k++) {
+        Agente& agente = agentes[k];
+        if (!agente.activo) continue;
+        // Si los pendientes crecen demasiado, es más barato repetir la búsqueda que repararla
+        if (agente.pendientes.size() + cambiadas.size() > (size_t)filas * columnas / 8) {
+            agente.reinicioCompleto = true;
+            agente.pendientes.clear();
+        } else {
+            agente.pendientes.insert(agente.pendientes.end(), cambiadas.begin(), cambiadas.end());
+        }
+        bool afectado = agente.ruta.empty() || agente.reinicioCompleto;
+        for (size_t c = 0; c < cambiadas.size() && !afectado; c++) {
+            afectado = std::binary_search(agente.celdasRuta.begin(), agente.celdasRuta.end(), cambiadas[c]);
+        }
+        if (!afectado) continue;
+        reparar(agente);
+        replanificados.push_back((int)k);
+    }
+    return replanificados;
+}
+
+// Método que registra un agente que viaja entre dos celdas y calcula su ruta; devuelve su identificador
+int Grid::registrarAgente(Celda& origen, Celda& destino) {
+    int agente = agentes.registrarAgente(*this, indiceCelda(origen), indiceCelda(destino));
+    estadisticas = agentes.obtenerEstadisticas();
+    return agente;
+}
+
+// Método que da de baja un agente
+void Grid::eliminarAgente(int agente) {
+    if (agentes.activo(agente)) agentes.eliminarAgente(agente);
+}
+
+// Método que avanza un agente a otra celda (su ruta se recorta o se repara desde ella)
+void Grid::moverAgente(int agente, Celda& posicion) {
+    if (!agentes.activo(agente)) return;
+    agentes.moverAgente(*this, agente, indiceCelda(posicion));
+    estadisticas = agentes.obtenerEstadisticas();
+}
+
+// Método que devuelve la ruta actual de un agente (índices por filas; vacía si no hay ruta)
+const std::vector<int>& Grid::rutaAgente(int agente) const {
+    return agentes.ruta(agente);
+}
+
+// Método que aplica un lote de cambios de obstáculos en orden de marca de tiempo y repara las rutas afectadas
+std::vector<int> Grid::empujarCambios(const std::vector<CambioCelda>& lote) {
+    uint64_t versionAnterior = version;
+    if (marcasCambio.size() != (size_t)filas * columnas) {
+        marcasCambio.assign((size_t)filas * columnas, 0);
+    }
+    std::vector<CambioCelda> ordenados(lote);
+    std::stable_sort(ordenados.begin(), ordenados.end(), [](const CambioCelda& a, const CambioCelda& b) {
+        return a.marcaTiempo < b.marcaTiempo;
+    });
+
+    // Celdas cuyo estado bloqueado cambió (una celda que cambia dos veces en el lote aparece una sola vez)
+    std::vector<int> cambiadas;
+    for (const CambioCelda& cambio : ordenados) {
+        if (cambio.fila < 0 || cambio.fila >= filas || cambio.columna < 0 || cambio.columna >= columnas) continue;
+        int indice = cambio.fila * columnas + cambio.columna;
+        if (cambio.marcaTiempo < marcasCambio[indice]) continue; // Llegó tarde: ya hay un cambio más reciente
+        marcasCambio[indice] = cambio.marcaTiempo;
+        Celda& celda = obtenerCelda(cambio.fila, cambio.columna);
+        if (celda.estado == ORIGEN || celda.estado == DESTINO) continue; // Los extremos de la interfaz no se bloquean
+        if ((celda.estado == BLOQUEADO) == cambio.bloquear) continue;
+        editarCelda(cambio.fila, cambio.columna, cambio.bloquear ? BLOQUEADO : VACIO);
+        cambiadas.push_back(indice);
+    }
+    std::sort(cambiadas.begin(), cambiadas.end());
+    cambiadas.erase(std::unique(cambiadas.begin(), cambiadas.end()), cambiadas.end());
+
+    std::vector<int> replanificados = agentes.notificarCambios(*this, cambiadas, versionAnterior);
+    estadisticas = agentes.obtenerEstadisticas();
+    return replanificados;
+}
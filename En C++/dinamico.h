@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "direcciones.h"
+#include "metricas.h"
+
+class Grid;
+
+// Estructura con un cambio de obstáculo recibido del exterior (puertas, vehículos, otros agentes)
+struct CambioCelda {
+    int fila;
+    int columna;
+    bool bloquear;         // true: la celda pasa a estar bloqueada; false: queda libre
+    uint64_t marcaTiempo;  // Momento del cambio; los cambios más antiguos que el último aplicado se ignoran
+};
+
+// Clase que mantiene la ruta de varios agentes sobre una grilla cuyos obstáculos cambian.
+// Cada agente guarda su propia búsqueda D* Lite (hacia atrás, desde su destino), de modo que al
+// cambiar unas pocas celdas solo se corrigen los costes afectados en lugar de repetir la búsqueda.
+// Solo se reparan los agentes cuya ruta actual atraviesa una celda cambiada (y los que no tenían ruta);
+// el resto acumula los cambios pendientes y los incorpora en su siguiente reparación.
+class ReplanificadorAgentes {
+private:
+    typedef uint32_t Coste;
+    typedef std::pair<uint64_t, int> EntradaCola; // (clave empaquetada (k1, k2), índice de la celda)
+
+    // Estructura con el estado de búsqueda de un agente
+    struct Agente {
+        bool activo = false;
+        int posicion = 0;         // Celda actual del agente (el inicio de su ruta)
+        int meta = 0;             // Celda de destino
+        int ultimaPosicion = 0;   // Posición en la que se calculó km por última vez
+        Coste km = 0;             // Corrección de claves por los movimientos del agente
+        bool reinicioCompleto = true; // Hay que repetir la búsqueda desde cero
+        std::vector<Coste> g;     // Distancia hasta la meta de cada celda
+        std::vector<Coste> rhs;   // Valor anticipado a partir de las vecinas
+        std::priority_queue<EntradaCola, std::vector<EntradaCola>, std::greater<EntradaCola>> abiertos;
+        std::vector<int> ruta;        // Ruta actual, de la posición a la meta
+        std::vector<int> celdasRuta;  // Celdas de la ruta ordenadas (para consultar si un cambio la cruza)
+        std::vector<int> pendientes;  // Celdas cambiadas todavía no incorporadas a la búsqueda
+    };
+
+    int filas = 0;
+    int columnas = 0;
+    uint64_t version = 0;     // Versión del mapa con la que está sincronizado
+    bool construido = false;
+    MapaBits bloqueadas;      // Copia del mapa de celdas bloqueadas (por filas)
+    std::vector<Agente> agentes;
+    EstadisticasBusqueda medidas; // Métricas acumuladas de la última operación
+
+    // Método que copia el mapa de la grilla y marca todos los agentes para repetir su búsqueda
+    void sincronizar(const Grid& grid);
+
+    // Método que devuelve la distancia de Manhattan entre dos celdas
+    Coste distancia(int a, int b) const;
+
+    // Métodos de D* Lite: clave de una celda, actualización de rhs y propagación hasta que la
+    // posición del agente es consistente
+    uint64_t calcularClave(const Agente& agente, int celda) const;
+    void actualizarVertice(Agente& agente, int celda);
+    void calcularRuta(Agente& agente);
+
+    // Método que incorpora los cambios pendientes, repara la búsqueda y extrae la nueva ruta
+    void reparar(Agente& agente);
+
+public:
+    // Método que registra un agente entre dos celdas (índices por filas) y calcula su ruta; devuelve su identificador
+    int registrarAgente(const Grid& grid, int origen, int destino);
+
+    // Método que da de baja un agente (su identificador no se reutiliza)
+    void eliminarAgente(int agente);
+
+    // Método que avanza un agente a otra celda y recorta su ruta desde ella
+    void moverAgente(const Grid& grid, int agente, int posicion);
+
+    // Método que recibe las celdas cuyo estado bloqueado cambió en la grilla y repara las rutas afectadas.
+    // versionAnterior es la versión del mapa antes de aplicar los cambios: si el replanificador no estaba
+    // sincronizado con ella (el mapa se editó por otra vía), todos los agentes repiten su búsqueda.
+    // Devuelve los identificadores de los agentes replanificados.
+    std::vector<int> notificarCambios(const Grid& grid, const std::vector<int>& cambiadas, uint64_t versionAnterior);
+
+    // Métodos de consulta
+    const std::vector<int>& ruta(int agente) const { return agentes[agente].ruta; }
+    bool activo(int agente) const { return agente >= 0 && agente < (int)agentes.size() && agentes[agente].activo; }
+    size_t numeroAgentes() const { return agentes.size(); }
+    const EstadisticasBusqueda& obtenerEstadisticas() const { return medidas; }
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Códigos de dirección hacia el padre (mismo orden que el campo de flujo: arriba, abajo, izquierda, derecha)
+const uint8_t DIRECCION_ARRIBA = 0;
+const uint8_t DIRECCION_ABAJO = 1;
+const uint8_t DIRECCION_IZQUIERDA = 2;
+const uint8_t DIRECCION_DERECHA = 3;
+
+// Clase que guarda un código de dirección de Bits bits por celda empaquetado en palabras de 64 bits.
+// Con Bits = 2 caben las 4 direcciones cardinales; con Bits = 3, las 8 de la vecindad completa.
+template <int Bits>
+class DireccionesEmpaquetadas {
+private:
+    static_assert(Bits >= 1 && Bits <= 8, "Bits debe estar entre 1 y 8");
+    static const int CODIGOS_POR_PALABRA = 64 / Bits;
+    static const uint64_t MASCARA = (1ull << Bits) - 1;
+
+    std::vector<uint64_t> palabras;
+    size_t cantidad = 0;
+
+public:
+    // Método que ajusta el número de celdas y deja todos los códigos a 0
+    void redimensionar(size_t celdas) {
+        cantidad = celdas;
+        palabras.assign((celdas + CODIGOS_POR_PALABRA - 1) / CODIGOS_POR_PALABRA, 0);
+    }
+
+    // Método que devuelve el código guardado para la celda
+    uint8_t obtener(size_t indice) const {
+        int desplazamiento = (int)(indice % CODIGOS_POR_PALABRA) * Bits;
+        return (uint8_t)((palabras[indice / CODIGOS_POR_PALABRA] >> desplazamiento) & MASCARA);
+    }
+
+    // Método que guarda el código de la celda
+    void asignar(size_t indice, uint8_t codigo) {
+        int desplazamiento = (int)(indice % CODIGOS_POR_PALABRA) * Bits;
+        uint64_t& palabra = palabras[indice / CODIGOS_POR_PALABRA];
+        palabra = (palabra & ~(MASCARA << desplazamiento)) | ((uint64_t)(codigo & MASCARA) << desplazamiento);
+    }
+
+    // Método que devuelve el número de celdas
+    size_t tamano() const {
+        return cantidad;
+    }
+
+    // Método que devuelve los bytes ocupados por los códigos
+    size_t bytes() const {
+        return palabras.size() * sizeof(uint64_t);
+    }
+};
+
+// Clase con un bit por celda (por ejemplo, para marcar las celdas que pertenecen a un árbol)
+class MapaBits {
+private:
+    std::vector<uint64_t> palabras;
+
+public:
+    // Método que ajusta el número de celdas y deja todos los bits a 0
+    void redimensionar(size_t celdas) {
+        palabras.assign((celdas + 63) / 64, 0);
+    }
+
+    // Método que indica si el bit de la celda está activo
+    bool contiene(size_t indice) const {
+        return (palabras[indice >> 6] >> (indice & 63)) & 1;
+    }
+
+    // Método que activa el bit de la celda
+    void marcar(size_t indice) {
+        palabras[indice >> 6] |= 1ull << (indice & 63);
+    }
+
+    // Método que desactiva el bit de la celda
+    void desmarcar(size_t indice) {
+        palabras[indice >> 6] &= ~(1ull << (indice & 63));
+    }
+
+    // Método que devuelve los bytes ocupados por el mapa
+    size_t bytes() const {
+        return palabras.size() * sizeof(uint64_t);
+    }
+};
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Disposiciones en memoria de las celdas de la grilla
+enum DisposicionMemoria {
+    DISPOSICION_FILAS,   // Por filas (la original): moverse en vertical salta una fila entera
+    DISPOSICION_MOSAICO, // Por mosaicos de LADO_MOSAICO x LADO_MOSAICO celdas, guardados por filas
+    DISPOSICION_MORTON   // Curva Z (orden de Morton): intercala los bits de fila y columna
+};
+
+// Lado de cada mosaico: 8 x 8 celdas de 28 bytes ocupan unas 28 líneas de caché
+const int LADO_MOSAICO = 8;
+
+// Clase que traduce (fila, columna) a la posición de la celda en el vector de almacenamiento.
+// Las posiciones no coinciden con los índices por filas de la API (indiceCelda), que no cambian.
+class DisposicionCeldas {
+private:
+    DisposicionMemoria tipo = DISPOSICION_FILAS;
+    int columnas = 0;
+    int mosaicosPorFila = 0;   // Mosaicos en cada fila de mosaicos
+    int bitsComunes = 0;       // Bits de fila y columna que se intercalan en el orden de Morton
+    bool filaMasLarga = false; // Indica si los bits altos sobrantes son de la fila
+    size_t celdasReservadas = 0;
+    // Desplazamiento a la vecina de cada dirección (arriba, abajo, izquierda, derecha)
+    // cuando la vecina está en el mismo mosaico [0] o en el mosaico contiguo [1]
+    ptrdiff_t desplazamientos[4][2] = {};
+
+    // Función que reparte los 32 bits bajos de x en las posiciones pares de un entero de 64 bits
+    static uint64_t separarBits(uint64_t x) {
+        x &= 0xFFFFFFFFull;
+        x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+        x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+        x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+        x = (x | (x << 2)) & 0x3333333333333333ull;
+        x = (x | (x << 1)) & 0x5555555555555555ull;
+        return x;
+    }
+
+    // Función que devuelve el número de bits necesarios para representar valores de 0 a n - 1
+    static int bitsPara(int n) {
+        int bits = 0;
+        while ((1ll << bits) < n) bits++;
+        return bits;
+    }
+
+public:
+    // Método que prepara la disposición para una grilla de filas x columnas
+    void configurar(DisposicionMemoria disposicion, int filas, int columnas) {
+        tipo = disposicion;
+        this->columnas = columnas;
+        if (tipo == DISPOSICION_MOSAICO) {
+            // Se rellena hasta un número entero de mosaicos; las celdas de relleno nunca se visitan
+            mosaicosPorFila = (columnas + LADO_MOSAICO - 1) / LADO_MOSAICO;
+            int filasMosaico = (filas + LADO_MOSAICO - 1) / LADO_MOSAICO;
+            ptrdiff_t area = (ptrdiff_t)LADO_MOSAICO * LADO_MOSAICO;
+            ptrdiff_t filaDeMosaicos = (ptrdiff_t)mosaicosPorFila * area;
+            celdasReservadas = (size_t)filasMosaico * filaDeMosaicos;
+            desplazamientos[0][0] = -LADO_MOSAICO;
+            desplazamientos[0][1] = -filaDeMosaicos + (LADO_MOSAICO - 1) * LADO_MOSAICO;
+            desplazamientos[1][0] = LADO_MOSAICO;
+            desplazamientos[1][1] = filaDeMosaicos - (LADO_MOSAICO - 1) * LADO_MOSAICO;
+            desplazamientos[2][0] = -1;
+            desplazamientos[2][1] = -area + (LADO_MOSAICO - 1);
+            desplazamientos[3][0] = 1;
+            desplazamientos[3][1] = area - (LADO_MOSAICO - 1);
+        } else if (tipo == DISPOSICION_MORTON) {
+            // Se intercalan los bits que ambas dimensiones comparten; los bits sobrantes de la
+            // dimensión más larga van por encima, así el relleno no pasa de 4 veces la grilla
+            int bitsFila = bitsPara(filas);
+            int bitsColumna = bitsPara(columnas);
+            bitsComunes = bitsFila < bitsColumna ? bitsFila : bitsColumna;
+            filaMasLarga = bitsFila > bitsColumna;
+            celdasReservadas = (size_t)1 << (bitsFila + bitsColumna);
+        } else {
+            celdasReservadas = (size_t)filas * columnas;
+            desplazamientos[0][0] = desplazamientos[0][1] = -columnas;
+            desplazamientos[1][0] = desplazamientos[1][1] = columnas;
+            desplazamientos[2][0] = desplazamientos[2][1] = -1;
+            desplazamientos[3][0] = desplazamientos[3][1] = 1;
+        }
+    }
+
+    // Método que devuelve la disposición elegida
+    DisposicionMemoria obtenerTipo() const {
+        return tipo;
+    }
+
+    // Método que devuelve el número de celdas a reservar (incluido el relleno)
+    size_t reservadas() const {
+        return celdasReservadas;
+    }
+
+    // Método que devuelve la posición en memoria de la celda (fila, columna)
+    size_t posicion(int fila, int columna) const {
+        switch (tipo) {
+            case DISPOSICION_MOSAICO: {
+                size_t mosaico = (size_t)(fila / LADO_MOSAICO) * mosaicosPorFila + columna / LADO_MOSAICO;
+                return mosaico * (LADO_MOSAICO * LADO_MOSAICO)
+                     + (fila % LADO_MOSAICO) * LADO_MOSAICO + columna % LADO_MOSAICO;
+            }
+            case DISPOSICION_MORTON: {
+                uint64_t mascara = ((uint64_t)1 << bitsComunes) - 1;
+                uint64_t bajos = (separarBits(fila & mascara) << 1) | separarBits(columna & mascara);
+                uint64_t altos = (uint64_t)(filaMasLarga ? fila : columna) >> bitsComunes;
+                return (size_t)((altos << (2 * bitsComunes)) | bajos);
+            }
+            default:
+                return (size_t)fila * columnas + columna;
+        }
+    }
+
+    // Método que devuelve el desplazamiento desde la celda (fila, columna) hasta su vecina en la
+    // dirección indicada (0 arriba, 1 abajo, 2 izquierda, 3 derecha); la vecina debe existir
+    ptrdiff_t desplazamiento(int fila, int columna, int direccion) const {
+        switch (tipo) {
+            case DISPOSICION_MOSAICO: {
+                // Solo hay que saber si la vecina cae fuera del mosaico de la celda
+                bool borde = direccion == 0 ? fila % LADO_MOSAICO == 0
+                           : direccion == 1 ? fila % LADO_MOSAICO == LADO_MOSAICO - 1
+                           : direccion == 2 ? columna % LADO_MOSAICO == 0
+                           : columna % LADO_MOSAICO == LADO_MOSAICO - 1;
+                return desplazamientos[direccion][borde];
+            }
+            case DISPOSICION_MORTON: {
+                static const int DESPLAZAMIENTO[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+                return (ptrdiff_t)posicion(fila + DESPLAZAMIENTO[direccion][0], columna + DESPLAZAMIENTO[direccion][1])
+                     - (ptrdiff_t)posicion(fila, columna);
+            }
+            default:
+                return desplazamientos[direccion][0];
+        }
+    }
+};
@@ -1,284 +1,406 @@
 #include "entidades.h"
 
-// Fuente personalizada para dibujar texto
-Font fuentePersonalizada;
-
 // Constructor por defecto
-Celda::Celda() : fila(-1), columna(-1), estado(VACIO), visitado(false), padre(nullptr), g(INFINITY), h(0), f(INFINITY) {}
+Celda::Celda() : fila(-1), columna(-1), estado(VACIO), visitado(false), g(COSTE_INFINITO), h(0), f(COSTE_INFINITO) {}
 
 // Constructor con fila y columna
-Celda::Celda(int f, int c) : fila(f), columna(c), estado(VACIO), visitado(false), padre(nullptr), g(INFINITY), h(0), f(INFINITY) {}
+Celda::Celda(int f, int c) : fila(f), columna(c), estado(VACIO), visitado(false), g(COSTE_INFINITO), h(0), f(COSTE_INFINITO) {}
 
 // Operador de comparación para usar en la cola de prioridad (min-heap)
 bool Celda::operator>(const Celda& otro) const {
-    return f > otro.f; // La celda con mayor f (coste total) se considera "mayor"
+    // La celda con mayor f (coste total) se considera "mayor"; a igual f, la más lejana al destino
+    return claveCola(f, h) > claveCola(otro.f, otro.h);
 }
 
-// Constructor que crea una grilla de celdas
-Grid::Grid(int f, int c) : filas(f), columnas(c) {
-    celdas.resize(filas, std::vector<Celda>(columnas)); // Redimensionar la grilla
+// Constructor que crea una grilla de celdas con la disposición en memoria indicada
+Grid::Grid(int f, int c, DisposicionMemoria disposicionMemoria) : filas(f), columnas(c), version(0), reutilizarArboles(true),
+                                                                  desempate(DESEMPATE_MENOR_H) {
+    padres.redimensionar((size_t)filas * columnas); // Un código de dirección por celda
+    disposicion.configurar(disposicionMemoria, filas, columnas);
+    celdas.resize(disposicion.reservadas()); // Las celdas de relleno quedan con fila y columna -1
     for (int i = 0; i < filas; i++) {
         for (int j = 0; j < columnas; j++) {
-            celdas[i][j] = Celda(i, j); // Inicializar cada celda con sus coordenadas
+            celdas[disposicion.posicion(i, j)] = Celda(i, j); // Inicializar cada celda con sus coordenadas
         }
     }
 }
 
 // Método para obtener una celda en una posición específica
 Celda& Grid::obtenerCelda(int fila, int columna) {
-    return celdas[fila][columna];
+    return celdas[disposicion.posicion(fila, columna)];
 }
 
-// Método para dibujar la grilla de celdas en la pantalla
-void Grid::dibujarGrilla() const {
-    Color celesteClaro = Color{184, 237, 255, 255}; // Color de las celdas vacías
-    for (int i = 0; i < filas; i++) {
-        for (int j = 0; j < columnas; j++) {
-            Color color; // Variable para almacenar el color de la celda
-            // Asignar un color dependiendo del estado de la celda
-            switch (celdas[i][j].estado) {
-                case VACIO: color = celesteClaro; break;
-                case BLOQUEADO: color = RED; break;
-                case ORIGEN: color = GREEN; break;
-                case DESTINO: color = YELLOW; break;
-                case RUTA: color = BLUE; break;
-                default: color = celesteClaro; break;
-            }
-            // Posición de la celda en la pantalla
-            Vector2 posicion = { (float)(j * CELDA_TAM), (float)(i * CELDA_TAM + INSTRUCCIONES_ALTURA) };
-            // Dibujar el rectángulo representando la celda
-            DrawRectangleV(posicion, {CELDA_TAM, CELDA_TAM}, color);
-            // Dibujar el borde de la celda en color negro
-            DrawRectangleLinesEx({posicion.x, posicion.y, (float)CELDA_TAM, (float)CELDA_TAM}, 0.5, BLACK);
-
-            // Si la celda es origen o destino, dibujamos el texto "O" o "D"
-            if (celdas[i][j].estado == ORIGEN || celdas[i][j].estado == DESTINO) {
-                const char* texto = (celdas[i][j].estado == ORIGEN) ? "O" : "D"; // Determinamos qué texto mostrar
-                Vector2 size = MeasureTextEx(fuentePersonalizada, texto, 20, 0); // Medimos el tamaño del texto
-
-                // Centramos el texto en la celda
-                float posX = posicion.x + (CELDA_TAM - size.x) / 2;  // Centrado horizontal
-                float posY = posicion.y + (CELDA_TAM - size.y) / 2;  // Centrado vertical
-
-                // Dibujamos el texto en la celda
-                DrawTextEx(fuentePersonalizada, texto, { posX, posY }, 20, 0, BLACK);
-            }
+const Celda& Grid::obtenerCelda(int fila, int columna) const {
+    return celdas[disposicion.posicion(fila, columna)];
+}
+
+// Método que devuelve la celda vecina de una celda en la dirección indicada (debe existir)
+Celda& Grid::vecinaDe(Celda& celda, int direccion) {
+    return (&celda)[disposicion.desplazamiento(celda.fila, celda.columna, direccion)];
+}
+
+// Método para cambiar el estado de una celda desde el modo edición (aumenta la versión del mapa)
+void Grid::editarCelda(int fila, int columna, int estado) {
+    Celda& celda = obtenerCelda(fila, columna);
+    if (celda.estado == estado) return;
+    // Solo los cambios entre bloqueado y libre alteran el mapa que ven las búsquedas
+    if (celda.estado == BLOQUEADO || estado == BLOQUEADO) {
+        version++;
+    }
+    celda.estado = estado;
+}
+
+// Método para obtener la versión actual del mapa
+uint64_t Grid::obtenerVersion() const {
+    return version;
+}
+
+// Método que devuelve el índice (por filas) de una celda
+int Grid::indiceCelda(const Celda& celda) const {
+    return celda.fila * columnas + celda.columna;
+}
+
+// Método que devuelve los índices de la ruta de la última búsqueda, del origen al destino
+std::vector<int> Grid::extraerRuta(const Celda& origen, const Celda& destino) const {
+    std::vector<int> ruta;
+    if (!destino.visitado) return ruta;
+    // Desplazamiento del índice según el código de dirección hacia el padre
+    const int desplazamiento[4] = {-columnas, columnas, -1, 1};
+    int actual = indiceCelda(destino);
+    int inicio = indiceCelda(origen);
+    ruta.push_back(actual);
+    while (actual != inicio) {
+        actual += desplazamiento[padres.obtener(actual)];
+        ruta.push_back(actual);
+    }
+    std::reverse(ruta.begin(), ruta.end());
+    return ruta;
+}
+
+// Método que borra la ruta anterior y marca como RUTA las celdas indicadas por índice
+void Grid::marcarRutaIndices(const std::vector<int>& ruta) {
+    reiniciar();
+    estadisticas.reiniciar(); // Marcar una ruta conocida no expande ningún nodo
+    estadisticas.longitudRuta = ruta.empty() ? 0 : ruta.size() - 1;
+    for (int indice : ruta) {
+        Celda& celda = obtenerCelda(indice / columnas, indice % columnas);
+        if (celda.estado != ORIGEN && celda.estado != DESTINO) {
+            celda.estado = RUTA;
         }
     }
 }
 
+// Método para obtener la disposición en memoria de las celdas
+DisposicionMemoria Grid::obtenerDisposicion() const {
+    return disposicion.obtenerTipo();
+}
+
+// Métodos para obtener las dimensiones de la grilla
+int Grid::obtenerFilas() const {
+    return filas;
+}
+
+int Grid::obtenerColumnas() const {
+    return columnas;
+}
+
 // Método para reiniciar la grilla, puede reiniciar celdas bloqueadas y las celdas de origen/destino
 void Grid::reiniciar(bool reiniciarBloqueados, bool reiniciarOrigenDestino) {
-    for (int i = 0; i < filas; i++) {
-        for (int j = 0; j < columnas; j++) {
-            Celda& celda = celdas[i][j];
-            
-            // Si se indica, reiniciamos las celdas de origen y destino
-            if (reiniciarOrigenDestino && (celda.estado == ORIGEN || celda.estado == DESTINO)) {
-                celda.estado = VACIO;  // Ponemos origen y destino como celdas vacías
-            }
+    if (reiniciarBloqueados) {
+        version++; // Desbloquear celdas cambia el mapa
+        marcasCambio.clear(); // El mapa nuevo no arrastra las marcas de tiempo de los cambios del anterior
+    }
+    // Recorremos el almacenamiento en su propio orden (las celdas de relleno no afectan a nada)
+    for (Celda& celda : celdas) {
+        // Si se indica, reiniciamos las celdas de origen y destino
+        if (reiniciarOrigenDestino && (celda.estado == ORIGEN || celda.estado == DESTINO)) {
+            celda.estado = VACIO;  // Ponemos origen y destino como celdas vacías
+        }
 
-            // No reiniciamos las celdas de ORIGEN ni DESTINO si no se indica
-            if (celda.estado == ORIGEN || celda.estado == DESTINO) {
-                continue;
-            }
+        // No cambiamos el estado de las celdas de ORIGEN ni DESTINO si no se indica,
+        // pero sí sus valores de búsqueda para que las búsquedas repetidas partan de cero
+        bool esExtremo = celda.estado == ORIGEN || celda.estado == DESTINO;
 
-            // Reiniciamos las celdas si no están bloqueadas o si se pide reiniciar bloqueadas
-            if (celda.estado != BLOQUEADO || reiniciarBloqueados) {
-                celda.estado = VACIO;  // Restablecemos el estado a vacío
-            }
-
-            // Reiniciamos los valores de búsqueda
-            celda.visitado = false; // Marcamos la celda como no visitada
-            celda.padre = nullptr;  // Restablecemos el padre
-            celda.g = INFINITY;     // Coste acumulado infinito
-            celda.h = 0;            // Heurística a 0
-            celda.f = INFINITY;     // Coste total infinito
+        // Reiniciamos las celdas si no están bloqueadas o si se pide reiniciar bloqueadas
+        if (!esExtremo && (celda.estado != BLOQUEADO || reiniciarBloqueados)) {
+            celda.estado = VACIO;  // Restablecemos el estado a vacío
         }
+
+        // Reiniciamos los valores de búsqueda
+        celda.visitado = false; // Marcamos la celda como no visitada (su código de padre deja de ser válido)
+        celda.g = COSTE_INFINITO; // Coste acumulado infinito
+        celda.h = 0;              // Heurística a 0
+        celda.f = COSTE_INFINITO; // Coste total infinito
     }
 }
 
 // Método para reiniciar las estructuras específicas del algoritmo D* Lite
 void Grid::reiniciarAlgoritmoDStarLite() {
-    for (int i = 0; i < filas; i++) {
-        for (int j = 0; j < columnas; j++) {
-            Celda& celda = obtenerCelda(i, j);
-            celda.g = INFINITY;  // Reiniciar el costo acumulado
-            celda.f = INFINITY;  // Reiniciar el costo de la solución
-            celda.padre = nullptr;  // Reiniciar el predecesor
+    for (Celda& celda : celdas) {
+        celda.g = COSTE_INFINITO;  // Reiniciar el costo acumulado
+        celda.f = COSTE_INFINITO;  // Reiniciar el costo de la solución
+        celda.visitado = false; // Reiniciar el predecesor
+    }
+}
+
+// Método que guarda en la celda hija la dirección hacia su padre (celdas vecinas)
+void Grid::asignarPadre(const Celda& hijo, const Celda& padre) {
+    uint8_t codigo = padre.fila < hijo.fila ? DIRECCION_ARRIBA
+                   : padre.fila > hijo.fila ? DIRECCION_ABAJO
+                   : padre.columna < hijo.columna ? DIRECCION_IZQUIERDA
+                   : DIRECCION_DERECHA;
+    padres.asignar(indiceCelda(hijo), codigo);
+}
+
+// Método que decodifica la dirección guardada y devuelve el padre de una celda alcanzada
+Celda& Grid::obtenerPadre(const Celda& celda) {
+    switch (padres.obtener(indiceCelda(celda))) {
+        case DIRECCION_ARRIBA: return obtenerCelda(celda.fila - 1, celda.columna);
+        case DIRECCION_ABAJO: return obtenerCelda(celda.fila + 1, celda.columna);
+        case DIRECCION_IZQUIERDA: return obtenerCelda(celda.fila, celda.columna - 1);
+        default: return obtenerCelda(celda.fila, celda.columna + 1);
+    }
+}
+
+// Método para marcar la ruta desde el destino hasta el origen y devolver su número de pasos
+size_t Grid::marcarRuta(Celda& origen, Celda& destino) {
+    size_t pasos = 0;
+    Celda* temp = &destino;
+    while (temp != &origen) {
+        // Aseguramos que no cambiamos el destino a "RUTA"
+        if (temp != &destino) {
+            temp->estado = RUTA; // Marcamos la celda como parte de la ruta
         }
+        pasos++; // Cada celda distinta del origen es un paso de la ruta
+        temp = &obtenerPadre(*temp); // Retrocedemos hacia el origen decodificando la dirección
     }
+    return pasos;
 }
 
 // Función de búsqueda BFS
 bool Grid::BFS(Celda& origen, Celda& destino) {
     reiniciar(); // Restablecer el estado de todas las celdas antes de comenzar la búsqueda
+    estadisticas.reiniciar(); // Restablecer las métricas de la consulta
+
+    // Si ya tenemos el árbol de caminos de este origen, respondemos sin buscar
+    bool encontradaEnArbol = false;
+    if (reutilizarArboles && responderDesdeArbol(origen, destino, encontradaEnArbol)) {
+        return encontradaEnArbol;
+    }
+
+    MedicionMemoria memoria; // Medir la memoria que asigna la búsqueda
 
-    std::queue<Celda*> cola; // Cola para explorar las celdas en orden de BFS
+    // Cola para explorar las celdas en orden de BFS
+    std::queue<Celda*, std::deque<Celda*, AsignadorContador<Celda*>>> cola;
     origen.visitado = true; // Marcar la celda origen como visitada
     cola.push(&origen); // Añadir la celda origen a la cola para empezar la exploración
+    estadisticas.insercionesCola++;
+    estadisticas.registrarFrontera(cola.size());
+    bool detenido = false; // La búsqueda paró en el destino sin expandirlo
 
     // Mientras haya celdas por explorar en la cola
     while (!cola.empty()) {
         Celda* actual = cola.front(); // Obtener la celda actual (primera en la cola)
         cola.pop(); // Eliminar la celda de la cola
+        estadisticas.extraccionesCola++;
 
         // Si hemos llegado al destino, terminamos la búsqueda
         if (actual == &destino) {
+            detenido = true;
             break;
         }
-
-        // Revisamos las 4 celdas vecinas (arriba, abajo, izquierda, derecha)
-        for (int i = -1; i <= 1; i++) {
-            for (int j = -1; j <= 1; j++) {
-                // Aseguramos que solo exploramos las 4 direcciones cardinales (no diagonales)
-                if (i == 0 || j == 0) {  // Solo direcciones cardinales
-                    if (i == 0 && j == 0) continue; // No procesamos la celda actual
-
-                    // Calculamos las nuevas posiciones de fila y columna
-                    int nuevaFila = actual->fila + i;
-                    int nuevaColumna = actual->columna + j;
-                    if (i != 0 && j != 0) continue; // Aseguramos que no procesamos las diagonales
-
-                    // Verificamos si la celda vecina está dentro de los límites y no está bloqueada
-                    if (nuevaFila >= 0 && nuevaFila < filas && nuevaColumna >= 0 && nuevaColumna < columnas) {
-                        Celda& vecino = obtenerCelda(nuevaFila, nuevaColumna);
-                        if (!vecino.visitado && vecino.estado != BLOQUEADO) {
-                            vecino.visitado = true; // Marcamos la celda vecina como visitada
-                            vecino.padre = actual;  // Guardamos al padre para reconstruir la ruta
-                            cola.push(&vecino);     // Añadimos la celda vecina a la cola
-                        }
-                    }
+        estadisticas.nodosExpandidos++;
+
+        // Revisamos las 4 celdas vecinas (arriba, abajo, izquierda, derecha) por su código de dirección
+        for (int d = 0; d < 4; d++) {
+            // Calculamos las nuevas posiciones de fila y columna
+            int nuevaFila = actual->fila + DESPLAZAMIENTO_FLUJO[d][0];
+            int nuevaColumna = actual->columna + DESPLAZAMIENTO_FLUJO[d][1];
+
+            // Verificamos si la celda vecina está dentro de los límites y no está bloqueada
+            if (nuevaFila >= 0 && nuevaFila < filas && nuevaColumna >= 0 && nuevaColumna < columnas) {
+                // La vecina se alcanza con el desplazamiento precalculado de la disposición en memoria
+                Celda& vecino = vecinaDe(*actual, d);
+                if (!vecino.visitado && vecino.estado != BLOQUEADO) {
+                    vecino.visitado = true; // Marcamos la celda vecina como visitada
+                    asignarPadre(vecino, *actual); // Guardamos la dirección al padre para reconstruir la ruta
+                    cola.push(&vecino);     // Añadimos la celda vecina a la cola
+                    estadisticas.nodosGenerados++;
+                    estadisticas.insercionesCola++;
                 }
             }
         }
+        estadisticas.registrarFrontera(cola.size());
     }
 
-    // Si hemos encontrado el destino (su padre no es nullptr), reconstruimos la ruta
-    if (destino.padre != nullptr) {
-        Celda* temp = &destino;
-        while (temp != nullptr) {
-            // Aseguramos que no cambiamos el origen ni el destino a "RUTA"
-            if (temp != &origen && temp != &destino) {
-                temp->estado = RUTA; // Marcamos la celda como parte de la ruta
-            }
-            temp = temp->padre; // Retrocedemos hacia el origen
-        }
+    // Memoria asignada por la cola durante la búsqueda
+    estadisticas.bytesAuxiliares = memoria.bytesPico();
+    estadisticas.bytesVivos = memoria.bytesVivos();
+    estadisticas.asignaciones = memoria.asignaciones();
+
+    // Guardamos el árbol de padres para las próximas consultas desde el mismo origen; solo cubre
+    // toda la región alcanzable si la cola se vació sin cortar la búsqueda en el destino
+    if (reutilizarArboles) {
+        guardarArbol(origen, !detenido);
+    }
+
+    // Si hemos alcanzado el destino, reconstruimos la ruta
+    if (destino.visitado) {
+        estadisticas.longitudRuta = marcarRuta(origen, destino);
         return true; // Ruta encontrada
     }
     return false; // No se encontró una ruta
 }
 
+// Método que guarda en forma compacta el árbol de padres que dejó BFS desde el origen
+void Grid::guardarArbol(const Celda& origen, bool completo) {
+    ArbolCaminos arbol;
+    arbol.origen = indiceCelda(origen);
+    arbol.version = version;
+    arbol.completo = completo;
+    arbol.columnas = columnas;
+    arbol.padres = padres; // Los códigos de dirección ya están empaquetados: basta con copiarlos
+    arbol.enArbol.redimensionar((size_t)filas * columnas);
+    for (const Celda& celda : celdas) {
+        if (celda.visitado) {
+            arbol.enArbol.marcar(indiceCelda(celda)); // Las celdas de relleno nunca se visitan
+        }
+    }
+    arboles.guardar(std::move(arbol));
+}
+
+// Método que intenta responder la consulta recorriendo un árbol guardado
+bool Grid::responderDesdeArbol(Celda& origen, Celda& destino, bool& encontrada) {
+    const ArbolCaminos* arbol = arboles.buscar(indiceCelda(origen), version);
+    if (arbol == nullptr) return false;
+
+    std::vector<int> ruta;
+    if (!arbol->reconstruir(indiceCelda(destino), ruta)) {
+        // Si el árbol cubre toda la región alcanzable, el destino es inalcanzable
+        encontrada = false;
+        return arbol->completo;
+    }
+
+    // Restauramos las direcciones a lo largo de la ruta y la marcamos
+    Celda* anterior = nullptr;
+    for (int indice : ruta) {
+        Celda& celda = obtenerCelda(indice / columnas, indice % columnas);
+        celda.visitado = true;
+        if (anterior != nullptr) {
+            asignarPadre(celda, *anterior);
+        }
+        if (&celda != &origen && &celda != &destino) {
+            celda.estado = RUTA;
+        }
+        anterior = &celda;
+    }
+    estadisticas.longitudRuta = ruta.size() - 1;
+    encontrada = true;
+    return true;
+}
+
+// Método para elegir cómo se desempatan en D* Lite las celdas con el mismo coste f
+void Grid::establecerDesempate(PoliticaDesempate politica) {
+    desempate = politica;
+}
+
+// Método para activar o desactivar la reutilización de árboles de caminos en BFS
+void Grid::activarReutilizacionArboles(bool activar) {
+    reutilizarArboles = activar;
+    if (!activar) {
+        arboles.vaciar();
+    }
+}
+
+// Método para consultar el almacén de árboles (aciertos, fallos, memoria)
+const AlmacenArboles& Grid::obtenerArboles() const {
+    return arboles;
+}
+
 // Función de búsqueda D* Lite
 bool Grid::DStarLite(Celda& origen, Celda& destino) {
     reiniciar(); // Restablecer el estado de todas las celdas
+    estadisticas.reiniciar(); // Restablecer las métricas de la consulta
+    MedicionMemoria memoria; // Medir la memoria que asigna la búsqueda
 
-    // Cola de prioridad que guarda celdas con su coste f (g + h)
-    std::unordered_map<Celda*, float> colaPrioridad;
+    // Montículo mínimo de celdas por su clave empaquetada: coste f (g + h) y, a igual f, la política de
+    // desempate. Las entradas obsoletas (cuyo f ya no coincide con el de la celda) se descartan al extraerlas
+    using Entrada = std::pair<uint64_t, Celda*>;
+    auto mayorClave = [](const Entrada& a, const Entrada& b) { return a.first > b.first; };
+    std::priority_queue<Entrada, std::vector<Entrada, AsignadorContador<Entrada>>, decltype(mayorClave)> colaPrioridad(mayorClave);
+    uint32_t orden = 0; // Orden de inserción para los desempates FIFO y LIFO
 
     // Inicializamos la celda origen con costes g, h, y f
     origen.g = 0;
     origen.h = calcularHeuristica(origen, destino); // Calculamos la heurística
     origen.f = origen.g + origen.h;
-    colaPrioridad[&origen] = origen.f; // Añadimos la celda origen a la cola de prioridad
+    origen.visitado = true;
+    colaPrioridad.push({claveDesempate(desempate, origen.f, origen.h, orden++), &origen}); // Añadimos la celda origen a la cola de prioridad
+    estadisticas.insercionesCola++;
+    estadisticas.registrarFrontera(colaPrioridad.size());
 
     // Mientras haya celdas en la cola de prioridad
     while (!colaPrioridad.empty()) {
-        // Buscar la celda con el menor coste f
-        Celda* actual = nullptr;
-        float menorF = INFINITY;
-        for (auto& entry : colaPrioridad) {
-            if (entry.second < menorF) {
-                menorF = entry.second;
-                actual = entry.first;
-            }
-        }
-
-        colaPrioridad.erase(actual); // Eliminamos la celda con el menor coste f
+        // Extraemos la celda con la menor clave (menor coste f y, a igual f, la que prefiere el desempate)
+        Entrada entrada = colaPrioridad.top();
+        colaPrioridad.pop();
+        estadisticas.extraccionesCola++;
+        Celda* actual = entrada.second;
+        if ((CosteBusqueda)(entrada.first >> 32) != actual->f) continue; // Entrada obsoleta
 
         // Si hemos llegado al destino, reconstruimos la ruta
         if (actual == &destino) {
-            // Hemos llegado al destino, reconstruimos la ruta
-            Celda* temp = actual;
-            while (temp != nullptr) {
-                // Asegurarnos de no cambiar el origen ni el destino a "RUTA"
-                if (temp != &origen && temp != &destino) {
-                    temp->estado = RUTA; // Marcamos la celda como parte de la ruta
-                }
-                temp = temp->padre; // Retrocedemos hacia el origen
-            }
+            estadisticas.longitudRuta = marcarRuta(origen, destino);
+            estadisticas.bytesAuxiliares = memoria.bytesPico();
+            estadisticas.bytesVivos = memoria.bytesVivos();
+            estadisticas.asignaciones = memoria.asignaciones();
             return true; // Ruta encontrada
         }
-
-        // Exploramos las 4 celdas vecinas (arriba, abajo, izquierda, derecha)
-        for (int i = -1; i <= 1; i++) {
-            for (int j = -1; j <= 1; j++) {
-                if (i == 0 && j == 0) continue; // No procesamos la celda actual
-
-                // Solo exploramos celdas ortogonales (sin diagonales)
-                if (i != 0 && j != 0) continue;
-
-                int nuevaFila = actual->fila + i;
-                int nuevaColumna = actual->columna + j;
-
-                // Verificamos que la celda vecina esté dentro de los límites
-                if (nuevaFila >= 0 && nuevaFila < filas && nuevaColumna >= 0 && nuevaColumna < columnas) {
-                    Celda& vecino = obtenerCelda(nuevaFila, nuevaColumna);
-                    
-                    // Si la celda no está bloqueada, la procesamos
-                    if (vecino.estado != BLOQUEADO) {
-                        float nuevoG = actual->g + 1;  // Suponemos que el coste de movernos entre celdas es 1
-                        if (nuevoG < vecino.g) { // Si encontramos un camino más corto
-                            vecino.g = nuevoG; // Actualizamos el coste g
-                            vecino.h = calcularHeuristica(vecino, destino); // Calculamos la heurística
-                            vecino.f = vecino.g + vecino.h; // Actualizamos el coste total f
-                            vecino.padre = actual; // Guardamos el padre para reconstruir la ruta
-                            colaPrioridad[&vecino] = vecino.f;  // Actualizamos la celda en la cola de prioridad
-                        }
+        estadisticas.nodosExpandidos++;
+
+        // Exploramos las 4 celdas vecinas (arriba, abajo, izquierda, derecha) por su código de dirección
+        for (int d = 0; d < 4; d++) {
+            int nuevaFila = actual->fila + DESPLAZAMIENTO_FLUJO[d][0];
+            int nuevaColumna = actual->columna + DESPLAZAMIENTO_FLUJO[d][1];
+
+            // Verificamos que la celda vecina esté dentro de los límites
+            if (nuevaFila >= 0 && nuevaFila < filas && nuevaColumna >= 0 && nuevaColumna < columnas) {
+                // La vecina se alcanza con el desplazamiento precalculado de la disposición en memoria
+                Celda& vecino = vecinaDe(*actual, d);
+
+                // Si la celda no está bloqueada, la procesamos
+                if (vecino.estado != BLOQUEADO) {
+                    estadisticas.nodosGenerados++;
+                    CosteBusqueda nuevoG = actual->g + 1;  // Suponemos que el coste de movernos entre celdas es 1
+                    if (nuevoG < vecino.g) { // Si encontramos un camino más corto
+                        vecino.g = nuevoG; // Actualizamos el coste g
+                        vecino.h = calcularHeuristica(vecino, destino); // Calculamos la heurística
+                        vecino.f = vecino.g + vecino.h; // Actualizamos el coste total f
+                        vecino.visitado = true; // La celda ya tiene una dirección al padre válida
+                        asignarPadre(vecino, *actual); // Guardamos la dirección al padre para reconstruir la ruta
+                        colaPrioridad.push({claveDesempate(desempate, vecino.f, vecino.h, orden++), &vecino}); // Insertamos la celda con su nueva clave
+                        estadisticas.insercionesCola++;
                     }
                 }
             }
         }
+        estadisticas.registrarFrontera(colaPrioridad.size());
     }
 
+    // Memoria asignada por la cola de prioridad durante la búsqueda
+    estadisticas.bytesAuxiliares = memoria.bytesPico();
+    estadisticas.bytesVivos = memoria.bytesVivos();
+    estadisticas.asignaciones = memoria.asignaciones();
     return false; // No se encontró una ruta
 }
 
+// Método para obtener las métricas de la última búsqueda (BFS o D* Lite)
+const EstadisticasBusqueda& Grid::obtenerEstadisticas() const {
+    return estadisticas;
+}
+
 // Función de cálculo de heurística (distancia de Manhattan)
-float Grid::calcularHeuristica(const Celda& origen, const Celda& destino) const {
+CosteBusqueda Grid::calcularHeuristica(const Celda& origen, const Celda& destino) const {
     // Heurística de Manhattan (distancia en línea recta)
     return abs(origen.fila - destino.fila) + abs(origen.columna - destino.columna);
 }
-
-// Función para dibujar las instrucciones en pantalla
-void dibujarInstrucciones(bool modoEdicion) {
-    const char* instrucciones = 
-        "INSTRUCCIONES:\n\n"
-        "1. Presiona CTRL para activar/desactivar el modo edicion.\n"
-        "2. En modo edicion, Clic Izquierdo bloquea casillas (rojo).\n"
-        "3. En modo edicion, Clic Derecho desbloquea casillas (celeste claro).\n"
-        "4. Presiona Clic Izquierdo para seleccionar origen (verde) y destino (amarillo).\n"
-        "5. Presiona ENTER para buscar ruta (BFS) entre origen y destino.\n"
-        "6. Presiona ESPACIO para buscar ruta (D* Lite) entre origen y destino.\n"
-        "7. Presiona ESC para reiniciar la grilla a su estado inicial.";
-
-    // Fondo de las instrucciones (color azul oscuro)
-    DrawRectangle(0, 0, GetScreenWidth(), INSTRUCCIONES_ALTURA, Color{30, 42, 71, 255});
-
-    // Centrar "Buscador de Rutas" en la parte superior de la pantalla
-    const char* titulo = "Buscador de Rutas";
-    int anchoTexto = MeasureText(titulo, 30);
-    int posicionX = (GetScreenWidth() - anchoTexto) / 2;
-    DrawTextEx(fuentePersonalizada, titulo, { (float)posicionX, 20 }, 30, 0, Color{240, 240, 240, 255});  // Título en color blanco
-
-    int posicionInstruccionesY = 60; // Distancia entre el título y las instrucciones
-    DrawTextEx(fuentePersonalizada, instrucciones, {10.0f, (float)posicionInstruccionesY}, 20, 0, Color{190, 190, 190, 255});  // Instrucciones en color gris claro
-
-    // Si estamos en modo edición, mostrar un mensaje adicional
-    if (modoEdicion) {
-        const char* mensajeModoEdicion = "Modo Edicion Activado! Presiona CTRL para desactivar";
-        int anchoMensaje = MeasureText(mensajeModoEdicion, 20);
-        int posicionXMensaje = (GetScreenWidth() - anchoMensaje) / 2;
-        DrawTextEx(fuentePersonalizada, mensajeModoEdicion, { (float)posicionXMensaje, (float)(INSTRUCCIONES_ALTURA - 30) }, 20, 0, Color{255, 0, 0, 255});  // Aviso en color rojo brillante
-    }
-}
@@ -1,12 +1,28 @@
+#pragma once
+
 #include <iostream>
 #include <vector>
 #include <queue>
 #include <cmath>
 #include <unordered_map>
-#include "raylib.h" // Biblioteca para la interfaz gráfica (GUI)
-
-// Fuente personalizada para dibujar texto
-extern Font fuentePersonalizada;
+#include <cstdint>
+#include <algorithm>
+#include <chrono>
+#include "metricas.h" // Métricas algorítmicas por consulta
+#include "memoria.h"  // Asignador que contabiliza la memoria de cada búsqueda
+#include "flujo.h"    // Campo de flujo hacia un destino compartido
+#include "arboles.h"  // Árboles de caminos mínimos reutilizables
+#include "disposicion.h" // Disposición de las celdas en memoria (por filas, mosaicos o Morton)
+#include "subobjetivos.h" // Grafo de subobjetivos para consultas óptimas en mapas estáticos
+#include "jerarquia.h"    // Jerarquía de contracción para consultas masivas en mapas estáticos
+#include "basecaminos.h"  // Base de caminos comprimida con el primer movimiento de cada ruta
+#include "visibilidad.h"  // Línea de visión sobre la máscara de celdas bloqueadas
+#include "movingai.h"     // Mapas y escenarios en formato MovingAI
+#include "kernels.h"      // Núcleos de búsqueda especializados por vecindad, coste y heurística
+#include "dinamico.h"     // Flujo de cambios de obstáculos y reparación de rutas de agentes
+#include "cooperativo.h"  // Rutas de muchos agentes con reservas espacio-tiempo (WHCA*)
+#include "conflictos.h"   // Rutas óptimas de varios agentes por búsqueda basada en conflictos (CBS/ECBS)
+#include "anytime.h"      // Búsqueda anytime con plazo (ARA*) y su cota de suboptimalidad
 
 // Constantes para representar los diferentes estados de las celdas en la grilla
 const int VACIO = 0;
@@ -15,17 +31,49 @@ const int ORIGEN = 2;
 const int DESTINO = 3;
 const int RUTA = 4;
 const int CELDA_TAM = 40; // Tamaño de cada celda en píxeles
-const int INSTRUCCIONES_ALTURA = 240; // Altura de la sección de instrucciones en la interfaz
+const int INSTRUCCIONES_ALTURA = 280; // Altura de la sección de instrucciones en la interfaz
+const int BITS_DIRECCION = 2; // Bits por celda del código de dirección al padre (4 vecinos)
+
+// Tipo entero de los costes de búsqueda (g, h y f): las grillas tienen coste unitario entre vecinas
+typedef uint32_t CosteBusqueda;
+const CosteBusqueda COSTE_INFINITO = UINT32_MAX; // Coste de una celda todavía no alcanzada
+
+// Función que empaqueta una clave de la cola de prioridad en un entero de 64 bits: la prioridad en la
+// parte alta y el desempate en la baja, de modo que ordenar las entradas es una sola comparación entera
+inline uint64_t claveCola(CosteBusqueda prioridad, uint32_t desempate) {
+    return (uint64_t)prioridad << 32 | desempate;
+}
+
+// Políticas de desempate entre entradas de la cola con el mismo coste f
+enum PoliticaDesempate {
+    DESEMPATE_NINGUNO,     // Sin desempate: el orden entre iguales depende del montículo
+    DESEMPATE_FIFO,        // Primero la entrada más antigua
+    DESEMPATE_LIFO,        // Primero la entrada más reciente (profundiza en la meseta de f)
+    DESEMPATE_MENOR_H,     // Primero la más cercana al destino (a igual f, equivale a mayor g)
+    DESEMPATE_MENOR_H_LIFO // Menor h y, a igual h, la más reciente
+};
+
+// Función que construye la clave de la cola con la política de desempate en los 32 bits bajos.
+// En DESEMPATE_MENOR_H_LIFO, h ocupa 16 bits (saturada) y el orden de inserción los otros 16:
+// cuando el contador da la vuelta solo cambia el orden entre empates, nunca el coste de la ruta.
+inline uint64_t claveDesempate(PoliticaDesempate politica, CosteBusqueda f, CosteBusqueda h, uint32_t orden) {
+    switch (politica) {
+    case DESEMPATE_FIFO: return claveCola(f, orden);
+    case DESEMPATE_LIFO: return claveCola(f, ~orden);
+    case DESEMPATE_MENOR_H: return claveCola(f, h);
+    case DESEMPATE_MENOR_H_LIFO: return claveCola(f, std::min<CosteBusqueda>(h, 0xFFFF) << 16 | (~orden & 0xFFFF));
+    default: return claveCola(f, 0);
+    }
+}
 
 // Estructura que representa una celda en la grilla
 struct Celda {
     int fila;
     int columna;
     int estado; // Estado de la celda: vacío, bloqueado, origen, destino, ruta
-    bool visitado; // Indica si la celda ha sido visitada
-    Celda* padre; // Puntero al padre en el camino
-    float g, h;   // g: coste acumulado, h: heurística
-    float f;      // f = g + h (coste total)
+    bool visitado; // Indica si la celda ha sido alcanzada (su dirección al padre es válida)
+    CosteBusqueda g, h; // g: coste acumulado, h: heurística
+    CosteBusqueda f;    // f = g + h (coste total)
 
     // Constructor por defecto
     Celda();
@@ -37,21 +85,94 @@ struct Celda {
     bool operator>(const Celda& otro) const;
 };
 
+// Marcas de una celda por índice (por filas) cuya memoria se contabiliza en la búsqueda
+using MarcasCeldas = std::vector<bool, AsignadorContador<bool>>;
+
+// Estructura con el resultado de una búsqueda con varios orígenes y varios destinos
+struct ResultadoMultiple {
+    Celda* origen = nullptr;  // Origen desde el que se alcanza el destino más cercano
+    Celda* destino = nullptr; // Destino más cercano a cualquiera de los orígenes
+    CosteBusqueda coste = COSTE_INFINITO; // Coste de la ruta (incluido el coste inicial del origen en Dijkstra)
+    std::vector<Celda*> ruta; // Celdas de la ruta, desde el origen hasta el destino
+};
+
 // Clase que representa la grilla de celdas
 class Grid {
 private:
-    std::vector<std::vector<Celda>> celdas; // Matriz de celdas
+    std::vector<Celda> celdas; // Celdas en un único bloque, ordenadas según la disposición
+    DisposicionCeldas disposicion; // Traducción de (fila, columna) a la posición en memoria
     int filas;
     int columnas;
+    EstadisticasBusqueda estadisticas; // Métricas de la última búsqueda ejecutada
+    uint64_t version; // Versión del mapa: aumenta con cada cambio de celdas bloqueadas
+    // Dirección hacia el padre de cada celda alcanzada (por filas), empaquetada en 2 bits.
+    // Sustituye al puntero de 8 bytes por celda y reduce el estado de búsqueda en memoria.
+    DireccionesEmpaquetadas<BITS_DIRECCION> padres;
+    AlmacenArboles arboles;  // Árboles de caminos mínimos de los últimos orígenes de BFS
+    bool reutilizarArboles;  // Indica si BFS responde desde los árboles guardados
+    PoliticaDesempate desempate; // Desempate entre celdas con el mismo f en D* Lite
+    ReplanificadorAgentes agentes; // Agentes registrados cuyas rutas se reparan con los cambios de obstáculos
+    std::vector<uint64_t> marcasCambio; // Marca de tiempo del último cambio aplicado a cada celda (por filas)
+    MapaVisibilidad visibilidad; // Máscara de bits de celdas bloqueadas para la línea de visión
+    EspacioAnytime espacioAnytime; // Memoria de trabajo de ARA*, reutilizada entre consultas
+
+    // Método que guarda en forma compacta el árbol de padres que dejó BFS desde el origen
+    void guardarArbol(const Celda& origen, bool completo);
+
+    // Método que intenta responder la consulta recorriendo un árbol guardado;
+    // devuelve true si hubo respuesta (encontrada indica si existe ruta)
+    bool responderDesdeArbol(Celda& origen, Celda& destino, bool& encontrada);
+
+    // Método que guarda en la celda hija la dirección hacia su padre (celdas vecinas)
+    void asignarPadre(const Celda& hijo, const Celda& padre);
+
+    // Método que decodifica la dirección guardada y devuelve el padre de una celda alcanzada
+    Celda& obtenerPadre(const Celda& celda);
+
+    // Método que reconstruye la ruta de una búsqueda multiorigen hasta la raíz que la alcanzó y la marca
+    void reconstruirRutaMultiple(Celda& destino, const MarcasCeldas& esRaiz, ResultadoMultiple& resultado);
+
+    // Método que devuelve la celda vecina de una celda en la dirección indicada (debe existir)
+    Celda& vecinaDe(Celda& celda, int direccion);
+
+    // Método que devuelve la máscara de visibilidad del mapa actual (se reconstruye si el mapa cambió)
+    const MapaVisibilidad& mapaVisibilidad();
+
+    // Método para marcar la ruta desde el destino hasta el origen y devolver su número de pasos
+    size_t marcarRuta(Celda& origen, Celda& destino);
 
 public:
-    // Constructor que crea una grilla de celdas
-    Grid(int f, int c);
+    // Constructor que crea una grilla de celdas con la disposición en memoria indicada
+    Grid(int f, int c, DisposicionMemoria disposicionMemoria = DISPOSICION_FILAS);
 
     // Método para obtener una celda en una posición específica
     Celda& obtenerCelda(int fila, int columna);
+    const Celda& obtenerCelda(int fila, int columna) const;
+
+    // Método para cambiar el estado de una celda desde el modo edición (aumenta la versión del mapa)
+    void editarCelda(int fila, int columna, int estado);
+
+    // Método para obtener la versión actual del mapa
+    uint64_t obtenerVersion() const;
 
-    // Método para dibujar la grilla de celdas en la pantalla
+    // Método que devuelve el índice (por filas) de una celda
+    int indiceCelda(const Celda& celda) const;
+
+    // Método que devuelve los índices de la ruta de la última búsqueda, del origen al destino
+    // (vacío si la búsqueda no alcanzó el destino)
+    std::vector<int> extraerRuta(const Celda& origen, const Celda& destino) const;
+
+    // Método que borra la ruta anterior y marca como RUTA las celdas indicadas por índice
+    void marcarRutaIndices(const std::vector<int>& ruta);
+
+    // Método para obtener la disposición en memoria de las celdas
+    DisposicionMemoria obtenerDisposicion() const;
+
+    // Métodos para obtener las dimensiones de la grilla
+    int obtenerFilas() const;
+    int obtenerColumnas() const;
+
+    // Método para dibujar la grilla de celdas en la pantalla (definido en la interfaz, fuera del núcleo)
     void dibujarGrilla() const;
 
     // Método para reiniciar la grilla, puede reiniciar celdas bloqueadas y las celdas de origen/destino
@@ -66,9 +187,104 @@ public:
     // Función de búsqueda D* Lite
     bool DStarLite(Celda& origen, Celda& destino);
 
+    // Función de búsqueda anytime (ARA*): devuelve pronto una ruta con la heurística inflada y la mejora
+    // mientras quede plazo. Se detiene al llegar al plazo o a la inflación final; el resultado indica el
+    // coste de la mejor ruta, la cota de suboptimalidad demostrada y cada mejora publicada
+    bool ARAStar(Celda& origen, Celda& destino, std::chrono::steady_clock::time_point plazo,
+                 const ConfiguracionAnytime& configuracion, ResultadoAnytime& resultado);
+
+    // Función de búsqueda BFS con varios orígenes y varios destinos: la frontera empieza con todos
+    // los orígenes libres (los bloqueados se ignoran) y un único barrido encuentra el destino más cercano y su ruta
+    bool BFSMultiple(const std::vector<Celda*>& origenes, const std::vector<Celda*>& destinos, ResultadoMultiple& resultado);
+
+    // Función de búsqueda Dijkstra con varios orígenes (cada uno con un coste inicial opcional; los
+    // bloqueados se ignoran) y varios destinos; devuelve el destino de menor coste total
+    bool DijkstraMultiple(const std::vector<Celda*>& origenes, const std::vector<CosteBusqueda>& costesIniciales,
+                          const std::vector<Celda*>& destinos, ResultadoMultiple& resultado);
+
+    // Método que calcula, con un único BFS desde el destino, la distancia y la dirección
+    // hacia el destino de todas las celdas (campo de flujo para muchos agentes)
+    void calcularCampoFlujo(const Celda& destino, CampoFlujo& campo);
+
+    // Método que marca como ruta el camino que sigue un agente desde el origen por el campo de flujo
+    bool seguirCampoFlujo(Celda& origen, const CampoFlujo& campo);
+
+    // Función de búsqueda óptima sobre un grafo de subobjetivos ya construido para el mapa actual
+    // (si el grafo no está sincronizado con la versión del mapa, se responde con BFS)
+    bool buscarConSubobjetivos(const GrafoSubobjetivos& grafo, Celda& origen, Celda& destino);
+
+    // Función de búsqueda sobre una jerarquía de contracción ya construida o cargada para el mapa actual
+    // (si la jerarquía no está sincronizada con la versión del mapa, se responde con BFS)
+    bool buscarConJerarquia(const JerarquiaContraccion& jerarquia, Celda& origen, Celda& destino);
+
+    // Función de búsqueda sobre una base de caminos comprimida ya construida o cargada para el mapa actual
+    // (si la base no está sincronizada con la versión del mapa, se responde con BFS)
+    bool buscarConBaseCaminos(const BaseCaminos& base, Celda& origen, Celda& destino);
+
+    // Función de búsqueda Lazy Theta* (cualquier ángulo): devuelve en puntos los puntos de paso
+    // de la ruta (índices por filas, del origen al destino) y marca las celdas que atraviesa
+    bool ThetaPerezoso(Celda& origen, Celda& destino, std::vector<int>& puntos);
+
+    // Método que suaviza una ruta de celdas vecinas (por ejemplo, la de BFS o D* Lite) quitando los puntos
+    // intermedios que se ven en línea recta; devuelve los puntos de paso y suma las comprobaciones
+    // de visibilidad a las métricas de la última búsqueda
+    std::vector<int> suavizarRuta(const std::vector<int>& ruta);
+
+    // Función de búsqueda con el núcleo especializado para la vecindad, el coste y la heurística indicados,
+    // sobre una malla ya preparada (si la malla no está sincronizada con la versión del mapa, se responde con BFS)
+    bool buscarConKernel(const MallaBusqueda& malla, const ConfiguracionKernel& configuracion,
+                         Celda& origen, Celda& destino);
+
+    // Método que registra un agente que viaja entre dos celdas y calcula su ruta; devuelve su identificador
+    int registrarAgente(Celda& origen, Celda& destino);
+
+    // Método que da de baja un agente
+    void eliminarAgente(int agente);
+
+    // Método que avanza un agente a otra celda (su ruta se recorta o se repara desde ella)
+    void moverAgente(int agente, Celda& posicion);
+
+    // Método que devuelve la ruta actual de un agente (índices por filas; vacía si no hay ruta)
+    const std::vector<int>& rutaAgente(int agente) const;
+
+    // Método que aplica un lote de cambios de obstáculos en orden de marca de tiempo y repara
+    // incrementalmente las rutas de los agentes que cruzan una celda cambiada. Los cambios más antiguos
+    // que el último aplicado en su celda se ignoran. Devuelve los agentes replanificados; las métricas
+    // de la reparación quedan en las estadísticas de la grilla.
+    std::vector<int> empujarCambios(const std::vector<CambioCelda>& lote);
+
+    // Método para elegir cómo se desempatan en D* Lite las celdas con el mismo coste f
+    void establecerDesempate(PoliticaDesempate politica);
+
+    // Método para activar o desactivar la reutilización de árboles de caminos en BFS
+    void activarReutilizacionArboles(bool activar);
+
+    // Método para consultar el almacén de árboles (aciertos, fallos, memoria)
+    const AlmacenArboles& obtenerArboles() const;
+
+    // Método para obtener las métricas de la última búsqueda (BFS o D* Lite)
+    const EstadisticasBusqueda& obtenerEstadisticas() const;
+
+    // Generadores procedurales deterministas (misma semilla, mismo mapa) para pruebas de carga.
+    // Borran la grilla, incluidas las celdas de origen y destino.
+    // Generador de obstáculos aleatorios con la densidad indicada (0 a 1)
+    void generarObstaculosAleatorios(double densidad, uint64_t semilla);
+
+    // Generador de laberinto perfecto por división recursiva
+    void generarLaberinto(uint64_t semilla);
+
+    // Generador de habitaciones rectangulares unidas por pasillos
+    void generarHabitaciones(uint64_t semilla);
+
+    // Generador de terreno por ruido de Perlin: se bloquean las celdas cuyo ruido supera el umbral
+    void generarTerrenoPerlin(double escala, double umbral, uint64_t semilla);
+
+    // Método que copia las celdas bloqueadas de un mapa MovingAI (la grilla debe tener sus dimensiones)
+    void aplicarMapaMovingAI(const MapaMovingAI& mapa);
+
+    // Método que copia las celdas bloqueadas de la grilla en un mapa MovingAI
+    void exportarMapaMovingAI(MapaMovingAI& mapa) const;
+
     // Función de cálculo de heurística (distancia de Manhattan)
-    float calcularHeuristica(const Celda& origen, const Celda& destino) const;
+    CosteBusqueda calcularHeuristica(const Celda& origen, const Celda& destino) const;
 };
-
-// Función que dibuja las instrucciones en pantalla
-void dibujarInstrucciones(bool modoEdicion);
@@ -0,0 +1,77 @@
+#include "entidades.h"
+
+// Método que calcula, con un único BFS desde el destino, la distancia y la dirección
+// hacia el destino de todas las celdas (campo de flujo para muchos agentes)
+void Grid::calcularCampoFlujo(const Celda& destino, CampoFlujo& campo) {
+    estadisticas.reiniciar();
+    MedicionMemoria memoria;
+
+    size_t totalCeldas = (size_t)filas * columnas;
+    campo.filas = filas;
+    campo.columnas = columnas;
+    campo.filaDestino = destino.fila;
+    campo.columnaDestino = destino.columna;
+    campo.distancia.assign(totalCeldas, DISTANCIA_INFINITA);
+    campo.direccion.assign(totalCeldas, FLUJO_NINGUNO);
+
+    // Cola del BFS como vector plano: cada celda entra como mucho una vez
+    std::vector<uint32_t, AsignadorContador<uint32_t>> cola;
+    cola.reserve(totalCeldas);
+    uint32_t indiceDestino = (uint32_t)(destino.fila * columnas + destino.columna);
+    campo.distancia[indiceDestino] = 0;
+    campo.direccion[indiceDestino] = FLUJO_META;
+    cola.push_back(indiceDestino);
+    estadisticas.insercionesCola++;
+
+    // El vecino alcanzado en la dirección d debe moverse en la dirección opuesta para volver
+    const uint8_t opuesta[4] = {FLUJO_ABAJO, FLUJO_ARRIBA, FLUJO_DERECHA, FLUJO_IZQUIERDA};
+
+    for (size_t frente = 0; frente < cola.size(); frente++) {
+        uint32_t actual = cola[frente];
+        int fila = actual / columnas;
+        int columna = actual % columnas;
+        estadisticas.extraccionesCola++;
+        estadisticas.nodosExpandidos++;
+
+        for (int d = 0; d < 4; d++) {
+            int nuevaFila = fila + DESPLAZAMIENTO_FLUJO[d][0];
+            int nuevaColumna = columna + DESPLAZAMIENTO_FLUJO[d][1];
+            if (nuevaFila < 0 || nuevaFila >= filas || nuevaColumna < 0 || nuevaColumna >= columnas) continue;
+            uint32_t vecino = (uint32_t)(nuevaFila * columnas + nuevaColumna);
+            if (campo.distancia[vecino] != DISTANCIA_INFINITA || obtenerCelda(nuevaFila, nuevaColumna).estado == BLOQUEADO) continue;
+            campo.distancia[vecino] = campo.distancia[actual] + 1;
+            campo.direccion[vecino] = opuesta[d];
+            cola.push_back(vecino);
+            estadisticas.nodosGenerados++;
+            estadisticas.insercionesCola++;
+        }
+        estadisticas.registrarFrontera(cola.size() - frente - 1);
+    }
+
+    estadisticas.bytesAuxiliares = memoria.bytesPico();
+    estadisticas.bytesVivos = memoria.bytesVivos();
+    estadisticas.asignaciones = memoria.asignaciones();
+}
+
+// Método que marca como ruta el camino que sigue un agente desde el origen por el campo de flujo
+bool Grid::seguirCampoFlujo(Celda& origen, const CampoFlujo& campo) {
+    reiniciar(); // Borramos la ruta anterior
+    if (!campo.alcanzable(origen.fila, origen.columna)) {
+        estadisticas.longitudRuta = 0;
+        return false;
+    }
+
+    // Cada paso es una consulta O(1) a la dirección de la celda actual
+    int fila = origen.fila;
+    int columna = origen.columna;
+    size_t pasos = 0;
+    while (campo.siguientePaso(fila, columna)) {
+        Celda& celda = obtenerCelda(fila, columna);
+        if (celda.estado != ORIGEN && celda.estado != DESTINO) {
+            celda.estado = RUTA;
+        }
+        pasos++;
+    }
+    estadisticas.longitudRuta = pasos;
+    return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Distancia de las celdas que no pueden alcanzar el destino
+const uint32_t DISTANCIA_INFINITA = UINT32_MAX;
+
+// Códigos de dirección del campo de flujo (hacia dónde moverse para acercarse al destino)
+const uint8_t FLUJO_ARRIBA = 0;
+const uint8_t FLUJO_ABAJO = 1;
+const uint8_t FLUJO_IZQUIERDA = 2;
+const uint8_t FLUJO_DERECHA = 3;
+const uint8_t FLUJO_META = 4;      // La celda es el destino
+const uint8_t FLUJO_NINGUNO = 255; // La celda no puede alcanzar el destino
+
+// Desplazamiento (fila, columna) de cada código de dirección
+const int DESPLAZAMIENTO_FLUJO[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+
+// Estructura con el campo de distancias y direcciones hacia un destino común.
+// Se calcula una sola vez y cada agente avanza en O(1) por paso sin ejecutar su propia búsqueda.
+struct CampoFlujo {
+    int filas = 0;
+    int columnas = 0;
+    int filaDestino = -1;
+    int columnaDestino = -1;
+    std::vector<uint32_t> distancia; // Pasos hasta el destino de cada celda (por filas)
+    std::vector<uint8_t> direccion;  // Código de dirección de cada celda (por filas)
+
+    // Método que indica si desde la celda se puede llegar al destino
+    bool alcanzable(int fila, int columna) const {
+        return direccion[(size_t)fila * columnas + columna] != FLUJO_NINGUNO;
+    }
+
+    // Método que devuelve los pasos que faltan desde la celda hasta el destino
+    uint32_t distanciaDesde(int fila, int columna) const {
+        return distancia[(size_t)fila * columnas + columna];
+    }
+
+    // Método que avanza una posición un paso hacia el destino; devuelve false si ya está en él o no hay ruta
+    bool siguientePaso(int& fila, int& columna) const {
+        uint8_t codigo = direccion[(size_t)fila * columnas + columna];
+        if (codigo >= FLUJO_META) return false;
+        fila += DESPLAZAMIENTO_FLUJO[codigo][0];
+        columna += DESPLAZAMIENTO_FLUJO[codigo][1];
+        return true;
+    }
+};
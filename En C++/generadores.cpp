@@ -0,0 +1,276 @@
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include "entidades.h"
+
+// Mínimo de celdas que procesa cada hilo para que compense crearlo
+const int CELDAS_POR_HILO = 1 << 16;
+
+// Función de mezcla splitmix64: convierte un entero en un valor pseudoaleatorio bien distribuido
+static uint64_t mezclar(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Función que convierte 64 bits aleatorios en un número real en [0, 1)
+static double aUnidad(uint64_t x) {
+    return (x >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Función que reparte las filas de la grilla entre varios hilos.
+// El resultado no depende del número de hilos porque cada celda usa su propio valor aleatorio.
+static void paraleloPorFilas(int filas, int columnas, const std::function<void(int, int)>& tarea) {
+    unsigned hilos = std::max(1u, std::thread::hardware_concurrency());
+    long long celdas = (long long)filas * columnas;
+    hilos = (unsigned)std::min<long long>(hilos, std::max(1LL, celdas / CELDAS_POR_HILO));
+    if (hilos <= 1) {
+        tarea(0, filas);
+        return;
+    }
+    std::vector<std::thread> trabajadores;
+    int filasPorHilo = (filas + hilos - 1) / hilos;
+    for (unsigned k = 0; k < hilos; k++) {
+        int desde = k * filasPorHilo;
+        int hasta = std::min(filas, desde + filasPorHilo);
+        if (desde >= hasta) break;
+        trabajadores.emplace_back(tarea, desde, hasta);
+    }
+    for (std::thread& trabajador : trabajadores) {
+        trabajador.join();
+    }
+}
+
+// Generador de obstáculos aleatorios con la densidad indicada (0 a 1)
+void Grid::generarObstaculosAleatorios(double densidad, uint64_t semilla) {
+    reiniciar(true, true);
+    paraleloPorFilas(filas, columnas, [&](int desde, int hasta) {
+        for (int i = desde; i < hasta; i++) {
+            for (int j = 0; j < columnas; j++) {
+                uint64_t indice = (uint64_t)i * columnas + j;
+                if (aUnidad(mezclar(semilla ^ mezclar(indice))) < densidad) {
+                    obtenerCelda(i, j).estado = BLOQUEADO;
+                }
+            }
+        }
+    });
+}
+
+// Región rectangular (límites inclusivos) pendiente de dividir en el laberinto
+struct RegionLaberinto {
+    int arriba, izquierda, abajo, derecha;
+    uint64_t semilla;
+};
+
+// Función que levanta una pared con una puerta dentro de la región y devuelve las dos subregiones.
+// Las paredes van en filas/columnas impares y las puertas en posiciones pares, así las subregiones no se tocan.
+static bool partirRegion(Grid& grid, const RegionLaberinto& region,
+                         RegionLaberinto& primera, RegionLaberinto& segunda) {
+    int alto = region.abajo - region.arriba + 1;
+    int ancho = region.derecha - region.izquierda + 1;
+    if (alto < 3 || ancho < 3) return false;
+
+    uint64_t aleatorio = mezclar(region.semilla);
+    bool horizontal = alto > ancho || (alto == ancho && (aleatorio & 1));
+    uint64_t posicion = aleatorio >> 1;
+    uint64_t puerta = mezclar(aleatorio);
+
+    if (horizontal) {
+        int pared = region.arriba + 1 + 2 * (int)(posicion % ((region.abajo - region.arriba) / 2));
+        int hueco = region.izquierda + 2 * (int)(puerta % ((region.derecha - region.izquierda) / 2 + 1));
+        for (int j = region.izquierda; j <= region.derecha; j++) {
+            if (j != hueco) grid.obtenerCelda(pared, j).estado = BLOQUEADO;
+        }
+        primera = {region.arriba, region.izquierda, pared - 1, region.derecha, mezclar(region.semilla * 2 + 1)};
+        segunda = {pared + 1, region.izquierda, region.abajo, region.derecha, mezclar(region.semilla * 2 + 2)};
+    } else {
+        int pared = region.izquierda + 1 + 2 * (int)(posicion % ((region.derecha - region.izquierda) / 2));
+        int hueco = region.arriba + 2 * (int)(puerta % ((region.abajo - region.arriba) / 2 + 1));
+        for (int i = region.arriba; i <= region.abajo; i++) {
+            if (i != hueco) grid.obtenerCelda(i, pared).estado = BLOQUEADO;
+        }
+        primera = {region.arriba, region.izquierda, region.abajo, pared - 1, mezclar(region.semilla * 2 + 1)};
+        segunda = {region.arriba, pared + 1, region.abajo, region.derecha, mezclar(region.semilla * 2 + 2)};
+    }
+    return true;
+}
+
+// Función que divide una región completa con una pila explícita (sin recursión profunda)
+static void dividirRegion(Grid& grid, const RegionLaberinto& inicial) {
+    std::vector<RegionLaberinto> pila = {inicial};
+    while (!pila.empty()) {
+        RegionLaberinto region = pila.back();
+        pila.pop_back();
+        RegionLaberinto primera, segunda;
+        if (partirRegion(grid, region, primera, segunda)) {
+            pila.push_back(primera);
+            pila.push_back(segunda);
+        }
+    }
+}
+
+// Función que reparte las primeras divisiones entre hilos; las subregiones son disjuntas
+static void dividirParalelo(Grid& grid, const RegionLaberinto& region, int niveles) {
+    long long area = (long long)(region.abajo - region.arriba + 1) * (region.derecha - region.izquierda + 1);
+    if (niveles <= 0 || area < CELDAS_POR_HILO) {
+        dividirRegion(grid, region);
+        return;
+    }
+    RegionLaberinto primera, segunda;
+    if (!partirRegion(grid, region, primera, segunda)) return;
+    std::thread hilo(dividirParalelo, std::ref(grid), primera, niveles - 1);
+    dividirParalelo(grid, segunda, niveles - 1);
+    hilo.join();
+}
+
+// Generador de laberinto perfecto por división recursiva
+void Grid::generarLaberinto(uint64_t semilla) {
+    reiniciar(true, true);
+    int niveles = 0;
+    while ((1u << niveles) < std::thread::hardware_concurrency()) niveles++;
+    dividirParalelo(*this, {0, 0, filas - 1, columnas - 1, mezclar(semilla)}, niveles);
+}
+
+// Hoja del árbol BSP que contendrá una habitación
+struct HojaHabitacion {
+    int arriba, izquierda, alto, ancho;
+};
+
+// Función que parte el espacio en hojas con un árbol BSP (el orden de las hojas sigue el árbol)
+static void partirEspacio(const HojaHabitacion& hoja, uint64_t semilla, int minimo, std::vector<HojaHabitacion>& hojas) {
+    uint64_t aleatorio = mezclar(semilla);
+    bool porFilas = hoja.alto > hoja.ancho || (hoja.alto == hoja.ancho && (aleatorio & 1));
+    int lado = porFilas ? hoja.alto : hoja.ancho;
+    if (lado < 2 * minimo) {
+        hojas.push_back(hoja);
+        return;
+    }
+    // Cortamos entre el 30 % y el 70 % del lado
+    int corte = lado * 3 / 10 + (int)((aleatorio >> 1) % (uint64_t)std::max(1, lado * 4 / 10));
+    corte = std::max(minimo, std::min(lado - minimo, corte));
+    HojaHabitacion primera = hoja, segunda = hoja;
+    if (porFilas) {
+        primera.alto = corte;
+        segunda.arriba += corte;
+        segunda.alto -= corte;
+    } else {
+        primera.ancho = corte;
+        segunda.izquierda += corte;
+        segunda.ancho -= corte;
+    }
+    partirEspacio(primera, semilla * 2 + 1, minimo, hojas);
+    partirEspacio(segunda, semilla * 2 + 2, minimo, hojas);
+}
+
+// Generador de habitaciones rectangulares unidas por pasillos
+void Grid::generarHabitaciones(uint64_t semilla) {
+    reiniciar(true, true);
+    paraleloPorFilas(filas, columnas, [&](int desde, int hasta) {
+        for (int i = desde; i < hasta; i++) {
+            for (int j = 0; j < columnas; j++) {
+                obtenerCelda(i, j).estado = BLOQUEADO;
+            }
+        }
+    });
+
+    const int minimo = 8; // Lado mínimo de cada hoja del BSP
+    std::vector<HojaHabitacion> hojas;
+    partirEspacio({0, 0, filas, columnas}, mezclar(semilla), minimo, hojas);
+
+    // Tallamos una habitación dentro de cada hoja y la unimos con la anterior por un pasillo en L
+    int previaFila = -1, previaColumna = -1;
+    for (size_t k = 0; k < hojas.size(); k++) {
+        const HojaHabitacion& hoja = hojas[k];
+        uint64_t aleatorio = mezclar(semilla ^ mezclar(k + 1));
+        int alto = std::max(1, hoja.alto - 2 - (int)(aleatorio % (uint64_t)std::max(1, hoja.alto / 2)));
+        int ancho = std::max(1, hoja.ancho - 2 - (int)((aleatorio >> 16) % (uint64_t)std::max(1, hoja.ancho / 2)));
+        int arriba = hoja.arriba + 1 + (int)((aleatorio >> 32) % (uint64_t)std::max(1, hoja.alto - alto - 1));
+        int izquierda = hoja.izquierda + 1 + (int)((aleatorio >> 48) % (uint64_t)std::max(1, hoja.ancho - ancho - 1));
+        arriba = std::min(arriba, filas - 1);
+        izquierda = std::min(izquierda, columnas - 1);
+        for (int i = arriba; i < std::min(filas, arriba + alto); i++) {
+            for (int j = izquierda; j < std::min(columnas, izquierda + ancho); j++) {
+                obtenerCelda(i, j).estado = VACIO;
+            }
+        }
+
+        int centroFila = std::min(filas - 1, arriba + alto / 2);
+        int centroColumna = std::min(columnas - 1, izquierda + ancho / 2);
+        if (previaFila >= 0) {
+            for (int j = std::min(previaColumna, centroColumna); j <= std::max(previaColumna, centroColumna); j++) {
+                obtenerCelda(previaFila, j).estado = VACIO;
+            }
+            for (int i = std::min(previaFila, centroFila); i <= std::max(previaFila, centroFila); i++) {
+                obtenerCelda(i, centroColumna).estado = VACIO;
+            }
+        }
+        previaFila = centroFila;
+        previaColumna = centroColumna;
+    }
+}
+
+// Función de suavizado de Perlin (6t^5 - 15t^4 + 10t^3)
+static double suavizar(double t) {
+    return t * t * t * (t * (t * 6 - 15) + 10);
+}
+
+// Función que calcula el producto del gradiente de la esquina por el vector hasta el punto
+static double gradiente(int hash, double x, double y) {
+    switch (hash & 7) {
+        case 0: return x + y;
+        case 1: return -x + y;
+        case 2: return x - y;
+        case 3: return -x - y;
+        case 4: return x;
+        case 5: return -x;
+        case 6: return y;
+        default: return -y;
+    }
+}
+
+// Función de ruido de Perlin en 2D con la tabla de permutación indicada (valores aproximadamente en [-1, 1])
+static double ruidoPerlin(const std::vector<int>& permutacion, double x, double y) {
+    int xi = (int)std::floor(x) & 255, yi = (int)std::floor(y) & 255;
+    double xf = x - std::floor(x), yf = y - std::floor(y);
+    double u = suavizar(xf), v = suavizar(yf);
+    int aa = permutacion[permutacion[xi] + yi], ab = permutacion[permutacion[xi] + yi + 1];
+    int ba = permutacion[permutacion[xi + 1] + yi], bb = permutacion[permutacion[xi + 1] + yi + 1];
+    double x1 = gradiente(aa, xf, yf) + u * (gradiente(ba, xf - 1, yf) - gradiente(aa, xf, yf));
+    double x2 = gradiente(ab, xf, yf - 1) + u * (gradiente(bb, xf - 1, yf - 1) - gradiente(ab, xf, yf - 1));
+    return x1 + v * (x2 - x1);
+}
+
+// Generador de terreno por ruido de Perlin: se bloquean las celdas cuyo ruido supera el umbral
+void Grid::generarTerrenoPerlin(double escala, double umbral, uint64_t semilla) {
+    reiniciar(true, true);
+
+    // Tabla de permutación barajada con la semilla (duplicada para evitar el módulo)
+    std::vector<int> permutacion(512);
+    for (int k = 0; k < 256; k++) permutacion[k] = k;
+    uint64_t estado = semilla;
+    for (int k = 255; k > 0; k--) {
+        estado = mezclar(estado);
+        std::swap(permutacion[k], permutacion[estado % (k + 1)]);
+    }
+    for (int k = 0; k < 256; k++) permutacion[256 + k] = permutacion[k];
+
+    const int octavas = 4;
+    paraleloPorFilas(filas, columnas, [&](int desde, int hasta) {
+        for (int i = desde; i < hasta; i++) {
+            for (int j = 0; j < columnas; j++) {
+                // Ruido fractal: suma de octavas con frecuencia doble y amplitud mitad
+                double valor = 0, amplitud = 1, frecuencia = 1.0 / escala, total = 0;
+                for (int o = 0; o < octavas; o++) {
+                    valor += amplitud * ruidoPerlin(permutacion, j * frecuencia, i * frecuencia);
+                    total += amplitud;
+                    amplitud *= 0.5;
+                    frecuencia *= 2;
+                }
+                if (valor / total > umbral) {
+                    obtenerCelda(i, j).estado = BLOQUEADO;
+                }
+            }
+        }
+    });
+}
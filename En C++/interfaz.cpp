@@ -0,0 +1,78 @@
+#include "interfaz.h"
+
+// Fuente personalizada para dibujar texto
+Font fuentePersonalizada;
+
+// Método para dibujar la grilla de celdas en la pantalla
+void Grid::dibujarGrilla() const {
+    Color celesteClaro = Color{184, 237, 255, 255}; // Color de las celdas vacías
+    for (int i = 0; i < filas; i++) {
+        for (int j = 0; j < columnas; j++) {
+            const Celda& celda = celdas[disposicion.posicion(i, j)];
+            Color color; // Variable para almacenar el color de la celda
+            // Asignar un color dependiendo del estado de la celda
+            switch (celda.estado) {
+                case VACIO: color = celesteClaro; break;
+                case BLOQUEADO: color = RED; break;
+                case ORIGEN: color = GREEN; break;
+                case DESTINO: color = YELLOW; break;
+                case RUTA: color = BLUE; break;
+                default: color = celesteClaro; break;
+            }
+            // Posición de la celda en la pantalla
+            Vector2 posicion = { (float)(j * CELDA_TAM), (float)(i * CELDA_TAM + INSTRUCCIONES_ALTURA) };
+            // Dibujar el rectángulo representando la celda
+            DrawRectangleV(posicion, {CELDA_TAM, CELDA_TAM}, color);
+            // Dibujar el borde de la celda en color negro
+            DrawRectangleLinesEx({posicion.x, posicion.y, (float)CELDA_TAM, (float)CELDA_TAM}, 0.5, BLACK);
+
+            // Si la celda es origen o destino, dibujamos el texto "O" o "D"
+            if (celda.estado == ORIGEN || celda.estado == DESTINO) {
+                const char* texto = (celda.estado == ORIGEN) ? "O" : "D"; // Determinamos qué texto mostrar
+                Vector2 size = MeasureTextEx(fuentePersonalizada, texto, 20, 0); // Medimos el tamaño del texto
+
+                // Centramos el texto en la celda
+                float posX = posicion.x + (CELDA_TAM - size.x) / 2;  // Centrado horizontal
+                float posY = posicion.y + (CELDA_TAM - size.y) / 2;  // Centrado vertical
+
+                // Dibujamos el texto en la celda
+                DrawTextEx(fuentePersonalizada, texto, { posX, posY }, 20, 0, BLACK);
+            }
+        }
+    }
+}
+
+// Función para dibujar las instrucciones en pantalla
+void dibujarInstrucciones(bool modoEdicion) {
+    const char* instrucciones = 
+        "INSTRUCCIONES:\n\n"
+        "1. Presiona CTRL para activar/desactivar el modo edicion.\n"
+        "2. En modo edicion, Clic Izquierdo bloquea casillas (rojo).\n"
+        "3. En modo edicion, Clic Derecho desbloquea casillas (celeste claro).\n"
+        "4. Presiona Clic Izquierdo para seleccionar origen (verde) y destino (amarillo).\n"
+        "5. Presiona ENTER para buscar ruta (BFS) entre origen y destino.\n"
+        "6. Presiona ESPACIO para buscar ruta (D* Lite) entre origen y destino.\n"
+        "7. Presiona ESC para reiniciar la grilla a su estado inicial.\n"
+        "8. Teclas 1-4: generar mapa (aleatorio, laberinto, habitaciones, Perlin).\n"
+        "9. F (flujo), G (subobjetivos), H (jerarquia) o C (base de caminos): buscar ruta.";
+
+    // Fondo de las instrucciones (color azul oscuro)
+    DrawRectangle(0, 0, GetScreenWidth(), INSTRUCCIONES_ALTURA, Color{30, 42, 71, 255});
+
+    // Centrar "Buscador de Rutas" en la parte superior de la pantalla
+    const char* titulo = "Buscador de Rutas";
+    int anchoTexto = MeasureText(titulo, 30);
+    int posicionX = (GetScreenWidth() - anchoTexto) / 2;
+    DrawTextEx(fuentePersonalizada, titulo, { (float)posicionX, 20 }, 30, 0, Color{240, 240, 240, 255});  // Título en color blanco
+
+    int posicionInstruccionesY = 60; // Distancia entre el título y las instrucciones
+    DrawTextEx(fuentePersonalizada, instrucciones, {10.0f, (float)posicionInstruccionesY}, 20, 0, Color{190, 190, 190, 255});  // Instrucciones en color gris claro
+
+    // Si estamos en modo edición, mostrar un mensaje adicional
+    if (modoEdicion) {
+        const char* mensajeModoEdicion = "Modo Edicion Activado! Presiona CTRL para desactivar";
+        int anchoMensaje = MeasureText(mensajeModoEdicion, 20);
+        int posicionXMensaje = (GetScreenWidth() - anchoMensaje) / 2;
+        DrawTextEx(fuentePersonalizada, mensajeModoEdicion, { (float)posicionXMensaje, (float)(INSTRUCCIONES_ALTURA - 30) }, 20, 0, Color{255, 0, 0, 255});  // Aviso en color rojo brillante
+    }
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "raylib.h" // Biblioteca para la interfaz gráfica (GUI)
+#include "entidades.h"
+
+// Fuente personalizada para dibujar texto
+extern Font fuentePersonalizada;
+
+// Función que dibuja las instrucciones en pantalla
+void dibujarInstrucciones(bool modoEdicion);
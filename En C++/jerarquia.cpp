@@ -0,0 +1,529 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <thread>
+#include "entidades.h"
+#include "jerarquia.h"
+
+// Nodos que puede asentar como máximo una búsqueda de testigos (limitarla solo añade atajos de más);
+// para estimar la prioridad basta una búsqueda más corta
+const int LIMITE_TESTIGOS = 500;
+const int LIMITE_SIMULACION = 50;
+// Identificador de los archivos de jerarquía y versión de su formato
+const char FIRMA_JERARQUIA[4] = {'P', 'F', 'C', 'H'};
+const uint32_t FORMATO_JERARQUIA = 1;
+
+// Atajo que hay que añadir al contraer un nodo
+struct AtajoPendiente {
+    int desde;
+    int hasta;
+    uint32_t peso;
+    int medio;
+};
+
+// Memoria de trabajo de una búsqueda de testigos (una por hilo)
+struct BusquedaTestigos {
+    std::vector<uint32_t> distancia;
+    std::vector<char> objetivo; // Vecinos de v cuya distancia aún se busca
+    std::vector<int> tocados;
+};
+
+typedef std::pair<uint32_t, int> EntradaDistancia; // (distancia, nodo)
+typedef std::priority_queue<EntradaDistancia, std::vector<EntradaDistancia>, std::greater<EntradaDistancia>> ColaDistancias;
+
+// Grafo de los nodos que aún no se han contraído, con su prioridad de contracción
+struct GrafoContraccion {
+    std::vector<std::vector<AristaJerarquia>> activas; // Aristas entre nodos no contraídos
+    std::vector<int> vecinosContraidos;                // Vecinos ya contraídos de cada nodo
+    std::vector<int> prioridad;
+
+    // Método que calcula los atajos necesarios para contraer v: para cada par de vecinos (u, w),
+    // si no hay un camino testigo sin v tan corto como u-v-w, hace falta el atajo u-w.
+    // Los testigos tampoco pueden pasar por los nodos excluidos (los que se contraen en la misma ronda:
+    // si dos nodos se sirvieran de testigo el uno al otro, al contraer ambos se perdería la distancia)
+    void atajosNecesarios(int v, BusquedaTestigos& busqueda, std::vector<AtajoPendiente>& atajos,
+                          int limiteAsentados, const std::vector<char>* excluidos = nullptr) const {
+        atajos.clear();
+        const std::vector<AristaJerarquia>& vecinos = activas[v];
+
+        for (size_t a = 0; a + 1 < vecinos.size(); a++) {
+            int u = vecinos[a].destino;
+            // Los pares (u, w) con w posterior a u: la búsqueda termina al asentarlos todos
+            uint32_t pesoMaximo = 0;
+            int pendientes = 0;
+            for (size_t b = a + 1; b < vecinos.size(); b++) {
+                pesoMaximo = std::max(pesoMaximo, vecinos[b].peso);
+                busqueda.objetivo[vecinos[b].destino] = 1;
+                pendientes++;
+            }
+            uint32_t limite = vecinos[a].peso + pesoMaximo;
+
+            // Dijkstra acotado desde u que no atraviesa v
+            ColaDistancias cola;
+            busqueda.distancia[u] = 0;
+            busqueda.tocados.push_back(u);
+            cola.push({0, u});
+            int asentados = 0;
+            while (!cola.empty() && asentados < limiteAsentados && pendientes > 0) {
+                EntradaDistancia entrada = cola.top();
+                cola.pop();
+                if (entrada.first != busqueda.distancia[entrada.second]) continue;
+                if (entrada.first > limite) break;
+                asentados++;
+                if (busqueda.objetivo[entrada.second]) pendientes--;
+                for (const AristaJerarquia& arista : activas[entrada.second]) {
+                    if (arista.destino == v || (excluidos && (*excluidos)[arista.destino])) continue;
+                    uint32_t nueva = entrada.first + arista.peso;
+                    if (nueva < busqueda.distancia[arista.destino]) {
+                        if (busqueda.distancia[arista.destino] == UINT32_MAX) busqueda.tocados.push_back(arista.destino);
+                        busqueda.distancia[arista.destino] = nueva;
+                        cola.push({nueva, arista.destino});
+                    }
+                }
+            }
+
+            for (size_t b = a + 1; b < vecinos.size(); b++) {
+                uint32_t porV = vecinos[a].peso + vecinos[b].peso;
+                if (busqueda.distancia[vecinos[b].destino] > porV) {
+                    atajos.push_back({u, vecinos[b].destino, porV, v});
+                }
+                busqueda.objetivo[vecinos[b].destino] = 0;
+            }
+            for (int nodo : busqueda.tocados) busqueda.distancia[nodo] = UINT32_MAX;
+            busqueda.tocados.clear();
+        }
+    }
+
+    // Método que calcula la prioridad de un nodo: diferencia de aristas más vecinos ya contraídos
+    // (los nodos que añaden pocos atajos y están en zonas poco contraídas van primero)
+    int calcularPrioridad(int v, BusquedaTestigos& busqueda, std::vector<AtajoPendiente>& atajos) const {
+        atajosNecesarios(v, busqueda, atajos, LIMITE_SIMULACION);
+        return (int)atajos.size() - (int)activas[v].size() + vecinosContraidos[v];
+    }
+
+    // Método que añade la arista u-w o la acorta si ya existía con más peso
+    void agregarArista(int u, int w, uint32_t peso, int medio) {
+        for (AristaJerarquia& arista : activas[u]) {
+            if (arista.destino == w) {
+                if (peso < arista.peso) {
+                    arista.peso = peso;
+                    arista.medio = medio;
+                }
+                return;
+            }
+        }
+        activas[u].push_back({w, peso, medio});
+    }
+};
+
+// Función que reparte las tareas [0, n) entre hilos; cada hilo recibe su número para usar su memoria de trabajo
+static void paraleloTareas(size_t n, unsigned hilos, const std::function<void(size_t, size_t, unsigned)>& tarea) {
+    hilos = (unsigned)std::min<size_t>(hilos, std::max<size_t>(1, n / 64));
+    if (hilos <= 1) {
+        tarea(0, n, 0);
+        return;
+    }
+    std::vector<std::thread> trabajadores;
+    size_t porHilo = (n + hilos - 1) / hilos;
+    for (unsigned k = 0; k < hilos; k++) {
+        size_t desde = k * porHilo;
+        size_t hasta = std::min(n, desde + porHilo);
+        if (desde >= hasta) break;
+        trabajadores.emplace_back(tarea, desde, hasta, k);
+    }
+    for (std::thread& trabajador : trabajadores) {
+        trabajador.join();
+    }
+}
+
+// Método que construye la jerarquía a partir de las celdas libres de la grilla
+void JerarquiaContraccion::construir(const Grid& grid) {
+    filas = grid.obtenerFilas();
+    columnas = grid.obtenerColumnas();
+    nodoCelda.assign((size_t)filas * columnas, -1);
+    celdaNodo.clear();
+    for (int i = 0; i < filas; i++) {
+        for (int j = 0; j < columnas; j++) {
+            if (grid.obtenerCelda(i, j).estado != BLOQUEADO) {
+                nodoCelda[(size_t)i * columnas + j] = (int)celdaNodo.size();
+                celdaNodo.push_back(i * columnas + j);
+            }
+        }
+    }
+    size_t n = celdaNodo.size();
+
+    // Grafo inicial: aristas de peso 1 entre celdas libres vecinas
+    GrafoContraccion grafo;
+    grafo.activas.assign(n, {});
+    grafo.vecinosContraidos.assign(n, 0);
+    grafo.prioridad.assign(n, 0);
+    const int desplazamiento[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    for (size_t v = 0; v < n; v++) {
+        int fila = celdaNodo[v] / columnas;
+        int columna = celdaNodo[v] % columnas;
+        for (const auto& d : desplazamiento) {
+            int nuevaFila = fila + d[0];
+            int nuevaColumna = columna + d[1];
+            if (nuevaFila < 0 || nuevaFila >= filas || nuevaColumna < 0 || nuevaColumna >= columnas) continue;
+            int vecino = nodoCelda[(size_t)nuevaFila * columnas + nuevaColumna];
+            if (vecino >= 0) grafo.activas[v].push_back({vecino, 1, -1});
+        }
+    }
+
+    unsigned hilos = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<BusquedaTestigos> busquedas(hilos);
+    for (BusquedaTestigos& busqueda : busquedas) {
+        busqueda.distancia.assign(n, UINT32_MAX);
+        busqueda.objetivo.assign(n, 0);
+    }
+    std::vector<std::vector<AtajoPendiente>> temporales(hilos);
+
+    // Prioridades iniciales
+    paraleloTareas(n, hilos, [&](size_t desde, size_t hasta, unsigned hilo) {
+        for (size_t v = desde; v < hasta; v++) {
+            grafo.prioridad[v] = grafo.calcularPrioridad((int)v, busquedas[hilo], temporales[hilo]);
+        }
+    });
+
+    std::vector<int> activos(n);
+    for (size_t v = 0; v < n; v++) activos[v] = (int)v;
+    std::vector<char> contraido(n, 0);
+    std::vector<char> enRonda(n, 0); // Nodos que se contraen en la ronda actual
+    std::vector<std::vector<AristaJerarquia>> subidas(n);
+    nivel.assign(n, -1);
+    atajos = 0;
+    int siguienteNivel = 0;
+
+    while (!activos.empty()) {
+        // Conjunto independiente: nodos con prioridad menor que la de todos sus vecinos activos
+        std::vector<int> seleccion;
+        for (int v : activos) {
+            bool minimo = true;
+            for (const AristaJerarquia& arista : grafo.activas[v]) {
+                int u = arista.destino;
+                if (grafo.prioridad[u] < grafo.prioridad[v] || (grafo.prioridad[u] == grafo.prioridad[v] && u < v)) {
+                    minimo = false;
+                    break;
+                }
+            }
+            if (minimo) seleccion.push_back(v);
+        }
+
+        // Atajos de cada nodo seleccionado (los nodos no son vecinos, así que se calculan en paralelo)
+        for (int v : seleccion) enRonda[v] = 1;
+        std::vector<std::vector<AtajoPendiente>> atajosSeleccion(seleccion.size());
+        paraleloTareas(seleccion.size(), hilos, [&](size_t desde, size_t hasta, unsigned hilo) {
+            for (size_t k = desde; k < hasta; k++) {
+                grafo.atajosNecesarios(seleccion[k], busquedas[hilo], atajosSeleccion[k], LIMITE_TESTIGOS, &enRonda);
+            }
+        });
+        for (int v : seleccion) enRonda[v] = 0;
+
+        // Contracción: las aristas restantes del nodo suben a vecinos de nivel mayor
+        std::vector<int> afectados;
+        for (size_t k = 0; k < seleccion.size(); k++) {
+            int v = seleccion[k];
+            nivel[v] = siguienteNivel++;
+            contraido[v] = 1;
+            subidas[v] = std::move(grafo.activas[v]);
+            grafo.activas[v].clear();
+            for (const AristaJerarquia& arista : subidas[v]) {
+                std::vector<AristaJerarquia>& lista = grafo.activas[arista.destino];
+                lista.erase(std::remove_if(lista.begin(), lista.end(),
+                                           [v](const AristaJerarquia& a) { return a.destino == v; }),
+                            lista.end());
+                grafo.vecinosContraidos[arista.destino]++;
+                afectados.push_back(arista.destino);
+            }
+            for (const AtajoPendiente& atajo : atajosSeleccion[k]) {
+                grafo.agregarArista(atajo.desde, atajo.hasta, atajo.peso, atajo.medio);
+                grafo.agregarArista(atajo.hasta, atajo.desde, atajo.peso, atajo.medio);
+            }
+            atajos += atajosSeleccion[k].size();
+        }
+
+        // Las prioridades de los vecinos cambian: se recalculan en paralelo
+        std::sort(afectados.begin(), afectados.end());
+        afectados.erase(std::unique(afectados.begin(), afectados.end()), afectados.end());
+        paraleloTareas(afectados.size(), hilos, [&](size_t desde, size_t hasta, unsigned hilo) {
+            for (size_t k = desde; k < hasta; k++) {
+                grafo.prioridad[afectados[k]] = grafo.calcularPrioridad(afectados[k], busquedas[hilo], temporales[hilo]);
+            }
+        });
+
+        activos.erase(std::remove_if(activos.begin(), activos.end(), [&](int v) { return contraido[v]; }), activos.end());
+    }
+
+    // Aristas hacia arriba en formato CSR para que la consulta las recorra de forma contigua
+    inicioSubida.assign(n + 1, 0);
+    for (size_t v = 0; v < n; v++) inicioSubida[v + 1] = inicioSubida[v] + (uint32_t)subidas[v].size();
+    subida.clear();
+    subida.reserve(inicioSubida[n]);
+    for (size_t v = 0; v < n; v++) {
+        subida.insert(subida.end(), subidas[v].begin(), subidas[v].end());
+    }
+
+    huella = huellaMapa(grid);
+    version = grid.obtenerVersion();
+    construida = true;
+}
+
+// Método que guarda la jerarquía en un archivo binario (en el orden de bytes de la máquina)
+bool JerarquiaContraccion::guardar(const std::string& archivo) const {
+    if (!construida) return false; // Sin jerarquía no se abre (ni se trunca) el archivo
+    std::ofstream salida(archivo, std::ios::binary);
+    if (!salida) return false;
+    uint64_t nodos = celdaNodo.size();
+    uint64_t aristas = subida.size();
+    uint64_t totalAtajos = atajos;
+    salida.write(FIRMA_JERARQUIA, sizeof(FIRMA_JERARQUIA));
+    salida.write((const char*)&FORMATO_JERARQUIA, sizeof(FORMATO_JERARQUIA));
+    salida.write((const char*)&filas, sizeof(filas));
+    salida.write((const char*)&columnas, sizeof(columnas));
+    salida.write((const char*)&huella, sizeof(huella));
+    salida.write((const char*)&totalAtajos, sizeof(totalAtajos));
+    salida.write((const char*)&nodos, sizeof(nodos));
+    salida.write((const char*)&aristas, sizeof(aristas));
+    salida.write((const char*)celdaNodo.data(), nodos * sizeof(int));
+    salida.write((const char*)nivel.data(), nodos * sizeof(int));
+    salida.write((const char*)inicioSubida.data(), (nodos + 1) * sizeof(uint32_t));
+    salida.write((const char*)subida.data(), aristas * sizeof(AristaJerarquia));
+    return (bool)salida;
+}
+
+// Método que carga una jerarquía de un archivo binario y comprueba que corresponde a la grilla; los índices
+// de nodos, celdas y aristas se validan antes de usarlos, así que un archivo dañado se rechaza
+bool JerarquiaContraccion::cargar(const std::string& archivo, const Grid& grid) {
+    std::ifstream entrada(archivo, std::ios::binary);
+    if (!entrada) return false;
+    char firma[4];
+    uint32_t formato = 0;
+    int filasArchivo = 0, columnasArchivo = 0;
+    uint64_t huellaArchivo = 0, totalAtajos = 0, nodos = 0, aristas = 0;
+    entrada.read(firma, sizeof(firma));
+    entrada.read((char*)&formato, sizeof(formato));
+    entrada.read((char*)&filasArchivo, sizeof(filasArchivo));
+    entrada.read((char*)&columnasArchivo, sizeof(columnasArchivo));
+    entrada.read((char*)&huellaArchivo, sizeof(huellaArchivo));
+    entrada.read((char*)&totalAtajos, sizeof(totalAtajos));
+    entrada.read((char*)&nodos, sizeof(nodos));
+    entrada.read((char*)&aristas, sizeof(aristas));
+    if (!entrada || !std::equal(firma, firma + 4, FIRMA_JERARQUIA) || formato != FORMATO_JERARQUIA) return false;
+    if (filasArchivo != grid.obtenerFilas() || columnasArchivo != grid.obtenerColumnas()) return false;
+    if (huellaArchivo != huellaMapa(grid)) return false; // La jerarquía es de otro mapa
+    if (nodos > (uint64_t)filasArchivo * columnasArchivo) return false;
+
+    std::vector<int> celdas(nodos), niveles(nodos);
+    std::vector<uint32_t> inicios(nodos + 1);
+    std::vector<AristaJerarquia> lista(aristas);
+    entrada.read((char*)celdas.data(), nodos * sizeof(int));
+    entrada.read((char*)niveles.data(), nodos * sizeof(int));
+    entrada.read((char*)inicios.data(), (nodos + 1) * sizeof(uint32_t));
+    entrada.read((char*)lista.data(), aristas * sizeof(AristaJerarquia));
+    if (!entrada || inicios[0] != 0 || inicios[nodos] != aristas) return false;
+
+    // Cada nodo corresponde a una celda libre distinta y los niveles son una permutación de los nodos
+    size_t totalCeldas = (size_t)filasArchivo * columnasArchivo;
+    std::vector<int> numeros(totalCeldas, -1);
+    std::vector<bool> nivelUsado(nodos, false);
+    for (size_t v = 0; v < nodos; v++) {
+        if (celdas[v] < 0 || (size_t)celdas[v] >= totalCeldas || numeros[celdas[v]] >= 0) return false;
+        if (grid.obtenerCelda(celdas[v] / columnasArchivo, celdas[v] % columnasArchivo).estado == BLOQUEADO) return false;
+        if (niveles[v] < 0 || (uint64_t)niveles[v] >= nodos || nivelUsado[niveles[v]]) return false;
+        numeros[celdas[v]] = (int)v;
+        nivelUsado[niveles[v]] = true;
+    }
+    // Aristas en formato CSR que solo suben de nivel; el nodo medio de un atajo está por debajo de sus
+    // dos extremos (así desplegarlo siempre termina) y una arista de la grilla une celdas vecinas
+    for (size_t v = 0; v < nodos; v++) {
+        if (inicios[v] > inicios[v + 1]) return false;
+    }
+    for (size_t v = 0; v < nodos; v++) {
+        for (uint32_t k = inicios[v]; k < inicios[v + 1]; k++) {
+            const AristaJerarquia& arista = lista[k];
+            if (arista.destino < 0 || (uint64_t)arista.destino >= nodos || niveles[arista.destino] <= niveles[v]) return false;
+            if (arista.medio >= 0) {
+                if ((uint64_t)arista.medio >= nodos || niveles[arista.medio] >= niveles[v]) return false;
+            } else {
+                int a = celdas[v], b = celdas[arista.destino];
+                int distanciaFilas = std::abs(a / columnasArchivo - b / columnasArchivo);
+                int distanciaColumnas = std::abs(a % columnasArchivo - b % columnasArchivo);
+                if (arista.medio != -1 || distanciaFilas + distanciaColumnas != 1) return false;
+            }
+        }
+    }
+
+    filas = filasArchivo;
+    columnas = columnasArchivo;
+    huella = huellaArchivo;
+    atajos = totalAtajos;
+    celdaNodo = std::move(celdas);
+    nivel = std::move(niveles);
+    inicioSubida = std::move(inicios);
+    subida = std::move(lista);
+    nodoCelda = std::move(numeros);
+    for (int k = 0; k < 2; k++) {
+        distancia[k].clear();
+        marca[k].clear();
+    }
+    version = grid.obtenerVersion();
+    construida = true;
+    return true;
+}
+
+// Método que indica si la jerarquía corresponde a la versión actual del mapa de la grilla
+bool JerarquiaContraccion::sincronizada(const Grid& grid) const {
+    return construida && version == grid.obtenerVersion()
+        && filas == grid.obtenerFilas() && columnas == grid.obtenerColumnas();
+}
+
+// Método que devuelve el nodo contraído de la arista entre dos nodos (el de menor nivel la guarda)
+int JerarquiaContraccion::medioArista(int a, int b) const {
+    int bajo = nivel[a] < nivel[b] ? a : b;
+    int alto = bajo == a ? b : a;
+    for (uint32_t k = inicioSubida[bajo]; k < inicioSubida[bajo + 1]; k++) {
+        if (subida[k].destino == alto) return subida[k].medio;
+    }
+    return -1;
+}
+
+// Método que añade a la ruta los nodos de una arista (sin el primero), desplegando los atajos
+void JerarquiaContraccion::desempaquetar(int desde, int hasta, int medio, std::vector<int>& nodos) const {
+    if (medio < 0) {
+        nodos.push_back(hasta);
+        return;
+    }
+    desempaquetar(desde, medio, medioArista(desde, medio), nodos);
+    desempaquetar(medio, hasta, medioArista(medio, hasta), nodos);
+}
+
+// Función de consulta bidireccional: las dos búsquedas solo suben de nivel y se detienen cuando
+// la menor distancia pendiente no puede mejorar el mejor encuentro
+bool JerarquiaContraccion::consultar(int origen, int destino, std::vector<int>& ruta, EstadisticasBusqueda& medidas) const {
+    ruta.clear();
+    int s = nodoCelda[origen];
+    int t = nodoCelda[destino];
+    if (s < 0 || t < 0) return false;
+
+    size_t n = celdaNodo.size();
+    if (++consultaActual == 0 || marca[0].size() != n) {
+        // Primera consulta (o desbordamiento del contador): se reinicia la memoria de trabajo
+        for (int k = 0; k < 2; k++) {
+            distancia[k].assign(n, UINT32_MAX);
+            padre[k].assign(n, -1);
+            medioPadre[k].assign(n, -1);
+            marca[k].assign(n, 0);
+        }
+        consultaActual = 1;
+    }
+    auto distanciaDe = [&](int lado, int nodo) {
+        return marca[lado][nodo] == consultaActual ? distancia[lado][nodo] : UINT32_MAX;
+    };
+
+    // Colas de la consulta con memoria contabilizada
+    std::priority_queue<EntradaDistancia, std::vector<EntradaDistancia, AsignadorContador<EntradaDistancia>>,
+                        std::greater<EntradaDistancia>> cola[2];
+    const int extremos[2] = {s, t};
+    for (int lado = 0; lado < 2; lado++) {
+        marca[lado][extremos[lado]] = consultaActual;
+        distancia[lado][extremos[lado]] = 0;
+        padre[lado][extremos[lado]] = -1;
+        cola[lado].push({0, extremos[lado]});
+        medidas.insercionesCola++;
+    }
+
+    uint32_t mejor = UINT32_MAX;
+    int encuentro = -1;
+    while (!cola[0].empty() || !cola[1].empty()) {
+        int lado = cola[1].empty() || (!cola[0].empty() && cola[0].top().first <= cola[1].top().first) ? 0 : 1;
+        EntradaDistancia entrada = cola[lado].top();
+        if (entrada.first >= mejor) break;
+        cola[lado].pop();
+        medidas.extraccionesCola++;
+        int nodo = entrada.second;
+        if (entrada.first != distanciaDe(lado, nodo)) continue; // Entrada obsoleta
+        medidas.nodosExpandidos++;
+
+        uint32_t otra = distanciaDe(1 - lado, nodo);
+        if (otra != UINT32_MAX && entrada.first + otra < mejor) {
+            mejor = entrada.first + otra;
+            encuentro = nodo;
+        }
+        for (uint32_t k = inicioSubida[nodo]; k < inicioSubida[nodo + 1]; k++) {
+            const AristaJerarquia& arista = subida[k];
+            uint32_t nueva = entrada.first + arista.peso;
+            medidas.nodosGenerados++;
+            if (nueva < distanciaDe(lado, arista.destino)) {
+                marca[lado][arista.destino] = consultaActual;
+                distancia[lado][arista.destino] = nueva;
+                padre[lado][arista.destino] = nodo;
+                medioPadre[lado][arista.destino] = arista.medio;
+                cola[lado].push({nueva, arista.destino});
+                medidas.insercionesCola++;
+            }
+        }
+        medidas.registrarFrontera(cola[0].size() + cola[1].size());
+    }
+    if (encuentro < 0) return false;
+
+    // Tramo de subida desde el origen hasta el encuentro
+    std::vector<int> cadena;
+    for (int nodo = encuentro; nodo != -1; nodo = padre[0][nodo]) cadena.push_back(nodo);
+    std::reverse(cadena.begin(), cadena.end());
+    std::vector<int> nodos = {s};
+    for (size_t k = 1; k < cadena.size(); k++) {
+        desempaquetar(cadena[k - 1], cadena[k], medioPadre[0][cadena[k]], nodos);
+    }
+    // Tramo de bajada desde el encuentro hasta el destino
+    for (int nodo = encuentro; nodo != t; nodo = padre[1][nodo]) {
+        desempaquetar(nodo, padre[1][nodo], medioPadre[1][nodo], nodos);
+    }
+
+    ruta.reserve(nodos.size());
+    for (int nodo : nodos) ruta.push_back(celdaNodo[nodo]);
+    return true;
+}
+
+// Método que devuelve los bytes ocupados por la jerarquía (sin la memoria de trabajo de la consulta)
+size_t JerarquiaContraccion::bytes() const {
+    return (nodoCelda.size() + celdaNodo.size() + nivel.size()) * sizeof(int)
+         + inicioSubida.size() * sizeof(uint32_t) + subida.size() * sizeof(AristaJerarquia);
+}
+
+// Función que calcula la huella (FNV-1a) de las celdas bloqueadas de una grilla
+uint64_t huellaMapa(const Grid& grid) {
+    uint64_t valor = 1469598103934665603ull;
+    auto mezclar = [&](uint64_t dato) {
+        valor ^= dato;
+        valor *= 1099511628211ull;
+    };
+    mezclar((uint64_t)grid.obtenerFilas());
+    mezclar((uint64_t)grid.obtenerColumnas());
+    for (int i = 0; i < grid.obtenerFilas(); i++) {
+        for (int j = 0; j < grid.obtenerColumnas(); j++) {
+            mezclar(grid.obtenerCelda(i, j).estado == BLOQUEADO ? 1 : 0);
+        }
+    }
+    return valor;
+}
+
+// Función de búsqueda sobre una jerarquía de contracción ya construida o cargada para el mapa actual
+// (si la jerarquía no está sincronizada con la versión del mapa, se responde con BFS)
+bool Grid::buscarConJerarquia(const JerarquiaContraccion& jerarquia, Celda& origen, Celda& destino) {
+    if (!jerarquia.sincronizada(*this)) {
+        return BFS(origen, destino);
+    }
+    MedicionMemoria memoria;
+    EstadisticasBusqueda medidas;
+    std::vector<int> ruta;
+    bool encontrada = jerarquia.consultar(indiceCelda(origen), indiceCelda(destino), ruta, medidas);
+    marcarRutaIndices(ruta); // Misma representación RUTA que el resto de búsquedas
+    medidas.longitudRuta = estadisticas.longitudRuta;
+    estadisticas = medidas;
+    estadisticas.bytesAuxiliares = memoria.bytesPico();
+    estadisticas.bytesVivos = memoria.bytesVivos();
+    estadisticas.asignaciones = memoria.asignaciones();
+    return encontrada;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "metricas.h"
+
+class Grid;
+
+// Arista de la jerarquía: vecino, peso y nodo contraído que la originó (-1 si es una arista de la grilla)
+struct AristaJerarquia {
+    int destino;
+    uint32_t peso;
+    int medio;
+};
+
+// Clase con una jerarquía de contracción (CH) sobre las celdas libres de una grilla.
+// El preproceso contrae los nodos de menor importancia primero y añade atajos que conservan
+// las distancias; la consulta es un Dijkstra bidireccional que solo sube en la jerarquía
+// y explora unos pocos cientos de nodos aunque la grilla tenga millones de celdas.
+class JerarquiaContraccion {
+private:
+    int filas = 0;
+    int columnas = 0;
+    uint64_t version = 0;    // Versión del mapa con la que está sincronizada
+    uint64_t huella = 0;     // Huella del mapa de celdas bloqueadas (para validar archivos)
+    bool construida = false;
+    std::vector<int> nodoCelda;     // Nodo de cada celda (-1 si está bloqueada)
+    std::vector<int> celdaNodo;     // Celda (índice por filas) de cada nodo
+    std::vector<int> nivel;         // Orden de contracción de cada nodo
+    std::vector<uint32_t> inicioSubida; // Aristas hacia nodos de nivel mayor, en formato CSR
+    std::vector<AristaJerarquia> subida;
+    size_t atajos = 0;              // Atajos añadidos durante la contracción
+
+    // Memoria de trabajo de la consulta (las consultas sobre un mismo objeto no son concurrentes)
+    mutable std::vector<uint32_t> distancia[2];
+    mutable std::vector<int> padre[2];
+    mutable std::vector<int> medioPadre[2];
+    mutable std::vector<uint32_t> marca[2];
+    mutable uint32_t consultaActual = 0;
+
+    // Método que devuelve el nodo contraído de la arista entre dos nodos (el de menor nivel la guarda)
+    int medioArista(int a, int b) const;
+
+    // Método que añade a la ruta los nodos de una arista (sin el primero), desplegando los atajos
+    void desempaquetar(int desde, int hasta, int medio, std::vector<int>& nodos) const;
+
+public:
+    // Método que construye la jerarquía a partir de las celdas libres de la grilla, contrayendo
+    // en paralelo conjuntos independientes de nodos de menor prioridad
+    void construir(const Grid& grid);
+
+    // Método que guarda la jerarquía en un archivo binario; devuelve false si no se puede escribir
+    bool guardar(const std::string& archivo) const;
+
+    // Método que carga una jerarquía de un archivo binario; devuelve false si el archivo no es
+    // válido o no corresponde a las celdas bloqueadas de la grilla
+    bool cargar(const std::string& archivo, const Grid& grid);
+
+    // Método que indica si la jerarquía corresponde a la versión actual del mapa de la grilla
+    bool sincronizada(const Grid& grid) const;
+
+    // Función de consulta bidireccional; devuelve la ruta como índices de celda (por filas)
+    bool consultar(int origen, int destino, std::vector<int>& ruta, EstadisticasBusqueda& medidas) const;
+
+    // Métodos para consultar el tamaño de la jerarquía
+    size_t numeroNodos() const { return celdaNodo.size(); }
+    size_t numeroAtajos() const { return atajos; }
+    size_t bytes() const;
+};
+
+// Función que calcula la huella (FNV-1a) de las celdas bloqueadas de una grilla
+uint64_t huellaMapa(const Grid& grid);
@@ -0,0 +1,186 @@
+#include <functional>
+#include <limits>
+#include "entidades.h"
+#include "kernels.h"
+
+// Método que copia la grilla con el terreno indicado; el borde y las celdas bloqueadas quedan a 0
+void MallaBusqueda::construir(const Grid& grid, const std::vector<uint8_t>* costes) {
+    filas = grid.obtenerFilas();
+    columnas = grid.obtenerColumnas();
+    ancho = columnas + 2;
+    terreno.assign((size_t)(filas + 2) * ancho, 0);
+    for (int i = 0; i < filas; i++) {
+        for (int j = 0; j < columnas; j++) {
+            if (grid.obtenerCelda(i, j).estado == BLOQUEADO) continue;
+            uint8_t coste = costes ? (*costes)[(size_t)i * columnas + j] : 1;
+            terreno[(size_t)(i + 1) * ancho + j + 1] = coste ? coste : 1; // 0 está reservado a bloqueada
+        }
+    }
+    version = grid.obtenerVersion();
+    construida = true;
+}
+
+// Método que indica si la malla corresponde a la versión actual del mapa de la grilla
+bool MallaBusqueda::sincronizada(const Grid& grid) const {
+    return construida && version == grid.obtenerVersion()
+        && filas == grid.obtenerFilas() && columnas == grid.obtenerColumnas();
+}
+
+// Coste de un movimiento diagonal sobre terreno de coste 1
+const float RAIZ_DOS = 1.41421356f;
+
+// Políticas de coste: tipo de la distancia acumulada y coste de entrar en una celda
+struct CosteUnitario {
+    typedef uint32_t Tipo;
+    static Tipo paso(uint8_t, bool) { return 1; }
+    static Tipo heuristica(int df, int dc, bool ocho) { return ocho ? std::max(df, dc) : df + dc; }
+};
+
+struct CosteTerreno {
+    typedef uint32_t Tipo;
+    static Tipo paso(uint8_t terreno, bool) { return terreno; }
+    static Tipo heuristica(int df, int dc, bool ocho) { return ocho ? std::max(df, dc) : df + dc; }
+};
+
+struct CosteReal {
+    typedef float Tipo;
+    static Tipo paso(uint8_t terreno, bool diagonal) { return diagonal ? terreno * (float)RAIZ_DOS : (float)terreno; }
+    static Tipo heuristica(int df, int dc, bool ocho) {
+        if (!ocho) return (float)(df + dc);
+        int menor = std::min(df, dc);
+        return (float)(std::max(df, dc) - menor) + menor * (float)RAIZ_DOS; // Distancia octil
+    }
+};
+
+// Políticas de heurística sobre la distancia sin obstáculos del modelo de coste
+struct HeuristicaNula {
+    template <class Coste> static typename Coste::Tipo calcular(int, int, bool) { return 0; }
+};
+
+struct HeuristicaAdmisible {
+    template <class Coste> static typename Coste::Tipo calcular(int df, int dc, bool ocho) {
+        return Coste::heuristica(df, dc, ocho);
+    }
+};
+
+struct HeuristicaPonderada {
+    template <class Coste> static typename Coste::Tipo calcular(int df, int dc, bool ocho) {
+        return 2 * Coste::heuristica(df, dc, ocho);
+    }
+};
+
+// Núcleo de búsqueda A* especializado en tiempo de compilación. Vecinos, coste y heurística son
+// parámetros de plantilla: el bucle de vecinos se desenrolla, el borde de la malla evita comprobar
+// límites y el padre se guarda como código de dirección de 2 bits (4 vecinos) o 3 bits (8 vecinos).
+template <int Vecinos, class Coste, class Heuristica>
+static bool kernelBusqueda(const MallaBusqueda& malla, int origen, int destino,
+                           std::vector<int>& ruta, EstadisticasBusqueda& medidas) {
+    typedef typename Coste::Tipo Tipo;
+    const bool ocho = Vecinos == 8;
+    const int ancho = malla.obtenerAncho();
+    const uint8_t* terreno = malla.datos();
+    // Cardinales primero y diagonales después; las diagonales usan las cardinales (d - 4) y (d - 2)
+    const int desplazamiento[8] = {-ancho, ancho, -1, 1, -ancho - 1, -ancho + 1, ancho - 1, ancho + 1};
+    const int lateralA[8] = {0, 0, 0, 0, -ancho, -ancho, ancho, ancho};
+    const int lateralB[8] = {0, 0, 0, 0, -1, 1, -1, 1};
+    const Tipo infinito = std::numeric_limits<Tipo>::max();
+    int filaDestino = destino / ancho, columnaDestino = destino % ancho;
+    auto h = [&](int posicion) {
+        return Heuristica::template calcular<Coste>(std::abs(posicion / ancho - filaDestino),
+                                                    std::abs(posicion % ancho - columnaDestino), ocho);
+    };
+
+    std::vector<Tipo, AsignadorContador<Tipo>> g(malla.tamano(), infinito);
+    DireccionesEmpaquetadas<Vecinos == 4 ? 2 : 3> padres;
+    padres.redimensionar(malla.tamano());
+    typedef std::pair<Tipo, int> EntradaCola; // (f, posición)
+    std::priority_queue<EntradaCola, std::vector<EntradaCola, AsignadorContador<EntradaCola>>,
+                        std::greater<EntradaCola>> abiertos;
+    g[origen] = 0;
+    abiertos.push({h(origen), origen});
+    medidas.insercionesCola++;
+
+    bool encontrada = false;
+    while (!abiertos.empty()) {
+        EntradaCola entrada = abiertos.top();
+        abiertos.pop();
+        medidas.extraccionesCola++;
+        int actual = entrada.second;
+        if (entrada.first != g[actual] + h(actual)) continue; // Entrada obsoleta
+        if (actual == destino) {
+            encontrada = true;
+            break;
+        }
+        medidas.nodosExpandidos++;
+        Tipo base = g[actual];
+        for (int d = 0; d < Vecinos; d++) {
+            int vecino = actual + desplazamiento[d];
+            uint8_t coste = terreno[vecino];
+            // En diagonal, las dos celdas cardinales compartidas deben estar libres
+            bool libre = d < 4 ? coste != 0
+                               : (coste != 0) & (terreno[actual + lateralA[d]] != 0) & (terreno[actual + lateralB[d]] != 0);
+            if (!libre) continue;
+            medidas.nodosGenerados++;
+            Tipo nuevo = base + Coste::paso(coste, d >= 4);
+            if (nuevo < g[vecino]) {
+                g[vecino] = nuevo;
+                padres.asignar(vecino, (uint8_t)d);
+                abiertos.push({nuevo + h(vecino), vecino});
+                medidas.insercionesCola++;
+            }
+        }
+        medidas.registrarFrontera(abiertos.size());
+    }
+
+    // Reconstrucción con los códigos de dirección (el padre está en el sentido contrario)
+    ruta.clear();
+    if (encontrada) {
+        for (int posicion = destino; posicion != origen; posicion -= desplazamiento[padres.obtener(posicion)]) {
+            ruta.push_back(malla.indice(posicion));
+        }
+        ruta.push_back(malla.indice(origen));
+        std::reverse(ruta.begin(), ruta.end());
+    }
+    return encontrada;
+}
+
+// Tabla de núcleos indexada por [conectividad][coste][heurística]; el despacho ocurre una vez por consulta
+template <int Vecinos, class Coste>
+struct FilaKernels {
+    static constexpr FuncionKernel heuristicas[3] = {
+        kernelBusqueda<Vecinos, Coste, HeuristicaNula>,
+        kernelBusqueda<Vecinos, Coste, HeuristicaAdmisible>,
+        kernelBusqueda<Vecinos, Coste, HeuristicaPonderada>,
+    };
+};
+
+static const FuncionKernel* const TABLA_KERNELS[2][3] = {
+    {FilaKernels<4, CosteUnitario>::heuristicas, FilaKernels<4, CosteTerreno>::heuristicas, FilaKernels<4, CosteReal>::heuristicas},
+    {FilaKernels<8, CosteUnitario>::heuristicas, FilaKernels<8, CosteTerreno>::heuristicas, FilaKernels<8, CosteReal>::heuristicas},
+};
+
+// Función que devuelve el núcleo especializado para la combinación indicada
+FuncionKernel obtenerKernel(const ConfiguracionKernel& configuracion) {
+    return TABLA_KERNELS[configuracion.conectividad][configuracion.coste][configuracion.heuristica];
+}
+
+// Función de búsqueda con un núcleo especializado sobre una malla ya preparada para el mapa actual
+// (si la malla no está sincronizada con la versión del mapa, se responde con BFS)
+bool Grid::buscarConKernel(const MallaBusqueda& malla, const ConfiguracionKernel& configuracion,
+                           Celda& origen, Celda& destino) {
+    if (!malla.sincronizada(*this)) {
+        return BFS(origen, destino);
+    }
+    MedicionMemoria memoria;
+    EstadisticasBusqueda medidas;
+    std::vector<int> ruta;
+    FuncionKernel kernel = obtenerKernel(configuracion);
+    bool encontrada = kernel(malla, malla.posicion(indiceCelda(origen)), malla.posicion(indiceCelda(destino)), ruta, medidas);
+    marcarRutaIndices(ruta); // Misma representación RUTA que el resto de búsquedas
+    medidas.longitudRuta = estadisticas.longitudRuta;
+    estadisticas = medidas;
+    estadisticas.bytesAuxiliares = memoria.bytesPico();
+    estadisticas.bytesVivos = memoria.bytesVivos();
+    estadisticas.asignaciones = memoria.asignaciones();
+    return encontrada;
+}
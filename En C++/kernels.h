@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "metricas.h"
+
+class Grid;
+
+// Vecindad de los movimientos: 4 vecinos (cruz) u 8 vecinos (sin cortar esquinas bloqueadas)
+enum Conectividad {
+    CONECTIVIDAD_4,
+    CONECTIVIDAD_8
+};
+
+// Modelo de coste de un movimiento hacia una celda
+enum ModeloCoste {
+    COSTE_UNITARIO, // Todos los movimientos cuestan 1 (enteros de 32 bits)
+    COSTE_TERRENO,  // Cuesta el valor de terreno de la celda destino, de 1 a 255 (enteros de 32 bits)
+    COSTE_REAL      // Terreno de la celda destino, multiplicado por raíz de 2 en diagonal (float)
+};
+
+// Política de heurística de la búsqueda
+enum PoliticaHeuristica {
+    HEURISTICA_NULA,      // Sin heurística (Dijkstra)
+    HEURISTICA_ADMISIBLE, // Distancia sin obstáculos del modelo: Manhattan, Chebyshev u octil
+    HEURISTICA_PONDERADA  // Admisible multiplicada por 2 (A* ponderado: más rápido, no siempre óptimo)
+};
+
+// Combinación de parámetros que selecciona un núcleo de búsqueda especializado
+struct ConfiguracionKernel {
+    Conectividad conectividad = CONECTIVIDAD_4;
+    ModeloCoste coste = COSTE_UNITARIO;
+    PoliticaHeuristica heuristica = HEURISTICA_ADMISIBLE;
+};
+
+// Clase con la grilla preparada para los núcleos: un byte por celda con su coste de terreno
+// (0 si está bloqueada) y un borde de celdas bloqueadas alrededor, de modo que los vecinos
+// se alcanzan con desplazamientos fijos sin comprobar los límites.
+class MallaBusqueda {
+private:
+    int filas = 0;
+    int columnas = 0;
+    int ancho = 0;           // Columnas más el borde (paso entre filas)
+    uint64_t version = 0;    // Versión del mapa con la que está sincronizada
+    bool construida = false;
+    std::vector<uint8_t> terreno;
+
+public:
+    // Método que copia la grilla con el terreno indicado (por filas, 1 a 255); sin terreno, todo cuesta 1
+    void construir(const Grid& grid, const std::vector<uint8_t>* costes = nullptr);
+
+    // Método que indica si la malla corresponde a la versión actual del mapa de la grilla
+    bool sincronizada(const Grid& grid) const;
+
+    // Métodos para traducir entre índices por filas de la grilla y posiciones de la malla con borde
+    int posicion(int indice) const { return (indice / columnas + 1) * ancho + indice % columnas + 1; }
+    int indice(int posicion) const { return (posicion / ancho - 1) * columnas + posicion % ancho - 1; }
+
+    // Métodos de consulta de la malla
+    int obtenerAncho() const { return ancho; }
+    size_t tamano() const { return terreno.size(); }
+    const uint8_t* datos() const { return terreno.data(); }
+};
+
+// Tipo de los núcleos de búsqueda: posiciones de la malla de origen y destino; devuelven la ruta
+// como índices de la grilla (por filas) y rellenan las métricas
+typedef bool (*FuncionKernel)(const MallaBusqueda& malla, int origen, int destino,
+                              std::vector<int>& ruta, EstadisticasBusqueda& medidas);
+
+// Función que devuelve el núcleo especializado para la combinación indicada (tabla sin llamadas virtuales)
+FuncionKernel obtenerKernel(const ConfiguracionKernel& configuracion);
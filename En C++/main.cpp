@@ -1,7 +1,11 @@
 #include <chrono>
 #include <iomanip> // Para std::setprecision, que ayuda a mostrar tiempos con precisión
 #include <ctime>   // Para std::clock(), medir el tiempo de CPU
+#include <fstream> // Para std::ofstream, exportar las métricas a CSV
 #include "entidades.h"
+#include "interfaz.h"   // Dibujo de la grilla y de las instrucciones con raylib
+#include "contadores.h" // Contadores de rendimiento del hardware (perf_event_open)
+#include "cache.h"      // Caché LRU de rutas por extremos y versión del mapa
 
 // Variables globales para medir tiempos de ejecución de la aplicación
 auto tiempoInicio = std::chrono::high_resolution_clock::now(); // Tiempo de inicio de la ejecución
@@ -46,6 +50,64 @@ size_t getCurrentRSS() {
 #endif
 }
 
+// Archivo donde se acumulan las métricas algorítmicas de cada consulta
+const char* ARCHIVO_METRICAS = "metricas.csv";
+
+// Función que muestra las métricas algorítmicas de la última búsqueda y las añade al archivo CSV
+void registrarMetricas(const char* algoritmo, const EstadisticasBusqueda& estadisticas, bool encontrada, double tiempoMs) {
+    std::cout << "Nodos expandidos: " << estadisticas.nodosExpandidos << std::endl;
+    std::cout << "Nodos generados: " << estadisticas.nodosGenerados << std::endl;
+    std::cout << "Inserciones / extracciones en la cola: "
+              << estadisticas.insercionesCola << " / " << estadisticas.extraccionesCola << std::endl;
+    std::cout << "Pico de la frontera: " << estadisticas.picoFrontera << std::endl;
+    std::cout << "Longitud de la ruta: " << estadisticas.longitudRuta << std::endl;
+
+    // Añadimos la fila al CSV, escribiendo la cabecera si el archivo está vacío
+    std::ofstream archivo(ARCHIVO_METRICAS, std::ios::app);
+    if (!archivo) return;
+    if (archivo.tellp() == 0) {
+        escribirCabeceraCSV(archivo);
+    }
+    escribirEstadisticasCSV(archivo, algoritmo, estadisticas, encontrada, tiempoMs);
+}
+
+// Capacidad de la caché de rutas en bytes
+const size_t CAPACIDAD_CACHE_RUTAS = 4 * 1024 * 1024;
+
+// Identificadores con los que cada algoritmo guarda sus rutas en la caché
+const int CACHE_BFS = 0;
+const int CACHE_DSTAR_LITE = 1;
+
+// Función que intenta servir la ruta del algoritmo desde la caché; si hay acierto la marca en la grilla,
+// deja en caminoEncontrado si había ruta y devuelve true
+bool servirDesdeCache(CacheRutas& cache, Grid& grid, const Celda& origen, const Celda& destino, int idAlgoritmo,
+                      const char* algoritmo, bool& caminoEncontrado) {
+    bool existe = false;
+    std::vector<int> ruta;
+    auto inicio = std::chrono::high_resolution_clock::now();
+    if (!cache.buscar(idAlgoritmo, grid.indiceCelda(origen), grid.indiceCelda(destino), grid.obtenerVersion(), existe, ruta)) {
+        return false;
+    }
+    grid.marcarRutaIndices(ruta);
+    caminoEncontrado = existe;
+    auto duracion = std::chrono::high_resolution_clock::now() - inicio;
+    EstadisticasCache estadisticas = cache.obtenerEstadisticas();
+
+    std::cout << "\n--- Ruta " << algoritmo << " servida desde la cache ---" << std::endl;
+    if (!existe) {
+        std::cout << "No se ha encontrado un camino (resultado cacheado)." << std::endl;
+    }
+    std::cout << "Tiempo de consulta: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(duracion).count() / 1e6 << " ms" << std::endl;
+    std::cout << "Aciertos / fallos de la cache: " << estadisticas.aciertos << " / " << estadisticas.fallos << std::endl;
+    return true;
+}
+
+// Archivo donde se guarda la jerarquía de contracción del mapa actual
+const char* ARCHIVO_JERARQUIA = "jerarquia.ch";
+// Archivo donde se guarda la base de caminos comprimida del mapa actual
+const char* ARCHIVO_BASE_CAMINOS = "basecaminos.cpd";
+
 // Función principal que inicializa la ventana y gestiona el flujo del programa
 int main() {
     const int anchoPantalla = 800;
@@ -68,6 +130,19 @@ int main() {
 
     bool cierreVentana = false;
     bool caminoEncontrado = true;
+    uint64_t semillaMapa = 0; // Semilla del último mapa generado con las teclas 1 a 4
+    CampoFlujo campoFlujo;    // Campo de flujo hacia el destino (tecla F)
+    CacheRutas cacheRutas(CAPACIDAD_CACHE_RUTAS); // Rutas ya calculadas para la versión actual del mapa
+    GrafoSubobjetivos grafoSubobjetivos;  // Grafo de subobjetivos (tecla G), se actualiza al editar celdas
+    JerarquiaContraccion jerarquia;       // Jerarquía de contracción (tecla H), se reconstruye si cambia el mapa
+    BaseCaminos baseCaminos;              // Base de caminos comprimida (tecla C), se reconstruye si cambia el mapa
+
+    // Contadores de hardware que se leen alrededor de cada búsqueda (si la plataforma lo permite)
+    ContadoresHardware contadores;
+    AcumuladoContadores acumuladoBFS;
+    AcumuladoContadores acumuladoDStar;
+    std::cout << "Contadores de hardware: "
+              << (contadores.disponible() ? "disponibles" : "no disponibles en esta plataforma") << std::endl;
 
     // Medir el tiempo de carga del programa
     auto tiempoCarga = std::chrono::high_resolution_clock::now() - tiempoInicio;
@@ -98,7 +173,16 @@ int main() {
                 if (mouseX >= 0 && mouseX < columnas && mouseY >= 0 && mouseY < filas) {
                     Celda& celda = grid.obtenerCelda(mouseY, mouseX);
                     if (celda.estado != ORIGEN && celda.estado != DESTINO) {
-                        celda.estado = BLOQUEADO; // Bloqueamos la celda con clic izquierdo
+                        uint64_t versionAnterior = grid.obtenerVersion();
+                        bool grafoAlDia = grafoSubobjetivos.sincronizado(grid);
+                        grid.editarCelda(mouseY, mouseX, BLOQUEADO); // Bloqueamos la celda con clic izquierdo
+                        if (grafoAlDia) {
+                            grafoSubobjetivos.actualizarCelda(grid, mouseY, mouseX); // Reconstrucción local del grafo
+                        }
+                        if (grid.obtenerVersion() != versionAnterior) {
+                            // Solo se invalidan las rutas cacheadas que cruzan la celda
+                            cacheRutas.notificarBloqueo(grid.indiceCelda(celda), versionAnterior, grid.obtenerVersion());
+                        }
                     }
                 }
             }
@@ -108,7 +192,13 @@ int main() {
                 if (mouseX >= 0 && mouseX < columnas && mouseY >= 0 && mouseY < filas) {
                     Celda& celda = grid.obtenerCelda(mouseY, mouseX);
                     if (celda.estado != ORIGEN && celda.estado != DESTINO) {
-                        celda.estado = VACIO; // Desbloqueamos la celda con clic derecho
+                        bool grafoAlDia = grafoSubobjetivos.sincronizado(grid);
+                        grid.editarCelda(mouseY, mouseX, VACIO); // Desbloqueamos la celda con clic derecho
+                        if (grafoAlDia) {
+                            grafoSubobjetivos.actualizarCelda(grid, mouseY, mouseX);
+                        }
+                        // Desbloquear puede acortar cualquier ruta: descartamos las versiones anteriores
+                        cacheRutas.descartarAnteriores(grid.obtenerVersion());
                     }
                 }
             }
@@ -117,7 +207,10 @@ int main() {
             if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
                 int mouseX = GetMouseX() / CELDA_TAM;
                 int mouseY = (GetMouseY() - INSTRUCCIONES_ALTURA) / CELDA_TAM;
-                if (mouseX >= 0 && mouseX < columnas && mouseY >= 0 && mouseY < filas) {
+                // Las celdas bloqueadas no sirven de extremo: liberarlas aquí no cambiaría la versión del mapa
+                // y los árboles y rutas guardados seguirían dándolas por bloqueadas
+                if (mouseX >= 0 && mouseX < columnas && mouseY >= 0 && mouseY < filas &&
+                    grid.obtenerCelda(mouseY, mouseX).estado != BLOQUEADO) {
                     Celda& celda = grid.obtenerCelda(mouseY, mouseX);
                     if (!origen) {
                         origen = &celda;
@@ -131,38 +224,47 @@ int main() {
         }
 
         // Ejecutamos BFS cuando se presiona ENTER
-        if (IsKeyPressed(KEY_ENTER) && origen && destino) {
+        if (IsKeyPressed(KEY_ENTER) && origen && destino && !servirDesdeCache(cacheRutas, grid, *origen, *destino, CACHE_BFS, "BFS", caminoEncontrado)) {
             tiempoBFSInicio = std::chrono::high_resolution_clock::now();
             cpuBFSInicio = std::clock();
             grid.reiniciar();
-            // Medir uso de memoria antes de BFS
-            size_t memoriaAntesBFS = getCurrentRSS();
-            if (grid.BFS(*origen, *destino)) {
+            contadores.iniciar();
+            bool encontradaBFS = grid.BFS(*origen, *destino);
+            LecturaContadores lecturaBFS = contadores.detener();
+            auto tiempoBFSEjecucion = std::chrono::high_resolution_clock::now() - tiempoBFSInicio;
+            double tiempoBFSMs = std::chrono::duration_cast<std::chrono::nanoseconds>(tiempoBFSEjecucion).count() / 1e6;
+            if (encontradaBFS) {
                 caminoEncontrado = true;
-                auto tiempoBFSEjecucion = std::chrono::high_resolution_clock::now() - tiempoBFSInicio;
                 // Medir uso de memoria después de BFS
                 size_t memoriaDespuesBFS = getCurrentRSS();
                 // Medir tiempo de CPU usado por BFS
                 std::clock_t cpuBFSEjecucion = std::clock() - cpuBFSInicio;
 
                 std::cout << "\n--- Resultados de Tiempo de Ejecucion BFS ---" << std::endl;
-                std::cout << "Tiempo de ejecucion: "
-                          << std::chrono::duration_cast<std::chrono::nanoseconds>(tiempoBFSEjecucion).count() / 1e6
-                          << " ms" << std::endl;
+                std::cout << "Tiempo de ejecucion: " << tiempoBFSMs << " ms" << std::endl;
                 std::cout << "Tiempo de CPU utilizado: "
                           << (cpuBFSEjecucion * 1000.0) / CLOCKS_PER_SEC << " ms" << std::endl;
-                std::cout << "Uso de memoria RAM durante BFS: "
-                          << (memoriaDespuesBFS - memoriaAntesBFS) / 1024 << " KB" << std::endl;
+                std::cout << "Memoria asignada por BFS: pico de "
+                          << grid.obtenerEstadisticas().bytesAuxiliares / 1024.0 << " KB en "
+                          << grid.obtenerEstadisticas().asignaciones << " asignaciones" << std::endl;
                 std::cout << "Uso de memoria RAM total despues de BFS: "
                           << memoriaDespuesBFS / 1024 << " KB" << std::endl;
             } else {
                 caminoEncontrado = false; // No se encontró ruta
                 std::cout << "\nNo se ha encontrado un camino con BFS." << std::endl;
             }
+            registrarMetricas("BFS", grid.obtenerEstadisticas(), encontradaBFS, tiempoBFSMs);
+            cacheRutas.guardar(CACHE_BFS, grid.indiceCelda(*origen), grid.indiceCelda(*destino), grid.obtenerVersion(),
+                               encontradaBFS, grid.extraerRuta(*origen, *destino));
+            if (contadores.disponible()) {
+                std::cout << "\n--- Contadores de hardware BFS ---" << std::endl;
+                mostrarContadores(std::cout, lecturaBFS);
+                acumuladoBFS.agregar(lecturaBFS);
+            }
         }
 
         // Ejecutamos D* Lite cuando se presiona ESPACIO
-        if (IsKeyPressed(KEY_SPACE) && origen && destino) {
+        if (IsKeyPressed(KEY_SPACE) && origen && destino && !servirDesdeCache(cacheRutas, grid, *origen, *destino, CACHE_DSTAR_LITE, "D* Lite", caminoEncontrado)) {
             tiempoDStarInicio = std::chrono::high_resolution_clock::now();
             cpuDStarInicio = std::clock();
             grid.reiniciar();
@@ -173,30 +275,145 @@ int main() {
 
             grid.reiniciarAlgoritmoDStarLite();
 
-            // Medir uso de memoria antes de D* Lite
-            size_t memoriaAntesDStar = getCurrentRSS();
-            if (grid.DStarLite(*origen, *destino)) {
+            contadores.iniciar();
+            bool encontradaDStar = grid.DStarLite(*origen, *destino);
+            LecturaContadores lecturaDStar = contadores.detener();
+            auto tiempoDStarEjecucion = std::chrono::high_resolution_clock::now() - tiempoDStarInicio;
+            double tiempoDStarMs = std::chrono::duration_cast<std::chrono::nanoseconds>(tiempoDStarEjecucion).count() / 1e6;
+            if (encontradaDStar) {
                 caminoEncontrado = true;
-                auto tiempoDStarEjecucion = std::chrono::high_resolution_clock::now() - tiempoDStarInicio;
                 // Medir uso de memoria después de D* Lite
                 size_t memoriaDespuesDStar = getCurrentRSS();
                 // Medir tiempo de CPU usado por D* Lite
                 std::clock_t cpuDStarEjecucion = std::clock() - cpuDStarInicio;
 
                 std::cout << "\n--- Resultados de Tiempo de Ejecucion D* Lite ---" << std::endl;
-                std::cout << "Tiempo de ejecucion: "
-                          << std::chrono::duration_cast<std::chrono::nanoseconds>(tiempoDStarEjecucion).count() / 1e6
-                          << " ms" << std::endl;
+                std::cout << "Tiempo de ejecucion: " << tiempoDStarMs << " ms" << std::endl;
                 std::cout << "Tiempo de CPU utilizado: "
                           << (cpuDStarEjecucion * 1000.0) / CLOCKS_PER_SEC << " ms" << std::endl;
-                std::cout << "Uso de memoria RAM durante D* Lite: "
-                          << (memoriaDespuesDStar - memoriaAntesDStar) / 1024 << " KB" << std::endl;
+                std::cout << "Memoria asignada por D* Lite: pico de "
+                          << grid.obtenerEstadisticas().bytesAuxiliares / 1024.0 << " KB en "
+                          << grid.obtenerEstadisticas().asignaciones << " asignaciones" << std::endl;
                 std::cout << "Uso de memoria RAM total despues de D* Lite: "
                           << memoriaDespuesDStar / 1024 << " KB" << std::endl;
             } else {
                 caminoEncontrado = false; // No se encontró ruta
                 std::cout << "\nNo se ha encontrado un camino con D* Lite." << std::endl;
             }
+            registrarMetricas("DStarLite", grid.obtenerEstadisticas(), encontradaDStar, tiempoDStarMs);
+            cacheRutas.guardar(CACHE_DSTAR_LITE, grid.indiceCelda(*origen), grid.indiceCelda(*destino), grid.obtenerVersion(),
+                               encontradaDStar, grid.extraerRuta(*origen, *destino));
+            if (contadores.disponible()) {
+                std::cout << "\n--- Contadores de hardware D* Lite ---" << std::endl;
+                mostrarContadores(std::cout, lecturaDStar);
+                acumuladoDStar.agregar(lecturaDStar);
+            }
+        }
+
+        // Calculamos el campo de flujo hacia el destino y lo seguimos desde el origen cuando se presiona F
+        if (IsKeyPressed(KEY_F) && origen && destino) {
+            auto tiempoFlujoInicio = std::chrono::high_resolution_clock::now();
+            grid.calcularCampoFlujo(*destino, campoFlujo);
+            auto tiempoCampo = std::chrono::high_resolution_clock::now() - tiempoFlujoInicio;
+            bool encontradaFlujo = grid.seguirCampoFlujo(*origen, campoFlujo);
+            auto tiempoFlujoEjecucion = std::chrono::high_resolution_clock::now() - tiempoFlujoInicio;
+            double tiempoFlujoMs = std::chrono::duration_cast<std::chrono::nanoseconds>(tiempoFlujoEjecucion).count() / 1e6;
+
+            std::cout << "\n--- Resultados del Campo de Flujo ---" << std::endl;
+            std::cout << "Tiempo de calculo del campo: "
+                      << std::chrono::duration_cast<std::chrono::nanoseconds>(tiempoCampo).count() / 1e6
+                      << " ms" << std::endl;
+            std::cout << "Tiempo total (campo + recorrido): " << tiempoFlujoMs << " ms" << std::endl;
+            if (!encontradaFlujo) {
+                std::cout << "No se ha encontrado un camino con el campo de flujo." << std::endl;
+            }
+            caminoEncontrado = encontradaFlujo;
+            registrarMetricas("CampoFlujo", grid.obtenerEstadisticas(), encontradaFlujo, tiempoFlujoMs);
+        }
+
+        // Buscamos la ruta sobre el grafo de subobjetivos cuando se presiona G
+        // (el grafo se construye la primera vez y tras generar un mapa; las ediciones lo actualizan)
+        if (IsKeyPressed(KEY_G) && origen && destino) {
+            double tiempoConstruccionMs = 0;
+            if (!grafoSubobjetivos.sincronizado(grid)) {
+                auto inicioConstruccion = std::chrono::high_resolution_clock::now();
+                grafoSubobjetivos.construir(grid);
+                tiempoConstruccionMs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::high_resolution_clock::now() - inicioConstruccion).count() / 1e6;
+            }
+            auto tiempoSubobjetivosInicio = std::chrono::high_resolution_clock::now();
+            bool encontradaSubobjetivos = grid.buscarConSubobjetivos(grafoSubobjetivos, *origen, *destino);
+            double tiempoSubobjetivosMs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::high_resolution_clock::now() - tiempoSubobjetivosInicio).count() / 1e6;
+
+            std::cout << "\n--- Resultados del Grafo de Subobjetivos ---" << std::endl;
+            std::cout << "Subobjetivos: " << grafoSubobjetivos.numeroSubobjetivos()
+                      << ", aristas: " << grafoSubobjetivos.numeroAristas() << std::endl;
+            if (tiempoConstruccionMs > 0) {
+                std::cout << "Tiempo de construccion del grafo: " << tiempoConstruccionMs << " ms" << std::endl;
+            }
+            std::cout << "Tiempo de consulta: " << tiempoSubobjetivosMs << " ms" << std::endl;
+            if (!encontradaSubobjetivos) {
+                std::cout << "No se ha encontrado un camino con el grafo de subobjetivos." << std::endl;
+            }
+            caminoEncontrado = encontradaSubobjetivos;
+            registrarMetricas("Subobjetivos", grid.obtenerEstadisticas(), encontradaSubobjetivos, tiempoSubobjetivosMs);
+        }
+
+        // Buscamos la ruta sobre la jerarquía de contracción cuando se presiona H
+        // (se carga del archivo si corresponde al mapa; si no, se construye y se guarda)
+        if (IsKeyPressed(KEY_H) && origen && destino) {
+            if (!jerarquia.sincronizada(grid) && !jerarquia.cargar(ARCHIVO_JERARQUIA, grid)) {
+                auto inicioConstruccion = std::chrono::high_resolution_clock::now();
+                jerarquia.construir(grid);
+                double tiempoConstruccionMs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::high_resolution_clock::now() - inicioConstruccion).count() / 1e6;
+                std::cout << "\nJerarquia construida en " << tiempoConstruccionMs << " ms ("
+                          << jerarquia.numeroNodos() << " nodos, " << jerarquia.numeroAtajos() << " atajos)" << std::endl;
+                if (!jerarquia.guardar(ARCHIVO_JERARQUIA)) {
+                    std::cout << "No se pudo guardar " << ARCHIVO_JERARQUIA << std::endl;
+                }
+            }
+            auto tiempoJerarquiaInicio = std::chrono::high_resolution_clock::now();
+            bool encontradaJerarquia = grid.buscarConJerarquia(jerarquia, *origen, *destino);
+            double tiempoJerarquiaMs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::high_resolution_clock::now() - tiempoJerarquiaInicio).count() / 1e6;
+
+            std::cout << "\n--- Resultados de la Jerarquia de Contraccion ---" << std::endl;
+            std::cout << "Tiempo de consulta: " << tiempoJerarquiaMs << " ms" << std::endl;
+            if (!encontradaJerarquia) {
+                std::cout << "No se ha encontrado un camino con la jerarquia." << std::endl;
+            }
+            caminoEncontrado = encontradaJerarquia;
+            registrarMetricas("Jerarquia", grid.obtenerEstadisticas(), encontradaJerarquia, tiempoJerarquiaMs);
+        }
+
+        // Buscamos la ruta sobre la base de caminos comprimida cuando se presiona C
+        // (se carga del archivo si corresponde al mapa; si no, se construye y se guarda)
+        if (IsKeyPressed(KEY_C) && origen && destino) {
+            if (!baseCaminos.sincronizada(grid) && !baseCaminos.cargar(ARCHIVO_BASE_CAMINOS, grid)) {
+                auto inicioConstruccion = std::chrono::high_resolution_clock::now();
+                baseCaminos.construir(grid);
+                double tiempoConstruccionMs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::high_resolution_clock::now() - inicioConstruccion).count() / 1e6;
+                std::cout << "\nBase de caminos construida en " << tiempoConstruccionMs << " ms ("
+                          << baseCaminos.numeroTramos() << " tramos, " << baseCaminos.bytes() << " bytes)" << std::endl;
+                if (!baseCaminos.guardar(ARCHIVO_BASE_CAMINOS)) {
+                    std::cout << "No se pudo guardar " << ARCHIVO_BASE_CAMINOS << std::endl;
+                }
+            }
+            auto tiempoBaseInicio = std::chrono::high_resolution_clock::now();
+            bool encontradaBase = grid.buscarConBaseCaminos(baseCaminos, *origen, *destino);
+            double tiempoBaseMs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::high_resolution_clock::now() - tiempoBaseInicio).count() / 1e6;
+
+            std::cout << "\n--- Resultados de la Base de Caminos ---" << std::endl;
+            std::cout << "Tiempo de consulta: " << tiempoBaseMs << " ms" << std::endl;
+            if (!encontradaBase) {
+                std::cout << "No se ha encontrado un camino con la base de caminos." << std::endl;
+            }
+            caminoEncontrado = encontradaBase;
+            registrarMetricas("BaseCaminos", grid.obtenerEstadisticas(), encontradaBase, tiempoBaseMs);
         }
 
         // Si se presiona ESCAPE, reiniciamos la grilla y las celdas origen y destino
@@ -206,6 +423,24 @@ int main() {
             destino = nullptr;
         }
 
+        // Teclas 1 a 4: generamos un mapa procedural (cada pulsación usa una semilla nueva)
+        int teclaGenerador = 0;
+        if (IsKeyPressed(KEY_ONE)) teclaGenerador = 1;
+        if (IsKeyPressed(KEY_TWO)) teclaGenerador = 2;
+        if (IsKeyPressed(KEY_THREE)) teclaGenerador = 3;
+        if (IsKeyPressed(KEY_FOUR)) teclaGenerador = 4;
+        if (teclaGenerador != 0) {
+            semillaMapa++;
+            switch (teclaGenerador) {
+                case 1: grid.generarObstaculosAleatorios(0.3, semillaMapa); break;
+                case 2: grid.generarLaberinto(semillaMapa); break;
+                case 3: grid.generarHabitaciones(semillaMapa); break;
+                case 4: grid.generarTerrenoPerlin(4.0, 0.1, semillaMapa); break;
+            }
+            origen = nullptr; // El generador borra el origen y el destino
+            destino = nullptr;
+        }
+
         // Si se cierra la ventana, terminamos el programa
         if (WindowShouldClose() && !IsKeyPressed(KEY_ESCAPE)) {
             cierreVentana = true;
@@ -218,6 +453,18 @@ int main() {
         EndDrawing();
     }
 
+    // Mostrar el uso de la caché de rutas
+    EstadisticasCache usoCache = cacheRutas.obtenerEstadisticas();
+    std::cout << "\n--- Cache de rutas ---" << std::endl;
+    std::cout << "Aciertos: " << usoCache.aciertos << ", fallos: " << usoCache.fallos
+              << ", expulsiones: " << usoCache.expulsiones << ", invalidaciones: " << usoCache.invalidaciones << std::endl;
+
+    // Mostrar los contadores de hardware acumulados de todas las consultas
+    if (contadores.disponible()) {
+        mostrarAcumulado(std::cout, "BFS", acumuladoBFS);
+        mostrarAcumulado(std::cout, "D* Lite", acumuladoDStar);
+    }
+
     // Descargar la fuente cuando termine el programa
     UnloadFont(fuentePersonalizada);
     // Cerrar la ventana
@@ -0,0 +1,44 @@
+#include "memoria.h"
+
+// Contador de memoria propio de cada hilo, para que las búsquedas en paralelo no se mezclen
+static thread_local EstadoMemoria estadoMemoria;
+
+// Función que registra una asignación en el contador del hilo actual
+void registrarAsignacion(size_t bytes) {
+    estadoMemoria.bytesVivos += bytes;
+    estadoMemoria.asignaciones++;
+    if (estadoMemoria.bytesVivos > estadoMemoria.bytesPico) {
+        estadoMemoria.bytesPico = estadoMemoria.bytesVivos;
+    }
+}
+
+// Función que registra una liberación en el contador del hilo actual
+void registrarLiberacion(size_t bytes) {
+    estadoMemoria.bytesVivos -= bytes;
+}
+
+// Función que devuelve el estado actual del contador del hilo actual
+EstadoMemoria leerContadorMemoria() {
+    return estadoMemoria;
+}
+
+// Constructor que toma la referencia y reinicia el pico del hilo actual
+MedicionMemoria::MedicionMemoria()
+    : bytesBase(estadoMemoria.bytesVivos), asignacionesBase(estadoMemoria.asignaciones) {
+    estadoMemoria.bytesPico = estadoMemoria.bytesVivos;
+}
+
+// Método que devuelve los bytes vivos asignados desde el inicio de la medición
+size_t MedicionMemoria::bytesVivos() const {
+    return estadoMemoria.bytesVivos - bytesBase;
+}
+
+// Método que devuelve el pico de bytes asignados desde el inicio de la medición
+size_t MedicionMemoria::bytesPico() const {
+    return estadoMemoria.bytesPico - bytesBase;
+}
+
+// Método que devuelve el número de asignaciones desde el inicio de la medición
+size_t MedicionMemoria::asignaciones() const {
+    return estadoMemoria.asignaciones - asignacionesBase;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+// Estructura con el estado del contador de memoria del hilo actual
+struct EstadoMemoria {
+    size_t bytesVivos = 0;   // Bytes asignados y todavía no liberados
+    size_t bytesPico = 0;    // Máximo de bytes vivos desde la última medición
+    size_t asignaciones = 0; // Número total de asignaciones realizadas
+};
+
+// Funciones que registran asignaciones y liberaciones en el contador del hilo actual
+void registrarAsignacion(size_t bytes);
+void registrarLiberacion(size_t bytes);
+
+// Función que devuelve el estado actual del contador del hilo actual
+EstadoMemoria leerContadorMemoria();
+
+// Clase que mide la memoria asignada mediante AsignadorContador durante su tiempo de vida
+// (se crea al empezar la búsqueda y se consulta al terminar)
+class MedicionMemoria {
+private:
+    size_t bytesBase;        // Bytes vivos al empezar la medición
+    size_t asignacionesBase; // Asignaciones al empezar la medición
+
+public:
+    // Constructor que toma la referencia y reinicia el pico del hilo actual
+    MedicionMemoria();
+
+    // Método que devuelve los bytes vivos asignados desde el inicio de la medición
+    size_t bytesVivos() const;
+
+    // Método que devuelve el pico de bytes asignados desde el inicio de la medición
+    size_t bytesPico() const;
+
+    // Método que devuelve el número de asignaciones desde el inicio de la medición
+    size_t asignaciones() const;
+};
+
+// Asignador compatible con la STL que contabiliza la memoria de las estructuras de búsqueda
+template <typename T>
+struct AsignadorContador {
+    using value_type = T;
+
+    AsignadorContador() noexcept = default;
+    template <typename U>
+    AsignadorContador(const AsignadorContador<U>&) noexcept {}
+
+    // Método que reserva memoria para n elementos y la contabiliza
+    T* allocate(size_t n) {
+        T* puntero = static_cast<T*>(::operator new(n * sizeof(T)));
+        registrarAsignacion(n * sizeof(T));
+        return puntero;
+    }
+
+    // Método que libera la memoria de n elementos y la descuenta
+    void deallocate(T* puntero, size_t n) noexcept {
+        registrarLiberacion(n * sizeof(T));
+        ::operator delete(puntero);
+    }
+
+    template <typename U>
+    bool operator==(const AsignadorContador<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AsignadorContador<U>&) const noexcept { return false; }
+};
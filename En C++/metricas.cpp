@@ -0,0 +1,50 @@
+#include "metricas.h"
+
+// Método para dejar todas las métricas a cero antes de una nueva consulta
+void EstadisticasBusqueda::reiniciar() {
+    *this = EstadisticasBusqueda();
+}
+
+// Función que escribe la cabecera de las columnas del formato CSV
+void escribirCabeceraCSV(std::ostream& salida) {
+    salida << "algoritmo,encontrada,tiempo_ms,nodos_expandidos,nodos_generados,"
+              "inserciones_cola,extracciones_cola,pico_frontera,bytes_auxiliares,bytes_vivos,asignaciones,longitud_ruta,"
+              "comprobaciones_visibilidad\n";
+}
+
+// Función que escribe una fila CSV con las métricas de una consulta
+void escribirEstadisticasCSV(std::ostream& salida, const std::string& algoritmo,
+                             const EstadisticasBusqueda& estadisticas, bool encontrada, double tiempoMs) {
+    salida << algoritmo << ','
+           << (encontrada ? 1 : 0) << ','
+           << tiempoMs << ','
+           << estadisticas.nodosExpandidos << ','
+           << estadisticas.nodosGenerados << ','
+           << estadisticas.insercionesCola << ','
+           << estadisticas.extraccionesCola << ','
+           << estadisticas.picoFrontera << ','
+           << estadisticas.bytesAuxiliares << ','
+           << estadisticas.bytesVivos << ','
+           << estadisticas.asignaciones << ','
+           << estadisticas.longitudRuta << ','
+           << estadisticas.comprobacionesVisibilidad << '\n';
+}
+
+// Función que escribe un objeto JSON con las métricas de una consulta
+void escribirEstadisticasJSON(std::ostream& salida, const std::string& algoritmo,
+                              const EstadisticasBusqueda& estadisticas, bool encontrada, double tiempoMs) {
+    salida << "{\"algoritmo\": \"" << algoritmo << "\""
+           << ", \"encontrada\": " << (encontrada ? "true" : "false")
+           << ", \"tiempo_ms\": " << tiempoMs
+           << ", \"nodos_expandidos\": " << estadisticas.nodosExpandidos
+           << ", \"nodos_generados\": " << estadisticas.nodosGenerados
+           << ", \"inserciones_cola\": " << estadisticas.insercionesCola
+           << ", \"extracciones_cola\": " << estadisticas.extraccionesCola
+           << ", \"pico_frontera\": " << estadisticas.picoFrontera
+           << ", \"bytes_auxiliares\": " << estadisticas.bytesAuxiliares
+           << ", \"bytes_vivos\": " << estadisticas.bytesVivos
+           << ", \"asignaciones\": " << estadisticas.asignaciones
+           << ", \"longitud_ruta\": " << estadisticas.longitudRuta
+           << ", \"comprobaciones_visibilidad\": " << estadisticas.comprobacionesVisibilidad
+           << "}";
+}
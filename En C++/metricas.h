@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+// Estructura con las métricas algorítmicas de una consulta de búsqueda
+// (independientes del ruido de las mediciones de tiempo)
+struct EstadisticasBusqueda {
+    size_t nodosExpandidos = 0;  // Celdas extraídas de la frontera y expandidas
+    size_t nodosGenerados = 0;   // Vecinos válidos generados al expandir
+    size_t insercionesCola = 0;  // Inserciones (o actualizaciones) en la frontera
+    size_t extraccionesCola = 0; // Extracciones de la frontera
+    size_t picoFrontera = 0;     // Tamaño máximo alcanzado por la frontera
+    size_t bytesAuxiliares = 0;  // Pico de bytes asignados por las estructuras de la búsqueda
+    size_t bytesVivos = 0;       // Bytes asignados por la búsqueda que seguían sin liberar al terminar
+    size_t asignaciones = 0;     // Número de asignaciones de memoria durante la búsqueda
+    size_t longitudRuta = 0;     // Número de pasos de la ruta encontrada (0 si no hay ruta)
+    size_t comprobacionesVisibilidad = 0; // Comprobaciones de línea de visión (búsquedas de cualquier ángulo)
+
+    // Método para dejar todas las métricas a cero antes de una nueva consulta
+    void reiniciar();
+
+    // Método para registrar el tamaño actual de la frontera y actualizar el pico
+    void registrarFrontera(size_t tamano) {
+        if (tamano > picoFrontera) picoFrontera = tamano;
+    }
+};
+
+// Función que escribe la cabecera de las columnas del formato CSV
+void escribirCabeceraCSV(std::ostream& salida);
+
+// Función que escribe una fila CSV con las métricas de una consulta
+void escribirEstadisticasCSV(std::ostream& salida, const std::string& algoritmo,
+                             const EstadisticasBusqueda& estadisticas, bool encontrada, double tiempoMs);
+
+// Función que escribe un objeto JSON con las métricas de una consulta
+void escribirEstadisticasJSON(std::ostream& salida, const std::string& algoritmo,
+                              const EstadisticasBusqueda& estadisticas, bool encontrada, double tiempoMs);
@@ -0,0 +1,110 @@
+#include <fstream>
+#include <sstream>
+#include "entidades.h"
+#include "movingai.h"
+
+// Función que lee un mapa MovingAI; devuelve false si el archivo no existe o no es válido
+bool cargarMapaMovingAI(const std::string& archivo, MapaMovingAI& mapa) {
+    std::ifstream entrada(archivo);
+    if (!entrada) return false;
+    mapa = MapaMovingAI();
+    std::string clave;
+    while (entrada >> clave && clave != "map") {
+        if (clave == "height") entrada >> mapa.alto;
+        else if (clave == "width") entrada >> mapa.ancho;
+        else if (clave == "type") entrada >> clave; // Solo existe el tipo octile
+    }
+    if (clave != "map" || mapa.alto <= 0 || mapa.ancho <= 0) return false;
+
+    mapa.bloqueadas.assign((size_t)mapa.alto * mapa.ancho, 1);
+    std::string linea;
+    std::getline(entrada, linea); // Resto de la línea "map"
+    for (int i = 0; i < mapa.alto; i++) {
+        if (!std::getline(entrada, linea) || (int)linea.size() < mapa.ancho) return false;
+        for (int j = 0; j < mapa.ancho; j++) {
+            char c = linea[j];
+            mapa.bloqueadas[(size_t)i * mapa.ancho + j] = !(c == '.' || c == 'G' || c == 'S');
+        }
+    }
+    return true;
+}
+
+// Función que lee un archivo de escenarios MovingAI; cada línea tiene
+// "cubo mapa ancho alto xOrigen yOrigen xDestino yDestino longitudOptima"
+bool cargarEscenariosMovingAI(const std::string& archivo, std::vector<EscenarioMovingAI>& escenarios,
+                              std::string& archivoMapa) {
+    std::ifstream entrada(archivo);
+    if (!entrada) return false;
+    escenarios.clear();
+    archivoMapa.clear();
+    std::string linea;
+    while (std::getline(entrada, linea)) {
+        if (linea.empty() || linea.compare(0, 7, "version") == 0) continue;
+        std::istringstream campos(linea);
+        int cubo, ancho, alto;
+        std::string mapa;
+        EscenarioMovingAI escenario;
+        if (!(campos >> cubo >> mapa >> ancho >> alto >> escenario.columnaOrigen >> escenario.filaOrigen
+                     >> escenario.columnaDestino >> escenario.filaDestino >> escenario.longitudOptima)) {
+            return false;
+        }
+        if (archivoMapa.empty()) archivoMapa = mapa;
+        escenarios.push_back(escenario);
+    }
+    return !escenarios.empty();
+}
+
+// Función que guarda un mapa en formato MovingAI ('@' bloqueadas, '.' libres)
+bool guardarMapaMovingAI(const std::string& archivo, const MapaMovingAI& mapa) {
+    std::ofstream salida(archivo);
+    if (!salida) return false;
+    salida << "type octile\nheight " << mapa.alto << "\nwidth " << mapa.ancho << "\nmap\n";
+    std::string linea(mapa.ancho, '.');
+    for (int i = 0; i < mapa.alto; i++) {
+        for (int j = 0; j < mapa.ancho; j++) {
+            linea[j] = mapa.bloqueadas[(size_t)i * mapa.ancho + j] ? '@' : '.';
+        }
+        salida << linea << '\n';
+    }
+    return (bool)salida;
+}
+
+// Función que guarda consultas en formato de escenarios MovingAI; los cubos agrupan las consultas de diez
+// en diez como en los escenarios multiagente publicados
+bool guardarEscenariosMovingAI(const std::string& archivo, const std::string& archivoMapa, const MapaMovingAI& mapa,
+                               const std::vector<EscenarioMovingAI>& escenarios) {
+    std::ofstream salida(archivo);
+    if (!salida) return false;
+    salida << "version 1\n";
+    for (size_t k = 0; k < escenarios.size(); k++) {
+        const EscenarioMovingAI& e = escenarios[k];
+        salida << k / 10 << '\t' << archivoMapa << '\t' << mapa.ancho << '\t' << mapa.alto << '\t'
+               << e.columnaOrigen << '\t' << e.filaOrigen << '\t' << e.columnaDestino << '\t' << e.filaDestino << '\t'
+               << e.longitudOptima << '\n';
+    }
+    return (bool)salida;
+}
+
+// Método que copia las celdas bloqueadas de la grilla en un mapa MovingAI de sus dimensiones
+void Grid::exportarMapaMovingAI(MapaMovingAI& mapa) const {
+    mapa.alto = filas;
+    mapa.ancho = columnas;
+    mapa.bloqueadas.assign((size_t)filas * columnas, 0);
+    for (int i = 0; i < filas; i++) {
+        for (int j = 0; j < columnas; j++) {
+            mapa.bloqueadas[(size_t)i * columnas + j] = obtenerCelda(i, j).estado == BLOQUEADO;
+        }
+    }
+}
+
+// Método que copia las celdas bloqueadas de un mapa MovingAI de las mismas dimensiones
+void Grid::aplicarMapaMovingAI(const MapaMovingAI& mapa) {
+    reiniciar(true, true);
+    for (int i = 0; i < filas && i < mapa.alto; i++) {
+        for (int j = 0; j < columnas && j < mapa.ancho; j++) {
+            if (mapa.bloqueadas[(size_t)i * mapa.ancho + j]) {
+                obtenerCelda(i, j).estado = BLOQUEADO;
+            }
+        }
+    }
+}
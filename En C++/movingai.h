@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Mapa en formato MovingAI (.map): cabecera "type octile", "height", "width", "map" y una fila
+// de caracteres por línea. Son transitables '.', 'G' y 'S'; el resto ('@', 'O', 'T', 'W') se
+// trata como bloqueado porque la grilla no tiene costes por terreno.
+struct MapaMovingAI {
+    int alto = 0;
+    int ancho = 0;
+    std::vector<uint8_t> bloqueadas; // 1 si la celda (por filas) está bloqueada
+};
+
+// Consulta de un archivo de escenarios MovingAI (.scen); las columnas x e y del formato
+// corresponden a la columna y la fila de la grilla
+struct EscenarioMovingAI {
+    int filaOrigen;
+    int columnaOrigen;
+    int filaDestino;
+    int columnaDestino;
+    double longitudOptima; // Longitud óptima publicada (con movimientos diagonales)
+};
+
+// Función que guarda un mapa en formato MovingAI ('@' bloqueadas, '.' libres); devuelve false si no se puede escribir
+bool guardarMapaMovingAI(const std::string& archivo, const MapaMovingAI& mapa);
+
+// Función que guarda consultas en formato de escenarios MovingAI (versión 1), que es también el de los
+// problemas multiagente (MAPF): cada línea es un agente y un problema de k agentes usa las k primeras
+bool guardarEscenariosMovingAI(const std::string& archivo, const std::string& archivoMapa, const MapaMovingAI& mapa,
+                               const std::vector<EscenarioMovingAI>& escenarios);
+
+// Función que lee un mapa MovingAI; devuelve false si el archivo no existe o no es válido
+bool cargarMapaMovingAI(const std::string& archivo, MapaMovingAI& mapa);
+
+// Función que lee un archivo de escenarios MovingAI (versión 1) y devuelve en archivoMapa el mapa
+// que indica su primera consulta; devuelve false si el archivo no existe o no es válido
+bool cargarEscenariosMovingAI(const std::string& archivo, std::vector<EscenarioMovingAI>& escenarios,
+                              std::string& archivoMapa);
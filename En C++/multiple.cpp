@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <functional>
+#include "entidades.h"
+
+// Método que reconstruye la ruta de una búsqueda multiorigen hasta la raíz que la alcanzó y la marca
+void Grid::reconstruirRutaMultiple(Celda& destino, const MarcasCeldas& esRaiz, ResultadoMultiple& resultado) {
+    resultado.ruta.clear();
+    Celda* temp = &destino;
+    resultado.ruta.push_back(temp);
+    while (!esRaiz[indiceCelda(*temp)]) {
+        temp = &obtenerPadre(*temp); // Retrocedemos decodificando la dirección al padre
+        resultado.ruta.push_back(temp);
+    }
+    resultado.origen = temp; // La raíz alcanzada es el origen que ganó
+    std::reverse(resultado.ruta.begin(), resultado.ruta.end());
+    for (Celda* celda : resultado.ruta) {
+        // Aseguramos que no cambiamos los orígenes ni los destinos a "RUTA"
+        if (celda->estado != ORIGEN && celda->estado != DESTINO) {
+            celda->estado = RUTA;
+        }
+    }
+}
+
+// Función de búsqueda BFS con varios orígenes y varios destinos
+bool Grid::BFSMultiple(const std::vector<Celda*>& origenes, const std::vector<Celda*>& destinos, ResultadoMultiple& resultado) {
+    reiniciar();
+    estadisticas.reiniciar();
+    MedicionMemoria memoria;
+    resultado = ResultadoMultiple();
+
+    // Marcamos los destinos y los orígenes (raíces de la ruta) en vectores planos para comprobarlos en O(1)
+    MarcasCeldas esDestino((size_t)filas * columnas, false);
+    MarcasCeldas esRaiz((size_t)filas * columnas, false);
+    for (Celda* destino : destinos) {
+        esDestino[(size_t)destino->fila * columnas + destino->columna] = true;
+    }
+
+    // La frontera inicial contiene todos los orígenes a distancia 0
+    std::queue<Celda*, std::deque<Celda*, AsignadorContador<Celda*>>> cola;
+    for (Celda* origen : origenes) {
+        // Orígenes repetidos o bloqueados: como en BFS, una celda bloqueada nunca entra en la frontera
+        if (origen->visitado || origen->estado == BLOQUEADO) continue;
+        origen->visitado = true;
+        esRaiz[indiceCelda(*origen)] = true;
+        origen->g = 0;
+        cola.push(origen);
+        estadisticas.insercionesCola++;
+    }
+    estadisticas.registrarFrontera(cola.size());
+
+    Celda* encontrado = nullptr;
+    while (!cola.empty()) {
+        Celda* actual = cola.front();
+        cola.pop();
+        estadisticas.extraccionesCola++;
+
+        // El primer destino que sale de la cola es el más cercano a algún origen
+        if (esDestino[(size_t)actual->fila * columnas + actual->columna]) {
+            encontrado = actual;
+            break;
+        }
+        estadisticas.nodosExpandidos++;
+
+        for (int d = 0; d < 4; d++) {
+            int nuevaFila = actual->fila + DESPLAZAMIENTO_FLUJO[d][0];
+            int nuevaColumna = actual->columna + DESPLAZAMIENTO_FLUJO[d][1];
+            if (nuevaFila < 0 || nuevaFila >= filas || nuevaColumna < 0 || nuevaColumna >= columnas) continue;
+            // La vecina se alcanza con el desplazamiento precalculado de la disposición en memoria
+            Celda& vecino = vecinaDe(*actual, d);
+            if (vecino.visitado || vecino.estado == BLOQUEADO) continue;
+            vecino.visitado = true;
+            asignarPadre(vecino, *actual);
+            vecino.g = actual->g + 1;
+            cola.push(&vecino);
+            estadisticas.nodosGenerados++;
+            estadisticas.insercionesCola++;
+        }
+        estadisticas.registrarFrontera(cola.size());
+    }
+
+    estadisticas.bytesAuxiliares = memoria.bytesPico();
+    estadisticas.bytesVivos = memoria.bytesVivos();
+    estadisticas.asignaciones = memoria.asignaciones();
+    if (encontrado == nullptr) return false;
+
+    resultado.destino = encontrado;
+    resultado.coste = encontrado->g;
+    reconstruirRutaMultiple(*encontrado, esRaiz, resultado);
+    estadisticas.longitudRuta = resultado.ruta.size() - 1;
+    return true;
+}
+
+// Función de búsqueda Dijkstra con varios orígenes y varios destinos
+bool Grid::DijkstraMultiple(const std::vector<Celda*>& origenes, const std::vector<CosteBusqueda>& costesIniciales,
+                            const std::vector<Celda*>& destinos, ResultadoMultiple& resultado) {
+    reiniciar();
+    estadisticas.reiniciar();
+    MedicionMemoria memoria;
+    resultado = ResultadoMultiple();
+
+    MarcasCeldas esDestino((size_t)filas * columnas, false);
+    MarcasCeldas esRaiz((size_t)filas * columnas, false);
+    for (Celda* destino : destinos) {
+        esDestino[(size_t)destino->fila * columnas + destino->columna] = true;
+    }
+
+    // Montículo mínimo por coste acumulado; cada entrada es la clave empaquetada (coste, índice de la celda),
+    // así que se ordena con una comparación entera. Las entradas obsoletas se descartan al extraerlas
+    std::priority_queue<uint64_t, std::vector<uint64_t, AsignadorContador<uint64_t>>, std::greater<uint64_t>> cola;
+    for (size_t k = 0; k < origenes.size(); k++) {
+        if (origenes[k]->estado == BLOQUEADO) continue; // Como en BFS, una celda bloqueada no es raíz
+        CosteBusqueda costeInicial = k < costesIniciales.size() ? costesIniciales[k] : 0;
+        if (costeInicial < origenes[k]->g) {
+            origenes[k]->g = costeInicial;
+            origenes[k]->visitado = true;
+            esRaiz[indiceCelda(*origenes[k])] = true;
+            cola.push(claveCola(costeInicial, indiceCelda(*origenes[k])));
+            estadisticas.insercionesCola++;
+        }
+    }
+    estadisticas.registrarFrontera(cola.size());
+
+    Celda* encontrado = nullptr;
+    while (!cola.empty()) {
+        uint64_t entrada = cola.top();
+        cola.pop();
+        estadisticas.extraccionesCola++;
+        int indice = (int)(entrada & 0xFFFFFFFFu);
+        Celda* actual = &obtenerCelda(indice / columnas, indice % columnas);
+        if ((CosteBusqueda)(entrada >> 32) > actual->g) continue; // Entrada obsoleta: la celda ya salió con menor coste
+
+        if (esDestino[(size_t)actual->fila * columnas + actual->columna]) {
+            encontrado = actual;
+            break;
+        }
+        estadisticas.nodosExpandidos++;
+
+        for (int d = 0; d < 4; d++) {
+            int nuevaFila = actual->fila + DESPLAZAMIENTO_FLUJO[d][0];
+            int nuevaColumna = actual->columna + DESPLAZAMIENTO_FLUJO[d][1];
+            if (nuevaFila < 0 || nuevaFila >= filas || nuevaColumna < 0 || nuevaColumna >= columnas) continue;
+            Celda& vecino = vecinaDe(*actual, d);
+            if (vecino.estado == BLOQUEADO) continue;
+            estadisticas.nodosGenerados++;
+            CosteBusqueda nuevoG = actual->g + 1; // Coste unitario entre celdas vecinas
+            if (nuevoG < vecino.g) {
+                vecino.g = nuevoG;
+                vecino.visitado = true;
+                esRaiz[indiceCelda(vecino)] = false; // Un origen alcanzado más barato desde otro deja de ser raíz
+                asignarPadre(vecino, *actual);
+                cola.push(claveCola(nuevoG, indiceCelda(vecino)));
+                estadisticas.insercionesCola++;
+            }
+        }
+        estadisticas.registrarFrontera(cola.size());
+    }
+
+    estadisticas.bytesAuxiliares = memoria.bytesPico();
+    estadisticas.bytesVivos = memoria.bytesVivos();
+    estadisticas.asignaciones = memoria.asignaciones();
+    if (encontrado == nullptr) return false;
+
+    resultado.destino = encontrado;
+    resultado.coste = encontrado->g;
+    reconstruirRutaMultiple(*encontrado, esRaiz, resultado);
+    estadisticas.longitudRuta = resultado.ruta.size() - 1;
+    return true;
+}
@@ -0,0 +1,53 @@
+#!/bin/sh
+# Optimización guiada por perfil (PGO) del núcleo de búsqueda, guiada por los escenarios del benchmark.
+#   1. Compila en Release y mide la carga (referencia sin PGO).
+#   2. Compila instrumentado (preset pgo-generar) y ejecuta la misma carga para recoger el perfil.
+#   3. Recompila con el perfil (preset pgo-usar) y vuelve a medir.
+#   4. Escribe en build/informe_pgo.txt la latencia media por caso con y sin PGO.
+# Uso:
+#   ./pgo.sh                       carga de mapas generados con BFS y D* Lite
+#   ./pgo.sh mapas/arena.map.scen  carga de un archivo de escenarios MovingAI (y su mapa)
+# Se pueden añadir argumentos del benchmark con la variable CARGA_EXTRA (por ejemplo, --repeticiones=9).
+set -e
+cd "$(dirname "$0")"
+
+CARGA="--algoritmos=BFS,DStarLite --repeticiones=5"
+if [ -n "$1" ]; then
+    CARGA="$CARGA --escenarios=$1"
+else
+    CARGA="$CARGA --tamanos=128,256 --generadores=abierto,aleatorio,laberinto,habitaciones,perlin --densidades=0.3"
+fi
+CARGA="$CARGA $CARGA_EXTRA"
+PERFIL=build/perfil
+
+echo "== Referencia sin PGO =="
+cmake --preset release
+cmake --build --preset release
+./build/release/benchmark $CARGA --json=build/sin_pgo.json
+
+echo "== Compilacion instrumentada y entrenamiento =="
+rm -rf "$PERFIL"
+cmake --preset pgo-generar
+cmake --build --preset pgo-generar --clean-first
+./build/pgo/benchmark $CARGA > /dev/null
+# Clang escribe perfiles .profraw que hay que fusionar; GCC lee directamente los .gcda
+if ls "$PERFIL"/*.profraw > /dev/null 2>&1; then
+    llvm-profdata merge -output="$PERFIL/pathfinder.profdata" "$PERFIL"/*.profraw
+fi
+
+echo "== Compilacion con el perfil =="
+cmake --preset pgo-usar
+cmake --build --preset pgo-usar --clean-first
+./build/pgo/benchmark $CARGA --json=build/con_pgo.json
+
+# Informe: media por caso ("<caso>_mean" en el JSON) y mejora relativa
+medias() {
+    awk '/"name":/ { nombre = $2; gsub(/[",]/, "", nombre) }
+         /"real_time":/ && nombre ~ /_mean$/ { tiempo = $2; gsub(/,/, "", tiempo); sub(/_mean$/, "", nombre); print nombre, tiempo }' "$1"
+}
+medias build/sin_pgo.json | sort > build/sin_pgo.txt
+medias build/con_pgo.json | sort > build/con_pgo.txt
+join build/sin_pgo.txt build/con_pgo.txt | awk '
+    BEGIN { printf "%-68s %14s %14s %9s\n", "Caso", "Sin PGO ms", "Con PGO ms", "Mejora" }
+    { printf "%-68s %14.4f %14.4f %8.1f%%\n", $1, $2, $3, ($2 > 0 ? 100 * ($2 - $3) / $2 : 0) }' | tee build/informe_pgo.txt
+echo "Informe escrito en build/informe_pgo.txt"
@@ -0,0 +1,1130 @@
+// Pruebas del núcleo (sin interfaz gráfica). Cada prueba se ejecuta por separado desde ctest:
+//   pruebas <nombre>    ejecuta una prueba
+//   pruebas             ejecuta todas
+// Comparan los motores con la longitud de ruta de BFS (sin reutilizar árboles) en mapas aleatorios con
+// semilla fija, en todas las disposiciones en memoria, y comprueban las garantías de cada algoritmo.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "entidades.h"
+#include "cache.h"
+
+// Fallos acumulados por la prueba en curso
+static int fallos = 0;
+
+// Macro que registra un fallo con su contexto sin detener la prueba
+#define COMPROBAR(condicion, contexto)                                                                  \
+    do {                                                                                              \
+        if (!(condicion)) {                                                                           \
+            fallos++;                                                                                 \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": falla " #condicion " (" << contexto << ")" \
+                      << std::endl;                                                                   \
+        }                                                                                             \
+    } while (0)
+
+const DisposicionMemoria DISPOSICIONES[] = {DISPOSICION_FILAS, DISPOSICION_MOSAICO, DISPOSICION_MORTON};
+const char* NOMBRES_DISPOSICION[] = {"filas", "mosaico", "morton"};
+const uint64_t SEMILLAS[] = {1, 7, 42};
+const int LADO_MAPA = 48;
+const double DENSIDAD_MAPA = 0.3;
+const int CONSULTAS_POR_MAPA = 40;
+
+// Función que devuelve el índice de una celda libre al azar (-1 si no encuentra ninguna)
+static int celdaLibreAlAzar(const Grid& grid, std::mt19937_64& azar) {
+    int total = grid.obtenerFilas() * grid.obtenerColumnas();
+    for (int intento = 0; intento < 64; intento++) {
+        int indice = (int)(azar() % (uint64_t)total);
+        if (grid.obtenerCelda(indice / grid.obtenerColumnas(), indice % grid.obtenerColumnas()).estado != BLOQUEADO) {
+            return indice;
+        }
+    }
+    return -1;
+}
+
+// Función que devuelve la celda de un índice por filas
+static Celda& celdaDe(Grid& grid, int indice) {
+    return grid.obtenerCelda(indice / grid.obtenerColumnas(), indice % grid.obtenerColumnas());
+}
+
+// Función que devuelve la longitud de la ruta óptima según BFS (-1 si no hay ruta)
+static long longitudBFS(Grid& grid, int origen, int destino) {
+    grid.activarReutilizacionArboles(false);
+    if (!grid.BFS(celdaDe(grid, origen), celdaDe(grid, destino))) return -1;
+    return (long)grid.obtenerEstadisticas().longitudRuta;
+}
+
+// Función que compara un motor con BFS en mapas aleatorios de todas las disposiciones; preparar construye
+// el preproceso del motor y devuelve false si no queda sincronizado con el mapa
+template <typename Preparar, typename Buscar>
+static void compararConBFS(const char* motor, Preparar preparar, Buscar buscar) {
+    for (int d = 0; d < 3; d++) {
+        for (uint64_t semilla : SEMILLAS) {
+            Grid grid(LADO_MAPA, LADO_MAPA, DISPOSICIONES[d]);
+            grid.generarObstaculosAleatorios(DENSIDAD_MAPA, semilla);
+            COMPROBAR(preparar(grid), motor << " sin sincronizar en " << NOMBRES_DISPOSICION[d]);
+            std::mt19937_64 azar(semilla);
+            for (int consulta = 0; consulta < CONSULTAS_POR_MAPA; consulta++) {
+                int origen = celdaLibreAlAzar(grid, azar), destino = celdaLibreAlAzar(grid, azar);
+                if (origen < 0 || destino < 0) continue;
+                long esperada = longitudBFS(grid, origen, destino);
+                bool encontrada = buscar(grid, celdaDe(grid, origen), celdaDe(grid, destino));
+                long obtenida = encontrada ? (long)grid.obtenerEstadisticas().longitudRuta : -1;
+                COMPROBAR(obtenida == esperada, motor << " en " << NOMBRES_DISPOSICION[d] << ", semilla " << semilla
+                          << ", " << origen << " -> " << destino << ": " << obtenida << " frente a " << esperada);
+            }
+        }
+    }
+}
+
+// Prueba del grafo de subobjetivos
+static void probarSubobjetivos() {
+    GrafoSubobjetivos grafo;
+    compararConBFS("Subobjetivos", [&](Grid& grid) { grafo.construir(grid); return grafo.sincronizado(grid); },
+                   [&](Grid& grid, Celda& origen, Celda& destino) { return grid.buscarConSubobjetivos(grafo, origen, destino); });
+}
+
+// Prueba de la jerarquía de contracción
+static void probarJerarquia() {
+    JerarquiaContraccion jerarquia;
+    compararConBFS("Jerarquia", [&](Grid& grid) { jerarquia.construir(grid); return jerarquia.sincronizada(grid); },
+                   [&](Grid& grid, Celda& origen, Celda& destino) { return grid.buscarConJerarquia(jerarquia, origen, destino); });
+}
+
+// Prueba de la base de caminos comprimida
+static void probarBaseCaminos() {
+    BaseCaminos base;
+    compararConBFS("BaseCaminos", [&](Grid& grid) { base.construir(grid); return base.sincronizada(grid); },
+                   [&](Grid& grid, Celda& origen, Celda& destino) { return grid.buscarConBaseCaminos(base, origen, destino); });
+}
+
+// Prueba de D* Lite con cada política de desempate
+static void probarDStarLite() {
+    const PoliticaDesempate politicas[] = {DESEMPATE_NINGUNO, DESEMPATE_FIFO, DESEMPATE_LIFO, DESEMPATE_MENOR_H,
+                                           DESEMPATE_MENOR_H_LIFO};
+    for (PoliticaDesempate politica : politicas) {
+        compararConBFS("DStarLite", [](Grid&) { return true; }, [&](Grid& grid, Celda& origen, Celda& destino) {
+            grid.establecerDesempate(politica);
+            return grid.DStarLite(origen, destino);
+        });
+    }
+}
+
+// Prueba de la actualización incremental del grafo de subobjetivos frente a reconstruirlo desde cero
+static void probarActualizacionSubobjetivos() {
+    for (int d = 0; d < 3; d++) {
+        for (uint64_t semilla : SEMILLAS) {
+            Grid grid(LADO_MAPA, LADO_MAPA, DISPOSICIONES[d]);
+            grid.generarObstaculosAleatorios(DENSIDAD_MAPA, semilla);
+            GrafoSubobjetivos incremental;
+            incremental.construir(grid);
+            std::mt19937_64 azar(semilla);
+            for (int edicion = 0; edicion < 200; edicion++) {
+                int fila = (int)(azar() % LADO_MAPA), columna = (int)(azar() % LADO_MAPA);
+                bool bloquear = grid.obtenerCelda(fila, columna).estado != BLOQUEADO;
+                grid.editarCelda(fila, columna, bloquear ? BLOQUEADO : VACIO);
+                incremental.actualizarCelda(grid, fila, columna);
+            }
+            COMPROBAR(incremental.sincronizado(grid), "grafo incremental sin sincronizar");
+
+            GrafoSubobjetivos completo;
+            completo.construir(grid);
+            COMPROBAR(incremental.numeroSubobjetivos() == completo.numeroSubobjetivos(),
+                      incremental.numeroSubobjetivos() << " subobjetivos frente a " << completo.numeroSubobjetivos());
+            COMPROBAR(incremental.numeroAristas() == completo.numeroAristas(),
+                      incremental.numeroAristas() << " aristas frente a " << completo.numeroAristas());
+            // Mismos subobjetivos y, para cada uno, las mismas celdas vecinas en el grafo
+            for (int indice = 0; indice < LADO_MAPA * LADO_MAPA; indice++) {
+                int idIncremental = incremental.identificador(indice), idCompleto = completo.identificador(indice);
+                COMPROBAR((idIncremental >= 0) == (idCompleto >= 0), "subobjetivo distinto en la celda " << indice);
+                if (idIncremental < 0 || idCompleto < 0) continue;
+                std::vector<int> vecinasIncremental, vecinasCompleto;
+                for (int id : incremental.vecinos(idIncremental)) vecinasIncremental.push_back(incremental.celdaDe(id));
+                for (int id : completo.vecinos(idCompleto)) vecinasCompleto.push_back(completo.celdaDe(id));
+                std::sort(vecinasIncremental.begin(), vecinasIncremental.end());
+                std::sort(vecinasCompleto.begin(), vecinasCompleto.end());
+                COMPROBAR(vecinasIncremental == vecinasCompleto, "aristas distintas en la celda " << indice);
+            }
+
+            // Y las consultas sobre el grafo actualizado siguen siendo óptimas
+            for (int consulta = 0; consulta < CONSULTAS_POR_MAPA; consulta++) {
+                int origen = celdaLibreAlAzar(grid, azar), destino = celdaLibreAlAzar(grid, azar);
+                if (origen < 0 || destino < 0) continue;
+                long esperada = longitudBFS(grid, origen, destino);
+                bool encontrada = grid.buscarConSubobjetivos(incremental, celdaDe(grid, origen), celdaDe(grid, destino));
+                long obtenida = encontrada ? (long)grid.obtenerEstadisticas().longitudRuta : -1;
+                COMPROBAR(obtenida == esperada, "Subobjetivos tras ediciones, " << origen << " -> " << destino);
+            }
+        }
+    }
+}
+
+// Prueba de la reutilización de árboles de BFS en un pasillo O-A-D-B: la búsqueda de D se detiene al sacar
+// el destino con la cola vacía, así que el árbol guardado no llega a B y no puede afirmar que B es inalcanzable
+static void probarArbolPasillo() {
+    for (bool reutilizar : {false, true}) {
+        Grid grid(1, 4);
+        grid.activarReutilizacionArboles(reutilizar);
+        COMPROBAR(grid.BFS(grid.obtenerCelda(0, 0), grid.obtenerCelda(0, 2)), "O -> D con reutilización " << reutilizar);
+        bool encontrada = grid.BFS(grid.obtenerCelda(0, 0), grid.obtenerCelda(0, 3));
+        COMPROBAR(encontrada, "O -> B con reutilización " << reutilizar);
+        COMPROBAR(grid.obtenerEstadisticas().longitudRuta == 3, "longitud O -> B con reutilización " << reutilizar);
+    }
+    // Con el árbol completo (la búsqueda vació la cola), un destino bloqueado sí se responde desde el árbol
+    Grid grid(1, 4);
+    grid.editarCelda(0, 2, BLOQUEADO);
+    grid.activarReutilizacionArboles(true);
+    COMPROBAR(!grid.BFS(grid.obtenerCelda(0, 0), grid.obtenerCelda(0, 3)), "O -> B con el pasillo cortado");
+    COMPROBAR(grid.BFS(grid.obtenerCelda(0, 0), grid.obtenerCelda(0, 1)), "O -> A con el pasillo cortado");
+}
+
+// Función que elige extremos distintos para cada agente en las celdas libres del mapa
+static std::vector<std::pair<int, int>> extremosAgentes(const Grid& grid, int agentes, std::mt19937_64& azar) {
+    std::vector<char> origenUsado((size_t)grid.obtenerFilas() * grid.obtenerColumnas(), 0);
+    std::vector<char> destinoUsado(origenUsado.size(), 0);
+    std::vector<std::pair<int, int>> extremos;
+    for (int k = 0; k < agentes * 8 && (int)extremos.size() < agentes; k++) {
+        int origen = celdaLibreAlAzar(grid, azar), destino = celdaLibreAlAzar(grid, azar);
+        if (origen < 0 || destino < 0 || origenUsado[origen] || destinoUsado[destino]) continue;
+        origenUsado[origen] = destinoUsado[destino] = 1;
+        extremos.push_back({origen, destino});
+    }
+    return extremos;
+}
+
+// Prueba de WHCA*: el plan con reservas espacio-tiempo no tiene choques de vértice ni intercambios
+static void probarCooperativo() {
+    for (uint64_t semilla : SEMILLAS) {
+        Grid grid(32, 32);
+        grid.generarObstaculosAleatorios(0.15, semilla);
+        std::mt19937_64 azar(semilla);
+        std::vector<std::pair<int, int>> extremos = extremosAgentes(grid, 20, azar);
+        PlanificadorCooperativo planificador;
+        planificador.configurar(16, 8);
+        for (const auto& extremo : extremos) planificador.agregarAgente(extremo.first, extremo.second);
+        planificador.resolver(grid, 4 * 32);
+        std::vector<std::vector<int>> trayectorias;
+        for (size_t a = 0; a < planificador.numeroAgentes(); a++) trayectorias.push_back(planificador.trayectoria((int)a));
+        COMPROBAR(contarChoques(grid, trayectorias) == 0, "choques de WHCA*, semilla " << semilla);
+        for (size_t a = 0; a < trayectorias.size(); a++) {
+            COMPROBAR(!trayectorias[a].empty() && trayectorias[a].front() == extremos[a].first,
+                      "WHCA*: agente " << a << " no sale de su origen");
+        }
+    }
+}
+
+// Función que comprueba que cada trayectoria empieza en su origen y termina en su destino
+static void comprobarExtremos(const char* solver, const std::vector<std::vector<int>>& trayectorias,
+                              const std::vector<std::pair<int, int>>& extremos) {
+    for (size_t a = 0; a < trayectorias.size(); a++) {
+        COMPROBAR(!trayectorias[a].empty(), solver << ": agente " << a << " sin trayectoria");
+        if (trayectorias[a].empty()) continue;
+        COMPROBAR(trayectorias[a].front() == extremos[a].first, solver << ": agente " << a << " no sale de su origen");
+        COMPROBAR(trayectorias[a].back() == extremos[a].second, solver << ": agente " << a << " no llega a su destino");
+    }
+}
+
+// Prueba de CBS/ECBS: las trayectorias no tienen choques de vértice ni intercambios, y un problema con
+// extremos repetidos se rechaza al registrar los agentes en lugar de agotar los límites
+static void probarConflictos() {
+    SolverConflictos solver(2);
+    for (uint64_t semilla : SEMILLAS) {
+        Grid grid(24, 24);
+        grid.generarObstaculosAleatorios(0.15, semilla);
+        std::mt19937_64 azar(semilla);
+        std::vector<std::pair<int, int>> extremos = extremosAgentes(grid, 12, azar);
+        // Quitamos los agentes sin ruta individual: con ellos el problema no tiene solución
+        extremos.erase(std::remove_if(extremos.begin(), extremos.end(), [&](const std::pair<int, int>& extremo) {
+            return longitudBFS(grid, extremo.first, extremo.second) < 0;
+        }), extremos.end());
+        for (double peso : {1.0, 1.5}) {
+            solver.configurar(peso, 0, 10000);
+            solver.vaciarAgentes();
+            for (const auto& extremo : extremos) solver.agregarAgente(extremo.first, extremo.second);
+            bool resuelto = solver.resolver(grid);
+            COMPROBAR(resuelto, "CBS con peso " << peso << ", semilla " << semilla);
+            if (!resuelto) continue;
+            std::vector<std::vector<int>> trayectorias;
+            for (size_t a = 0; a < solver.numeroAgentes(); a++) trayectorias.push_back(solver.trayectoria((int)a));
+            COMPROBAR(contarChoques(grid, trayectorias) == 0, "choques de CBS con peso " << peso << ", semilla " << semilla);
+            comprobarExtremos("CBS", trayectorias, extremos);
+        }
+    }
+
+    Grid grid(8, 8);
+    solver.configurar(1.0);
+    for (bool repetirOrigen : {true, false}) {
+        solver.vaciarAgentes();
+        COMPROBAR(solver.agregarAgente(0, 63) == 0, "primer agente");
+        int repetido = repetirOrigen ? solver.agregarAgente(0, 62) : solver.agregarAgente(1, 63);
+        COMPROBAR(repetido == -1, "agente con " << (repetirOrigen ? "origen" : "destino") << " repetido aceptado");
+        COMPROBAR(!solver.resolver(grid), "problema con extremos repetidos resuelto");
+        COMPROBAR(solver.obtenerEstadisticas().nodosGenerados == 0, "se buscó con extremos repetidos");
+    }
+    solver.vaciarAgentes();
+    solver.agregarAgente(0, 63);
+    solver.agregarAgente(7, 56);
+    COMPROBAR(solver.resolver(grid), "vaciarAgentes no borra la marca de extremos repetidos");
+}
+
+// Prueba de ARA* hasta epsilon 1 (ruta óptima), marcando y sin marcar la grilla
+static void probarARAStar() {
+    for (bool marcar : {true, false}) {
+        ConfiguracionAnytime configuracion;
+        configuracion.marcarEnGrilla = marcar;
+        compararConBFS("ARAStar", [](Grid&) { return true; }, [&](Grid& grid, Celda& origen, Celda& destino) {
+            ResultadoAnytime resultado;
+            return grid.ARAStar(origen, destino, std::chrono::steady_clock::time_point::max(), configuracion, resultado);
+        });
+    }
+}
+
+// Prueba de la cota de suboptimalidad que publica ARA*: toda solución cuesta a lo sumo cota * óptimo. Con el
+// plazo ya vencido la consulta o no publica nada (cota infinita) o devuelve una ruta completa con su cota.
+static void probarCotaARAStar() {
+    const double epsilonesFinales[] = {1.0, 1.5, 3.0};
+    for (int d = 0; d < 3; d++) {
+        for (uint64_t semilla : SEMILLAS) {
+            Grid grid(LADO_MAPA, LADO_MAPA, DISPOSICIONES[d]);
+            grid.generarObstaculosAleatorios(DENSIDAD_MAPA, semilla);
+            std::mt19937_64 azar(semilla);
+            for (int consulta = 0; consulta < CONSULTAS_POR_MAPA; consulta++) {
+                int origen = celdaLibreAlAzar(grid, azar), destino = celdaLibreAlAzar(grid, azar);
+                if (origen < 0 || destino < 0) continue;
+                long optima = longitudBFS(grid, origen, destino);
+                for (double epsilonFinal : epsilonesFinales) {
+                    ConfiguracionAnytime configuracion;
+                    configuracion.epsilonFinal = epsilonFinal;
+                    configuracion.marcarEnGrilla = false;
+                    ResultadoAnytime resultado;
+                    bool encontrada = grid.ARAStar(celdaDe(grid, origen), celdaDe(grid, destino),
+                                                   std::chrono::steady_clock::time_point::max(), configuracion, resultado);
+                    COMPROBAR(encontrada == (optima >= 0), "ARA* " << origen << " -> " << destino);
+                    if (!encontrada || optima < 0) continue;
+                    COMPROBAR(resultado.cota >= 1.0 && resultado.cota <= epsilonFinal + 1e-9,
+                              "cota " << resultado.cota << " con epsilon final " << epsilonFinal);
+                    COMPROBAR(resultado.coste <= resultado.cota * optima + 1e-9,
+                              "coste " << resultado.coste << ", cota " << resultado.cota << ", óptimo " << optima);
+                    COMPROBAR(resultado.ruta.size() == (size_t)resultado.coste + 1, "ruta de ARA* incompleta");
+                    for (const MejoraAnytime& mejora : resultado.mejoras) {
+                        COMPROBAR(mejora.coste <= mejora.cota * optima + 1e-9,
+                                  "mejora de coste " << mejora.coste << " con cota " << mejora.cota << ", óptimo " << optima);
+                    }
+                }
+
+                ConfiguracionAnytime configuracion;
+                configuracion.marcarEnGrilla = false;
+                ResultadoAnytime resultado;
+                bool encontrada = grid.ARAStar(celdaDe(grid, origen), celdaDe(grid, destino),
+                                               std::chrono::steady_clock::now(), configuracion, resultado);
+                if (!encontrada) {
+                    COMPROBAR(std::isinf(resultado.cota) && resultado.mejoras.empty() && resultado.ruta.empty(),
+                              "ARA* sin ruta publicada con cota " << resultado.cota);
+                } else if (optima >= 0) {
+                    COMPROBAR(resultado.ruta.size() == (size_t)resultado.coste + 1 && resultado.ruta.front() == origen
+                                  && resultado.ruta.back() == destino,
+                              "ruta de ARA* con el plazo vencido " << origen << " -> " << destino);
+                    COMPROBAR(resultado.coste <= resultado.cota * optima + 1e-9,
+                              "coste " << resultado.coste << ", cota " << resultado.cota << ", óptimo " << optima);
+                }
+            }
+        }
+    }
+}
+
+// Prueba de la caché de rutas: aciertos y fallos, expulsión LRU al superar el límite de memoria y
+// notificarBloqueo, que descarta solo las rutas que cruzan la celda y pasa las demás a la nueva versión
+// (y descarta las de versiones anteriores)
+static void probarCacheRutas() {
+    const std::vector<int> rutas[] = {{0, 1, 2, 3}, {4, 5, 6, 7}, {8, 9, 10, 11}};
+    bool existe = false;
+    std::vector<int> ruta;
+
+    // Capacidad para dos entradas de cuatro celdas: la tercera expulsa la menos usada
+    CacheRutas medida(SIZE_MAX);
+    medida.guardar(0, 0, 3, 1, true, rutas[0]);
+    size_t bytesEntrada = medida.obtenerEstadisticas().bytesUsados;
+    CacheRutas cache(2 * bytesEntrada);
+    cache.guardar(0, 0, 3, 1, true, rutas[0]);
+    cache.guardar(0, 4, 7, 1, true, rutas[1]);
+    COMPROBAR(cache.buscar(0, 0, 3, 1, existe, ruta) && existe && ruta == rutas[0], "acierto de la ruta 0 -> 3");
+    COMPROBAR(!cache.buscar(1, 0, 3, 1, existe, ruta), "el algoritmo forma parte de la clave");
+    COMPROBAR(!cache.buscar(0, 0, 3, 2, existe, ruta), "la versión forma parte de la clave");
+    cache.guardar(0, 8, 11, 1, true, rutas[2]); // 4 -> 7 es la menos usada
+    EstadisticasCache estadisticas = cache.obtenerEstadisticas();
+    COMPROBAR(estadisticas.aciertos == 1 && estadisticas.fallos == 2,
+              "aciertos " << estadisticas.aciertos << ", fallos " << estadisticas.fallos);
+    COMPROBAR(estadisticas.expulsiones == 1 && estadisticas.entradas == 2 && estadisticas.bytesUsados <= 2 * bytesEntrada,
+              "expulsiones " << estadisticas.expulsiones << ", entradas " << estadisticas.entradas);
+    COMPROBAR(!cache.buscar(0, 4, 7, 1, existe, ruta), "la entrada menos usada sigue en caché");
+    COMPROBAR(cache.buscar(0, 0, 3, 1, existe, ruta) && cache.buscar(0, 8, 11, 1, existe, ruta),
+              "se expulsó una entrada usada recientemente");
+
+    // Sin ruta también se guarda
+    CacheRutas grande(SIZE_MAX);
+    grande.guardar(0, 12, 13, 1, false, {});
+    COMPROBAR(grande.buscar(0, 12, 13, 1, existe, ruta) && !existe && ruta.empty(), "entrada sin ruta");
+
+    // Bloquear la celda 5 invalida solo la ruta que la cruza; las demás siguen válidas en la versión 2
+    for (int i = 0; i < 3; i++) grande.guardar(0, rutas[i].front(), rutas[i].back(), 1, true, rutas[i]);
+    grande.notificarBloqueo(5, 1, 2);
+    COMPROBAR(!grande.buscar(0, 4, 7, 2, existe, ruta), "la ruta que cruza la celda bloqueada sigue en caché");
+    for (int i : {0, 2}) {
+        COMPROBAR(grande.buscar(0, rutas[i].front(), rutas[i].back(), 2, existe, ruta) && ruta == rutas[i],
+                  "la ruta " << rutas[i].front() << " -> " << rutas[i].back() << " no pasó a la versión 2");
+        COMPROBAR(!grande.buscar(0, rutas[i].front(), rutas[i].back(), 1, existe, ruta),
+                  "la ruta " << rutas[i].front() << " -> " << rutas[i].back() << " sigue en la versión 1");
+    }
+    estadisticas = grande.obtenerEstadisticas();
+    COMPROBAR(estadisticas.invalidaciones == 1 && estadisticas.entradas == 3,
+              "invalidaciones " << estadisticas.invalidaciones << ", entradas " << estadisticas.entradas);
+
+    // Un bloqueo posterior descarta las entradas que se quedaron en versiones anteriores
+    grande.guardar(0, 20, 21, 1, true, {20, 21});
+    grande.notificarBloqueo(30, 2, 3);
+    COMPROBAR(!grande.buscar(0, 20, 21, 1, existe, ruta), "sigue en caché una entrada de una versión superada");
+    estadisticas = grande.obtenerEstadisticas();
+    COMPROBAR(estadisticas.entradas == 3, "entradas tras descartar la versión superada: " << estadisticas.entradas);
+
+    grande.vaciar();
+    estadisticas = grande.obtenerEstadisticas();
+    COMPROBAR(estadisticas.entradas == 0 && estadisticas.bytesUsados == 0, "la caché no quedó vacía");
+}
+
+// Función que lee un archivo binario completo
+static std::string leerArchivo(const std::string& nombre) {
+    std::ifstream entrada(nombre, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(entrada), std::istreambuf_iterator<char>());
+}
+
+// Función que escribe un archivo binario completo
+static void escribirArchivo(const std::string& nombre, const std::string& contenido) {
+    std::ofstream salida(nombre, std::ios::binary | std::ios::trunc);
+    salida.write(contenido.data(), (std::streamsize)contenido.size());
+}
+
+// Función que sobrescribe un valor dentro del contenido de un archivo binario
+template <typename T>
+static std::string parchear(std::string contenido, size_t posicion, T valor) {
+    std::memcpy(&contenido[posicion], &valor, sizeof(T));
+    return contenido;
+}
+
+// Prueba del archivo de la base de caminos: guardar y cargar conserva las rutas, guardar sin base no toca
+// el archivo y cargar rechaza archivos con índices de celda repetidos o fuera de rango, filas de tramos
+// desordenadas y movimientos que salen de la grilla o entran en una celda bloqueada
+static void probarArchivoBaseCaminos() {
+    const std::string nombre = "prueba_basecaminos.cpd";
+    BaseCaminos vacia;
+    escribirArchivo(nombre, "contenido previo");
+    COMPROBAR(!vacia.guardar(nombre) && leerArchivo(nombre) == "contenido previo", "guardar sin base tocó el archivo");
+
+    Grid grid(32, 32);
+    grid.generarObstaculosAleatorios(DENSIDAD_MAPA, 7);
+    BaseCaminos base;
+    base.construir(grid);
+    COMPROBAR(base.guardar(nombre), "no se pudo guardar la base");
+    BaseCaminos cargada;
+    COMPROBAR(cargada.cargar(nombre, grid) && cargada.sincronizada(grid), "no se pudo cargar la base guardada");
+    std::mt19937_64 azar(7);
+    for (int consulta = 0; consulta < CONSULTAS_POR_MAPA; consulta++) {
+        int origen = celdaLibreAlAzar(grid, azar), destino = celdaLibreAlAzar(grid, azar);
+        if (origen < 0 || destino < 0) continue;
+        std::vector<int> ruta;
+        long esperada = longitudBFS(grid, origen, destino);
+        bool encontrada = cargada.extraerRuta(origen, destino, ruta);
+        COMPROBAR(encontrada == (esperada >= 0) && (!encontrada || (long)ruta.size() - 1 == esperada),
+                  "base cargada: " << origen << " -> " << destino << ", " << ruta.size() << " celdas frente a " << esperada);
+    }
+
+    // Cabecera: firma, formato, filas, columnas (4 bytes cada uno), huella, nodos y tramos (8 bytes cada uno)
+    std::string original = leerArchivo(nombre);
+    const size_t cabecera = 40;
+    uint64_t nodos = 0, totalTramos = 0;
+    std::memcpy(&nodos, &original[24], sizeof(nodos));
+    std::memcpy(&totalTramos, &original[32], sizeof(totalTramos));
+    size_t celdaNodo = cabecera, inicioFila = cabecera + 2 * nodos * sizeof(int);
+    size_t tramos = inicioFila + (nodos + 1) * sizeof(uint64_t);
+    COMPROBAR(original.size() == tramos + totalTramos * sizeof(uint32_t), "tamaño del archivo " << original.size());
+    if (nodos < 2 || totalTramos < 2 || original.size() != tramos + totalTramos * sizeof(uint32_t)) return;
+
+    int primeraCelda = 0;
+    std::memcpy(&primeraCelda, &original[celdaNodo], sizeof(int));
+    uint32_t primerTramo = 0;
+    std::memcpy(&primerTramo, &original[tramos], sizeof(uint32_t));
+    // Movimiento desde la celda del nodo 0 que sale de la grilla o llega a una celda bloqueada (4 si no hay)
+    int fila = primeraCelda / 32, columna = primeraCelda % 32;
+    uint32_t movimientoInvalido = 4;
+    for (uint32_t d = 0; d < 4; d++) {
+        int nuevaFila = fila + DESPLAZAMIENTO_FLUJO[d][0], nuevaColumna = columna + DESPLAZAMIENTO_FLUJO[d][1];
+        if (nuevaFila < 0 || nuevaFila >= 32 || nuevaColumna < 0 || nuevaColumna >= 32
+            || grid.obtenerCelda(nuevaFila, nuevaColumna).estado == BLOQUEADO) {
+            movimientoInvalido = d;
+        }
+    }
+
+    struct Dano {
+        const char* descripcion;
+        std::string contenido;
+    };
+    std::vector<Dano> danos = {
+        {"celda fuera de rango", parchear(original, celdaNodo, (int)(32 * 32))},
+        {"celda negativa", parchear(original, celdaNodo, -1)},
+        {"celda repetida", parchear(original, celdaNodo + sizeof(int), primeraCelda)},
+        {"primer tramo desplazado", parchear(original, inicioFila, (uint64_t)1)},
+        {"filas desordenadas", parchear(original, inicioFila + sizeof(uint64_t), totalTramos + 1)},
+        {"último tramo distinto del total", parchear(original, inicioFila + nodos * sizeof(uint64_t), totalTramos - 1)},
+        {"tramo con número fuera de rango", parchear(original, tramos, (uint32_t)(nodos << 2))},
+        {"fila que no empieza en 0", parchear(original, tramos, primerTramo | (1u << 2))},
+        {"archivo truncado", original.substr(0, original.size() - 1)},
+    };
+    if (movimientoInvalido < 4) {
+        danos.push_back({"movimiento hacia una celda no válida",
+                         parchear(original, tramos, (primerTramo & ~3u) | movimientoInvalido)});
+    }
+    for (const Dano& dano : danos) {
+        escribirArchivo(nombre, dano.contenido);
+        BaseCaminos rechazada;
+        COMPROBAR(!rechazada.cargar(nombre, grid) && !rechazada.sincronizada(grid), "se aceptó un archivo con " << dano.descripcion);
+    }
+    std::remove(nombre.c_str());
+}
+
+// Prueba del archivo de la jerarquía de contracción: guardar y cargar conserva las rutas, guardar sin
+// jerarquía no toca el archivo y cargar rechaza archivos con índices de nodo, celda, extremo de arista o
+// nodo medio fuera de rango o que no respetan los niveles
+static void probarArchivoJerarquia() {
+    const std::string nombre = "prueba_jerarquia.ch";
+    JerarquiaContraccion vacia;
+    escribirArchivo(nombre, "contenido previo");
+    COMPROBAR(!vacia.guardar(nombre) && leerArchivo(nombre) == "contenido previo", "guardar sin jerarquía tocó el archivo");
+
+    Grid grid(32, 32);
+    grid.generarObstaculosAleatorios(DENSIDAD_MAPA, 7);
+    JerarquiaContraccion jerarquia;
+    jerarquia.construir(grid);
+    COMPROBAR(jerarquia.guardar(nombre), "no se pudo guardar la jerarquía");
+    JerarquiaContraccion cargada;
+    COMPROBAR(cargada.cargar(nombre, grid) && cargada.sincronizada(grid), "no se pudo cargar la jerarquía guardada");
+    std::mt19937_64 azar(7);
+    for (int consulta = 0; consulta < CONSULTAS_POR_MAPA; consulta++) {
+        int origen = celdaLibreAlAzar(grid, azar), destino = celdaLibreAlAzar(grid, azar);
+        if (origen < 0 || destino < 0) continue;
+        std::vector<int> ruta;
+        EstadisticasBusqueda medidas;
+        long esperada = longitudBFS(grid, origen, destino);
+        bool encontrada = cargada.consultar(origen, destino, ruta, medidas);
+        COMPROBAR(encontrada == (esperada >= 0) && (!encontrada || (long)ruta.size() - 1 == esperada),
+                  "jerarquía cargada: " << origen << " -> " << destino << ", " << ruta.size() << " celdas frente a " << esperada);
+    }
+
+    // Cabecera: firma, formato, filas, columnas (4 bytes cada uno), huella, atajos, nodos y aristas (8 bytes cada uno)
+    std::string original = leerArchivo(nombre);
+    const size_t cabecera = 48;
+    uint64_t nodos = 0, aristas = 0;
+    std::memcpy(&nodos, &original[32], sizeof(nodos));
+    std::memcpy(&aristas, &original[40], sizeof(aristas));
+    size_t celdaNodo = cabecera, nivel = cabecera + nodos * sizeof(int), inicioSubida = nivel + nodos * sizeof(int);
+    size_t subida = inicioSubida + (nodos + 1) * sizeof(uint32_t);
+    COMPROBAR(original.size() == subida + aristas * sizeof(AristaJerarquia), "tamaño del archivo " << original.size());
+    if (nodos < 2 || original.size() != subida + aristas * sizeof(AristaJerarquia)) return;
+
+    // Primera arista de la grilla y primer atajo (con su nodo de origen), si los hay
+    std::vector<uint32_t> inicios(nodos + 1);
+    std::memcpy(inicios.data(), &original[inicioSubida], inicios.size() * sizeof(uint32_t));
+    std::vector<AristaJerarquia> lista(aristas);
+    std::memcpy(lista.data(), &original[subida], lista.size() * sizeof(AristaJerarquia));
+    int aristaGrilla = -1, atajo = -1, origenAtajo = -1;
+    for (size_t v = 0; v < nodos; v++) {
+        for (uint32_t k = inicios[v]; k < inicios[v + 1]; k++) {
+            if (lista[k].medio < 0 && aristaGrilla < 0) aristaGrilla = (int)k;
+            if (lista[k].medio >= 0 && atajo < 0) {
+                atajo = (int)k;
+                origenAtajo = (int)v;
+            }
+        }
+    }
+    int primeraCelda = 0, primerNivel = 0;
+    std::memcpy(&primeraCelda, &original[celdaNodo], sizeof(int));
+    std::memcpy(&primerNivel, &original[nivel], sizeof(int));
+
+    struct Dano {
+        const char* descripcion;
+        std::string contenido;
+    };
+    std::vector<Dano> danos = {
+        {"celda fuera de rango", parchear(original, celdaNodo, (int)(32 * 32))},
+        {"celda repetida", parchear(original, celdaNodo + sizeof(int), primeraCelda)},
+        {"nivel fuera de rango", parchear(original, nivel, (int)nodos)},
+        {"nivel repetido", parchear(original, nivel + sizeof(int), primerNivel)},
+        {"aristas desordenadas", parchear(original, inicioSubida + sizeof(uint32_t), (uint32_t)aristas + 1)},
+        {"última arista distinta del total", parchear(original, inicioSubida + nodos * sizeof(uint32_t), (uint32_t)aristas + 1)},
+        {"archivo truncado", original.substr(0, original.size() - 1)},
+    };
+    auto danarArista = [&](int k, AristaJerarquia arista) {
+        return parchear(original, subida + (size_t)k * sizeof(AristaJerarquia), arista);
+    };
+    if (aristaGrilla >= 0) {
+        AristaJerarquia arista = lista[aristaGrilla];
+        danos.push_back({"extremo de arista fuera de rango", danarArista(aristaGrilla, {(int)nodos, arista.peso, -1})});
+        danos.push_back({"extremo de arista negativo", danarArista(aristaGrilla, {-1, arista.peso, -1})});
+        danos.push_back({"nodo medio fuera de rango", danarArista(aristaGrilla, {arista.destino, arista.peso, (int)nodos})});
+        danos.push_back({"nodo medio negativo distinto de -1", danarArista(aristaGrilla, {arista.destino, arista.peso, -2})});
+    }
+    if (atajo >= 0) {
+        AristaJerarquia arista = lista[atajo];
+        // Como nodo medio, el propio origen del atajo no está por debajo de sus extremos
+        danos.push_back({"nodo medio que no está por debajo", danarArista(atajo, {arista.destino, arista.peso, origenAtajo})});
+        // Sin nodo medio, los extremos de un atajo no son celdas vecinas
+        danos.push_back({"atajo entre celdas no vecinas", danarArista(atajo, {arista.destino, arista.peso, -1})});
+    }
+    COMPROBAR(aristaGrilla >= 0 && atajo >= 0, "la jerarquía no tiene aristas de la grilla y atajos");
+    for (const Dano& dano : danos) {
+        escribirArchivo(nombre, dano.contenido);
+        JerarquiaContraccion rechazada;
+        COMPROBAR(!rechazada.cargar(nombre, grid) && !rechazada.sincronizada(grid), "se aceptó un archivo con " << dano.descripcion);
+    }
+    std::remove(nombre.c_str());
+}
+
+// Prueba de los lotes de cambios de obstáculos: tras cada lote se replanifican exactamente los agentes
+// cuya ruta cruzaba una celda cambiada, sus rutas reparadas miden lo mismo que BFS y el resto conserva
+// la suya (que sigue siendo mínima cuando el lote solo bloquea). Regenerar el mapa olvida las marcas de tiempo.
+static void probarCambiosAgentes() {
+    const int lado = 32, agentes = 8, lotes = 15, cambiosPorLote = 4;
+    for (uint64_t semilla : SEMILLAS) {
+        Grid grid(lado, lado);
+        grid.generarObstaculosAleatorios(0.2, semilla);
+        std::mt19937_64 azar(semilla);
+        std::vector<std::pair<int, int>> extremos = extremosAgentes(grid, agentes, azar);
+        std::vector<char> esExtremo((size_t)lado * lado, 0);
+        std::vector<int> identificadores;
+        for (const std::pair<int, int>& extremo : extremos) {
+            esExtremo[extremo.first] = esExtremo[extremo.second] = 1;
+            identificadores.push_back(grid.registrarAgente(celdaDe(grid, extremo.first), celdaDe(grid, extremo.second)));
+        }
+
+        uint64_t marcaTiempo = 1;
+        for (int lote = 0; lote < lotes; lote++) {
+            // Lotes alternos solo bloquean; el resto mezcla bloqueos y desbloqueos fuera de los extremos
+            bool soloBloquea = lote % 2 == 0;
+            std::vector<CambioCelda> cambios;
+            while ((int)cambios.size() < cambiosPorLote) {
+                int celda = (int)(azar() % (uint64_t)(lado * lado));
+                if (esExtremo[celda]) continue;
+                cambios.push_back({celda / lado, celda % lado, soloBloquea || azar() % 2 == 0, marcaTiempo++});
+            }
+            std::vector<std::vector<int>> rutasAntes;
+            for (int agente : identificadores) rutasAntes.push_back(grid.rutaAgente(agente));
+            std::vector<char> bloqueadaAntes((size_t)lado * lado);
+            for (int celda = 0; celda < lado * lado; celda++) bloqueadaAntes[celda] = celdaDe(grid, celda).estado == BLOQUEADO;
+
+            std::vector<int> replanificados = grid.empujarCambios(cambios);
+            std::vector<int> cambiadas;
+            for (int celda = 0; celda < lado * lado; celda++) {
+                if ((celdaDe(grid, celda).estado == BLOQUEADO) != (bool)bloqueadaAntes[celda]) cambiadas.push_back(celda);
+            }
+
+            for (size_t k = 0; k < identificadores.size(); k++) {
+                const std::vector<int>& antes = rutasAntes[k];
+                bool cruza = antes.empty() || std::any_of(antes.begin(), antes.end(), [&](int celda) {
+                    return std::find(cambiadas.begin(), cambiadas.end(), celda) != cambiadas.end();
+                });
+                bool replanificado = std::find(replanificados.begin(), replanificados.end(), identificadores[k]) != replanificados.end();
+                COMPROBAR(replanificado == cruza, "semilla " << semilla << ", lote " << lote << ", agente " << k
+                          << (cruza ? ": su ruta cruza un cambio y no se replanificó" : ": se replanificó sin que su ruta cruzara un cambio"));
+                std::vector<int> ruta = grid.rutaAgente(identificadores[k]);
+                long esperada = longitudBFS(grid, extremos[k].first, extremos[k].second);
+                grid.reiniciar();
+                long obtenida = ruta.empty() ? -1 : (long)ruta.size() - 1;
+                if (replanificado || soloBloquea) {
+                    COMPROBAR(obtenida == esperada, "semilla " << semilla << ", lote " << lote << ", agente " << k
+                              << ": ruta de " << obtenida << " pasos frente a " << esperada << " de BFS");
+                } else {
+                    COMPROBAR(ruta == antes, "semilla " << semilla << ", lote " << lote << ", agente " << k << ": la ruta cambió");
+                }
+                for (int celda : ruta) {
+                    COMPROBAR(celdaDe(grid, celda).estado != BLOQUEADO, "la ruta del agente " << k << " cruza una celda bloqueada");
+                }
+            }
+        }
+
+        // Tras regenerar el mapa un cambio con una marca de tiempo antigua vuelve a aplicarse
+        int celda = (int)(azar() % (uint64_t)(lado * lado));
+        grid.empujarCambios({{celda / lado, celda % lado, true, 1000}});
+        grid.generarObstaculosAleatorios(0.2, semilla + 1);
+        bool bloquear = celdaDe(grid, celda).estado != BLOQUEADO;
+        grid.empujarCambios({{celda / lado, celda % lado, bloquear, 1}});
+        COMPROBAR((celdaDe(grid, celda).estado == BLOQUEADO) == bloquear, "se ignoró un cambio tras regenerar el mapa");
+    }
+}
+
+// Función de referencia para la línea de visión: el segmento entre los centros de dos celdas no toca
+// (ni por una esquina) el cuadrado cerrado de ninguna celda bloqueada. En coordenadas dobladas los
+// centros son enteros impares y los bordes pares, así que se compara con fracciones exactas.
+static bool visibleFuerzaBruta(const Grid& grid, int fila0, int columna0, int fila1, int columna1) {
+    const long long origen[2] = {2LL * fila0 + 1, 2LL * columna0 + 1};
+    const long long delta[2] = {2LL * (fila1 - fila0), 2LL * (columna1 - columna0)};
+    int filaMinima = std::min(fila0, fila1), filaMaxima = std::max(fila0, fila1);
+    int columnaMinima = std::min(columna0, columna1), columnaMaxima = std::max(columna0, columna1);
+    for (int fila = filaMinima; fila <= filaMaxima; fila++) {
+        for (int columna = columnaMinima; columna <= columnaMaxima; columna++) {
+            if (grid.obtenerCelda(fila, columna).estado != BLOQUEADO) continue;
+            // Intervalo de t en [0, 1] en el que el segmento está dentro del cuadrado, como fracciones n / d
+            long long entradaN = 0, entradaD = 1, salidaN = 1, salidaD = 1;
+            bool toca = true;
+            const long long bajo[2] = {2LL * fila, 2LL * columna};
+            for (int eje = 0; eje < 2 && toca; eje++) {
+                if (delta[eje] == 0) {
+                    toca = origen[eje] >= bajo[eje] && origen[eje] <= bajo[eje] + 2;
+                    continue;
+                }
+                long long n0 = bajo[eje] - origen[eje], n1 = bajo[eje] + 2 - origen[eje], d = delta[eje];
+                if (d < 0) {
+                    n0 = -n0;
+                    n1 = -n1;
+                    d = -d;
+                }
+                if (n0 > n1) std::swap(n0, n1);
+                if (n0 * entradaD > entradaN * d) {
+                    entradaN = n0;
+                    entradaD = d;
+                }
+                if (n1 * salidaD < salidaN * d) {
+                    salidaN = n1;
+                    salidaD = d;
+                }
+            }
+            if (toca && entradaN * salidaD <= salidaN * entradaD) return false;
+        }
+    }
+    return true;
+}
+
+// Función que comprueba que los puntos de paso de una ruta de cualquier ángulo van del origen al destino,
+// que cada segmento se ve según la referencia y que las celdas que recorre no están bloqueadas
+static void comprobarPuntosDePaso(const char* motor, Grid& grid, const std::vector<int>& puntos, int origen, int destino) {
+    int columnas = grid.obtenerColumnas();
+    COMPROBAR(!puntos.empty() && puntos.front() == origen && puntos.back() == destino,
+              motor << ": puntos de paso de " << origen << " -> " << destino << " con extremos distintos");
+    for (size_t k = 1; k < puntos.size(); k++) {
+        int a = puntos[k - 1], b = puntos[k];
+        COMPROBAR(visibleFuerzaBruta(grid, a / columnas, a % columnas, b / columnas, b % columnas),
+                  motor << ": el segmento " << a << " -> " << b << " toca una celda bloqueada");
+        std::vector<int> celdas;
+        trazarSegmento(a / columnas, a % columnas, b / columnas, b % columnas, columnas, celdas);
+        for (int celda : celdas) {
+            COMPROBAR(celdaDe(grid, celda).estado != BLOQUEADO,
+                      motor << ": el segmento " << a << " -> " << b << " recorre la celda bloqueada " << celda);
+        }
+    }
+}
+
+// Prueba de la línea de visión con la máscara de bits frente a la referencia en mapas aleatorios de
+// distintas densidades, y de que los segmentos de Lazy Theta* no tocan celdas bloqueadas
+static void probarLineaVision() {
+    const double densidades[] = {0.02, 0.1, 0.3};
+    for (double densidad : densidades) {
+        for (uint64_t semilla : SEMILLAS) {
+            Grid grid(40, 150);
+            grid.generarObstaculosAleatorios(densidad, semilla);
+            MapaVisibilidad mapa;
+            mapa.construir(grid);
+            std::mt19937_64 azar(semilla);
+            for (int consulta = 0; consulta < 2000; consulta++) {
+                int fila0 = (int)(azar() % 40), columna0 = (int)(azar() % 150);
+                // Una de cada cuatro consultas es vertical u horizontal y el resto tiene cualquier pendiente
+                int fila1 = consulta % 4 == 1 ? fila0 : (int)(azar() % 40);
+                int columna1 = consulta % 4 == 2 ? columna0 : (int)(azar() % 150);
+                bool esperada = visibleFuerzaBruta(grid, fila0, columna0, fila1, columna1);
+                COMPROBAR(mapa.lineaVisible(fila0, columna0, fila1, columna1) == esperada,
+                          "densidad " << densidad << ", semilla " << semilla << ": (" << fila0 << ", " << columna0
+                          << ") -> (" << fila1 << ", " << columna1 << ") debería ser " << (esperada ? "visible" : "oculta"));
+                COMPROBAR(mapa.lineaVisible(fila1, columna1, fila0, columna0) == esperada, "la línea de visión no es simétrica");
+            }
+
+            for (int consulta = 0; consulta < CONSULTAS_POR_MAPA; consulta++) {
+                int origen = celdaLibreAlAzar(grid, azar), destino = celdaLibreAlAzar(grid, azar);
+                if (origen < 0 || destino < 0) continue;
+                std::vector<int> puntos;
+                if (grid.ThetaPerezoso(celdaDe(grid, origen), celdaDe(grid, destino), puntos)) {
+                    comprobarPuntosDePaso("ThetaPerezoso", grid, puntos, origen, destino);
+                }
+            }
+        }
+    }
+}
+
+// Prueba de los tramos de fila (palabras de 64 bits y bloques SSE2 de 256 celdas) y del suavizado de rutas.
+// Con una sola celda bloqueada junto a cada frontera de palabra, un tramo está libre si y solo si no la
+// contiene; los puntos de paso del suavizado de rutas de BFS no tocan celdas bloqueadas y no alargan la ruta.
+static void probarTramosSuavizado() {
+    const int columnas = 600; // 9 palabras y media por fila: el bucle de 4 palabras se recorre varias veces
+    const int fronteras[] = {0, 1, 62, 63, 64, 65, 127, 128, 191, 192, 255, 256, 257, 319, 320, 383, 384, 447,
+                             448, 511, 512, 513, 575, 576, 598, 599};
+    std::vector<int> extremos(std::begin(fronteras), std::end(fronteras));
+    for (int bloqueada : fronteras) {
+        Grid grid(3, columnas);
+        grid.editarCelda(1, bloqueada, BLOQUEADO);
+        MapaVisibilidad mapa;
+        mapa.construir(grid);
+        for (int desde : extremos) {
+            for (int hasta : extremos) {
+                if (desde > hasta) continue;
+                bool libre = bloqueada < desde || bloqueada > hasta;
+                COMPROBAR(mapa.tramoLibre(1, desde, hasta) == libre,
+                          "columna " << bloqueada << " bloqueada, tramo [" << desde << ", " << hasta << "]");
+                COMPROBAR(mapa.tramoLibre(0, desde, hasta) && mapa.tramoLibre(2, desde, hasta),
+                          "tramo [" << desde << ", " << hasta << "] de una fila libre");
+                COMPROBAR(mapa.lineaVisible(1, desde, 1, hasta) == libre && mapa.lineaVisible(1, hasta, 1, desde) == libre,
+                          "columna " << bloqueada << " bloqueada, línea de " << desde << " a " << hasta);
+            }
+        }
+    }
+
+    for (int d = 0; d < 3; d++) {
+        for (uint64_t semilla : SEMILLAS) {
+            Grid grid(LADO_MAPA, LADO_MAPA, DISPOSICIONES[d]);
+            grid.generarObstaculosAleatorios(DENSIDAD_MAPA, semilla);
+            std::mt19937_64 azar(semilla);
+            for (int consulta = 0; consulta < CONSULTAS_POR_MAPA; consulta++) {
+                int origen = celdaLibreAlAzar(grid, azar), destino = celdaLibreAlAzar(grid, azar);
+                if (origen < 0 || destino < 0 || longitudBFS(grid, origen, destino) < 0) continue;
+                std::vector<int> ruta = grid.extraerRuta(celdaDe(grid, origen), celdaDe(grid, destino));
+                std::vector<int> puntos = grid.suavizarRuta(ruta);
+                comprobarPuntosDePaso("suavizarRuta", grid, puntos, origen, destino);
+                double longitud = 0;
+                for (size_t k = 1; k < puntos.size(); k++) {
+                    double df = puntos[k] / LADO_MAPA - puntos[k - 1] / LADO_MAPA;
+                    double dc = puntos[k] % LADO_MAPA - puntos[k - 1] % LADO_MAPA;
+                    longitud += std::sqrt(df * df + dc * dc);
+                }
+                COMPROBAR(longitud <= (double)ruta.size() - 1 + 1e-9,
+                          "la ruta suavizada mide " << longitud << " frente a " << ruta.size() - 1 << " pasos");
+            }
+        }
+    }
+}
+
+// Función que comprueba que una ruta de celdas va de un extremo al otro por celdas vecinas libres
+static void comprobarRutaCeldas(const char* motor, const std::vector<Celda*>& ruta, const Celda* origen, const Celda* destino) {
+    COMPROBAR(!ruta.empty() && ruta.front() == origen && ruta.back() == destino, motor << ": ruta con extremos distintos");
+    for (size_t k = 0; k < ruta.size(); k++) {
+        COMPROBAR(ruta[k]->estado != BLOQUEADO, motor << ": la ruta cruza una celda bloqueada");
+        if (k == 0) continue;
+        int pasos = std::abs(ruta[k]->fila - ruta[k - 1]->fila) + std::abs(ruta[k]->columna - ruta[k - 1]->columna);
+        COMPROBAR(pasos == 1, motor << ": celdas consecutivas no vecinas en la ruta");
+    }
+}
+
+// Prueba de BFS y Dijkstra con varios orígenes y destinos: el coste es el mínimo de los BFS de cada par
+// (más el coste inicial del origen en Dijkstra) y los orígenes bloqueados se ignoran aunque sean destinos
+static void probarMultiple() {
+    for (int d = 0; d < 3; d++) {
+        for (uint64_t semilla : SEMILLAS) {
+            Grid grid(LADO_MAPA, LADO_MAPA, DISPOSICIONES[d]);
+            grid.generarObstaculosAleatorios(DENSIDAD_MAPA, semilla);
+            std::mt19937_64 azar(semilla);
+            int total = LADO_MAPA * LADO_MAPA;
+            int bloqueada = -1;
+            for (int celda = 0; celda < total && bloqueada < 0; celda++) {
+                if (celdaDe(grid, celda).estado == BLOQUEADO) bloqueada = celda;
+            }
+            for (int consulta = 0; consulta < CONSULTAS_POR_MAPA / 4; consulta++) {
+                std::vector<int> origenes, destinos;
+                std::vector<CosteBusqueda> costesIniciales;
+                for (int k = 0; k < 3; k++) {
+                    int origen = celdaLibreAlAzar(grid, azar), destino = celdaLibreAlAzar(grid, azar);
+                    if (origen >= 0) {
+                        origenes.push_back(origen);
+                        costesIniciales.push_back((CosteBusqueda)(azar() % 20));
+                    }
+                    if (destino >= 0) destinos.push_back(destino);
+                }
+                // Un origen bloqueado que también es destino no debe dar una ruta de coste 0
+                if (bloqueada >= 0) {
+                    origenes.push_back(bloqueada);
+                    costesIniciales.push_back(0);
+                    destinos.push_back(bloqueada);
+                }
+
+                long esperadaBFS = -1, esperadaDijkstra = -1;
+                for (size_t o = 0; o + (bloqueada >= 0) < origenes.size(); o++) {
+                    for (size_t t = 0; t + (bloqueada >= 0) < destinos.size(); t++) {
+                        long longitud = longitudBFS(grid, origenes[o], destinos[t]);
+                        if (longitud < 0) continue;
+                        if (esperadaBFS < 0 || longitud < esperadaBFS) esperadaBFS = longitud;
+                        long conInicial = longitud + (long)costesIniciales[o];
+                        if (esperadaDijkstra < 0 || conInicial < esperadaDijkstra) esperadaDijkstra = conInicial;
+                    }
+                }
+
+                std::vector<Celda*> celdasOrigen, celdasDestino;
+                for (int origen : origenes) celdasOrigen.push_back(&celdaDe(grid, origen));
+                for (int destino : destinos) celdasDestino.push_back(&celdaDe(grid, destino));
+                auto esOrigen = [&](const Celda* celda) {
+                    return std::find(celdasOrigen.begin(), celdasOrigen.end(), celda) != celdasOrigen.end() && celda->estado != BLOQUEADO;
+                };
+                auto esDestino = [&](const Celda* celda) {
+                    return std::find(celdasDestino.begin(), celdasDestino.end(), celda) != celdasDestino.end();
+                };
+
+                ResultadoMultiple resultado;
+                bool encontrada = grid.BFSMultiple(celdasOrigen, celdasDestino, resultado);
+                COMPROBAR(encontrada == (esperadaBFS >= 0), "BFSMultiple en " << NOMBRES_DISPOSICION[d] << ", semilla " << semilla);
+                if (encontrada && esperadaBFS >= 0) {
+                    COMPROBAR((long)resultado.coste == esperadaBFS && resultado.ruta.size() == resultado.coste + 1,
+                              "BFSMultiple: coste " << resultado.coste << " frente a " << esperadaBFS);
+                    COMPROBAR(esOrigen(resultado.origen) && esDestino(resultado.destino), "BFSMultiple: extremos que no se pidieron");
+                    comprobarRutaCeldas("BFSMultiple", resultado.ruta, resultado.origen, resultado.destino);
+                }
+
+                encontrada = grid.DijkstraMultiple(celdasOrigen, costesIniciales, celdasDestino, resultado);
+                COMPROBAR(encontrada == (esperadaDijkstra >= 0), "DijkstraMultiple en " << NOMBRES_DISPOSICION[d] << ", semilla " << semilla);
+                if (encontrada && esperadaDijkstra >= 0) {
+                    COMPROBAR((long)resultado.coste == esperadaDijkstra,
+                              "DijkstraMultiple: coste " << resultado.coste << " frente a " << esperadaDijkstra);
+                    COMPROBAR(esOrigen(resultado.origen) && esDestino(resultado.destino), "DijkstraMultiple: extremos que no se pidieron");
+                    comprobarRutaCeldas("DijkstraMultiple", resultado.ruta, resultado.origen, resultado.destino);
+                    // Un origen repetido cuenta con el menor de sus costes iniciales
+                    CosteBusqueda inicial = COSTE_INFINITO;
+                    for (size_t o = 0; o < celdasOrigen.size(); o++) {
+                        if (celdasOrigen[o] == resultado.origen) inicial = std::min(inicial, costesIniciales[o]);
+                    }
+                    COMPROBAR(resultado.coste == inicial + resultado.ruta.size() - 1,
+                              "DijkstraMultiple: el coste no es el inicial del origen más los pasos de la ruta");
+                }
+            }
+        }
+    }
+}
+
+// Prueba del campo de flujo: la distancia de cada celda coincide con BFS, cada dirección lleva a una
+// vecina libre un paso más cerca del destino y seguir el campo llega al destino en esos pasos
+static void probarCampoFlujo() {
+    for (int d = 0; d < 3; d++) {
+        for (uint64_t semilla : SEMILLAS) {
+            Grid grid(LADO_MAPA, LADO_MAPA, DISPOSICIONES[d]);
+            grid.generarObstaculosAleatorios(DENSIDAD_MAPA, semilla);
+            std::mt19937_64 azar(semilla);
+            int destino = celdaLibreAlAzar(grid, azar);
+            if (destino < 0) continue;
+            CampoFlujo campo;
+            grid.calcularCampoFlujo(celdaDe(grid, destino), campo);
+
+            // Estructura del campo en todas las celdas
+            for (int celda = 0; celda < LADO_MAPA * LADO_MAPA; celda++) {
+                int fila = celda / LADO_MAPA, columna = celda % LADO_MAPA;
+                if (celdaDe(grid, celda).estado == BLOQUEADO) {
+                    COMPROBAR(!campo.alcanzable(fila, columna), "la celda bloqueada " << celda << " tiene dirección");
+                    continue;
+                }
+                if (!campo.alcanzable(fila, columna)) {
+                    COMPROBAR(campo.distanciaDesde(fila, columna) == DISTANCIA_INFINITA, "celda " << celda << " sin dirección con distancia");
+                    continue;
+                }
+                if (celda == destino) {
+                    COMPROBAR(campo.distanciaDesde(fila, columna) == 0 && !campo.siguientePaso(fila, columna), "el destino no es la meta del campo");
+                    continue;
+                }
+                uint32_t distancia = campo.distanciaDesde(fila, columna);
+                COMPROBAR(campo.siguientePaso(fila, columna), "la celda alcanzable " << celda << " no avanza");
+                COMPROBAR(fila >= 0 && fila < LADO_MAPA && columna >= 0 && columna < LADO_MAPA
+                              && grid.obtenerCelda(fila, columna).estado != BLOQUEADO
+                              && campo.distanciaDesde(fila, columna) + 1 == distancia,
+                          "la dirección de la celda " << celda << " no lleva a una vecina libre más cercana");
+            }
+
+            // Distancias frente a BFS y ruta que marca seguir el campo
+            for (int consulta = 0; consulta < CONSULTAS_POR_MAPA; consulta++) {
+                int origen = celdaLibreAlAzar(grid, azar);
+                if (origen < 0) continue;
+                long esperada = longitudBFS(grid, origen, destino);
+                uint32_t distancia = campo.distanciaDesde(origen / LADO_MAPA, origen % LADO_MAPA);
+                long obtenida = distancia == DISTANCIA_INFINITA ? -1 : (long)distancia;
+                COMPROBAR(obtenida == esperada, "campo de flujo en " << NOMBRES_DISPOSICION[d] << ", semilla " << semilla
+                          << ", " << origen << " -> " << destino << ": " << obtenida << " frente a " << esperada);
+                bool encontrada = grid.seguirCampoFlujo(celdaDe(grid, origen), campo);
+                COMPROBAR(encontrada == (esperada >= 0) && (!encontrada || (long)grid.obtenerEstadisticas().longitudRuta == esperada),
+                          "seguir el campo desde " << origen << ": " << grid.obtenerEstadisticas().longitudRuta << " pasos frente a " << esperada);
+            }
+        }
+    }
+}
+
+// Prueba del núcleo 4-conexo de coste unitario con heurística admisible
+static void probarKernel4() {
+    MallaBusqueda malla;
+    ConfiguracionKernel configuracion;
+    compararConBFS("Kernel4", [&](Grid& grid) { malla.construir(grid); return malla.sincronizada(grid); },
+                   [&](Grid& grid, Celda& origen, Celda& destino) {
+                       return grid.buscarConKernel(malla, configuracion, origen, destino);
+                   });
+}
+
+// Función que devuelve el coste de entrar en una celda con el modelo indicado (en diagonal, el de terreno
+// por raíz de 2 si el coste es real)
+static double costePaso(ModeloCoste modelo, const std::vector<uint8_t>& terreno, int celda, bool diagonal) {
+    if (modelo == COSTE_UNITARIO) return 1.0;
+    if (modelo == COSTE_TERRENO) return terreno[celda];
+    return diagonal ? terreno[celda] * 1.41421356 : terreno[celda];
+}
+
+// Función que indica si se puede pasar entre dos celdas vecinas (4 u 8 vecinos, sin cortar esquinas
+// bloqueadas); devuelve false si no son vecinas
+static bool movimientoValido(const Grid& grid, int a, int b, bool ocho) {
+    int columnas = grid.obtenerColumnas();
+    int df = b / columnas - a / columnas, dc = b % columnas - a % columnas;
+    if (std::abs(df) > 1 || std::abs(dc) > 1 || (df == 0 && dc == 0) || (!ocho && df != 0 && dc != 0)) return false;
+    auto libre = [&](int fila, int columna) { return grid.obtenerCelda(fila, columna).estado != BLOQUEADO; };
+    int fila = a / columnas, columna = a % columnas;
+    return libre(fila + df, columna + dc) && libre(fila + df, columna) && libre(fila, columna + dc);
+}
+
+// Función de referencia: Dijkstra sobre la grilla con la vecindad y el modelo de coste indicados
+// (-1 si el destino no es alcanzable)
+static double dijkstraReferencia(const Grid& grid, const std::vector<uint8_t>& terreno, bool ocho, ModeloCoste modelo,
+                                 int origen, int destino) {
+    int filas = grid.obtenerFilas(), columnas = grid.obtenerColumnas();
+    std::vector<double> distancia((size_t)filas * columnas, INFINITY);
+    std::priority_queue<std::pair<double, int>, std::vector<std::pair<double, int>>, std::greater<std::pair<double, int>>> cola;
+    distancia[origen] = 0;
+    cola.push({0, origen});
+    while (!cola.empty()) {
+        std::pair<double, int> entrada = cola.top();
+        cola.pop();
+        int actual = entrada.second;
+        if (entrada.first > distancia[actual]) continue;
+        if (actual == destino) return entrada.first;
+        for (int df = -1; df <= 1; df++) {
+            for (int dc = -1; dc <= 1; dc++) {
+                int fila = actual / columnas + df, columna = actual % columnas + dc;
+                if (fila < 0 || fila >= filas || columna < 0 || columna >= columnas) continue;
+                int vecina = fila * columnas + columna;
+                if (!movimientoValido(grid, actual, vecina, ocho)) continue;
+                double nueva = entrada.first + costePaso(modelo, terreno, vecina, df != 0 && dc != 0);
+                if (nueva < distancia[vecina]) {
+                    distancia[vecina] = nueva;
+                    cola.push({nueva, vecina});
+                }
+            }
+        }
+    }
+    return -1;
+}
+
+// Prueba de todos los núcleos de la tabla de despacho (4 y 8 vecinos; coste unitario, de terreno y real;
+// las tres heurísticas) frente a un Dijkstra de referencia en mapas con terreno aleatorio: con heurística
+// nula o admisible el coste es el óptimo y con la ponderada no pasa del doble
+static void probarKernelsDijkstra() {
+    const Conectividad conectividades[] = {CONECTIVIDAD_4, CONECTIVIDAD_8};
+    const ModeloCoste modelos[] = {COSTE_UNITARIO, COSTE_TERRENO, COSTE_REAL};
+    const PoliticaHeuristica heuristicas[] = {HEURISTICA_NULA, HEURISTICA_ADMISIBLE, HEURISTICA_PONDERADA};
+    const char* nombresCoste[] = {"unitario", "terreno", "real"};
+    for (uint64_t semilla : SEMILLAS) {
+        Grid grid(LADO_MAPA, LADO_MAPA);
+        grid.generarObstaculosAleatorios(DENSIDAD_MAPA, semilla);
+        std::mt19937_64 azar(semilla);
+        std::vector<uint8_t> terreno((size_t)LADO_MAPA * LADO_MAPA);
+        for (uint8_t& coste : terreno) coste = (uint8_t)(1 + azar() % 9);
+        MallaBusqueda malla;
+        malla.construir(grid, &terreno);
+        for (int consulta = 0; consulta < CONSULTAS_POR_MAPA / 4; consulta++) {
+            int origen = celdaLibreAlAzar(grid, azar), destino = celdaLibreAlAzar(grid, azar);
+            if (origen < 0 || destino < 0) continue;
+            for (Conectividad conectividad : conectividades) {
+                bool ocho = conectividad == CONECTIVIDAD_8;
+                for (ModeloCoste modelo : modelos) {
+                    double optimo = dijkstraReferencia(grid, terreno, ocho, modelo, origen, destino);
+                    for (PoliticaHeuristica heuristica : heuristicas) {
+                        ConfiguracionKernel configuracion;
+                        configuracion.conectividad = conectividad;
+                        configuracion.coste = modelo;
+                        configuracion.heuristica = heuristica;
+                        std::vector<int> ruta;
+                        EstadisticasBusqueda medidas;
+                        bool encontrada = obtenerKernel(configuracion)(malla, malla.posicion(origen), malla.posicion(destino), ruta, medidas);
+                        const char* nombre = nombresCoste[modelo];
+                        COMPROBAR(encontrada == (optimo >= 0), "núcleo de " << (ocho ? 8 : 4) << " vecinos, coste " << nombre
+                                  << ", heurística " << heuristica << ": " << origen << " -> " << destino);
+                        if (!encontrada || optimo < 0) continue;
+                        COMPROBAR(ruta.front() == origen && ruta.back() == destino, "ruta del núcleo con extremos distintos");
+                        double coste = 0;
+                        for (size_t k = 1; k < ruta.size(); k++) {
+                            COMPROBAR(movimientoValido(grid, ruta[k - 1], ruta[k], ocho),
+                                      "movimiento no válido " << ruta[k - 1] << " -> " << ruta[k] << " con coste " << nombre);
+                            int df = ruta[k] / LADO_MAPA - ruta[k - 1] / LADO_MAPA, dc = ruta[k] % LADO_MAPA - ruta[k - 1] % LADO_MAPA;
+                            coste += costePaso(modelo, terreno, ruta[k], df != 0 && dc != 0);
+                        }
+                        // El coste real se acumula en float: se admite el error de redondeo
+                        double margen = modelo == COSTE_REAL ? 1e-4 * optimo + 1e-3 : 1e-9;
+                        double limite = heuristica == HEURISTICA_PONDERADA ? 2 * optimo : optimo;
+                        COMPROBAR(coste >= optimo - margen && coste <= limite + margen,
+                                  "núcleo de " << (ocho ? 8 : 4) << " vecinos, coste " << nombre << ", heurística " << heuristica
+                                  << ": " << coste << " frente al óptimo " << optimo);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Tabla de pruebas disponibles
+struct Prueba {
+    const char* nombre;
+    void (*ejecutar)();
+};
+
+const Prueba PRUEBAS[] = {
+    {"subobjetivos", probarSubobjetivos},
+    {"jerarquia", probarJerarquia},
+    {"basecaminos", probarBaseCaminos},
+    {"dstarlite", probarDStarLite},
+    {"actualizacion_subobjetivos", probarActualizacionSubobjetivos},
+    {"arbol_pasillo", probarArbolPasillo},
+    {"cooperativo", probarCooperativo},
+    {"conflictos", probarConflictos},
+    {"arastar", probarARAStar},
+    {"cota_arastar", probarCotaARAStar},
+    {"cache_rutas", probarCacheRutas},
+    {"archivo_basecaminos", probarArchivoBaseCaminos},
+    {"archivo_jerarquia", probarArchivoJerarquia},
+    {"cambios_agentes", probarCambiosAgentes},
+    {"linea_vision", probarLineaVision},
+    {"tramos_suavizado", probarTramosSuavizado},
+    {"multiple", probarMultiple},
+    {"campo_flujo", probarCampoFlujo},
+    {"kernel4", probarKernel4},
+    {"kernels_dijkstra", probarKernelsDijkstra},
+};
+
+int main(int argc, char** argv) {
+    int pruebasFallidas = 0;
+    bool encontrada = false;
+    for (const Prueba& prueba : PRUEBAS) {
+        if (argc > 1 && std::strcmp(argv[1], prueba.nombre) != 0) continue;
+        encontrada = true;
+        fallos = 0;
+        prueba.ejecutar();
+        std::cout << (fallos == 0 ? "[ OK ] " : "[FALLA] ") << prueba.nombre;
+        if (fallos > 0) std::cout << " (" << fallos << " comprobaciones)";
+        std::cout << std::endl;
+        if (fallos > 0) pruebasFallidas++;
+    }
+    if (!encontrada) {
+        std::cerr << "Prueba desconocida: " << argv[1] << std::endl;
+        return 1;
+    }
+    return pruebasFallidas == 0 ? 0 : 1;
+}
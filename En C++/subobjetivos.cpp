@@ -0,0 +1,433 @@
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include "entidades.h"
+#include "subobjetivos.h"
+
+// Sentidos de los cuatro cuadrantes de un recorrido monótono (paso de fila, paso de columna)
+static const int CUADRANTES[4][2] = {{-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+
+// Método que indica si la celda está dentro de la grilla y libre
+bool GrafoSubobjetivos::libre(int fila, int columna) const {
+    return fila >= 0 && fila < filas && columna >= 0 && columna < columnas
+        && !bloqueadas.contiene((size_t)fila * columnas + columna);
+}
+
+// Método que indica si la celda libre es una esquina de obstáculo
+bool GrafoSubobjetivos::esEsquina(int fila, int columna) const {
+    if (!libre(fila, columna)) return false;
+    for (const auto& cuadrante : CUADRANTES) {
+        int filaDiagonal = fila + cuadrante[0];
+        int columnaDiagonal = columna + cuadrante[1];
+        // El borde de la grilla no cuenta como obstáculo: no se puede rodear
+        if (filaDiagonal < 0 || filaDiagonal >= filas || columnaDiagonal < 0 || columnaDiagonal >= columnas) continue;
+        if (!libre(filaDiagonal, columnaDiagonal) && libre(filaDiagonal, columna) && libre(fila, columnaDiagonal)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Método que recorre fila a fila las celdas alcanzables desde una celda moviéndose solo en el sentido
+// (pasoFila, pasoColumna). Una celda se alcanza desde la anterior de su fila o desde la misma columna
+// de la fila previa; los subobjetivos encontrados se guardan pero no se atraviesan.
+void GrafoSubobjetivos::inundarCuadrante(int indice, int pasoFila, int pasoColumna, BufferInundacion& buffer,
+                                         std::vector<int>& encontrados) const {
+    int filaInicial = indice / columnas;
+    int columnaInicial = indice % columnas;
+    if (!libre(filaInicial, columnaInicial)) return;
+    buffer.previa.resize(columnas);
+    buffer.actual.resize(columnas);
+
+    // Rango de columnas (en el sentido del avance) con celdas que se pueden atravesar en la fila previa
+    int inicio = columnaInicial;
+    int fin = columnaInicial;
+    for (int fila = filaInicial; fila >= 0 && fila < filas; fila += pasoFila) {
+        bool primeraFila = fila == filaInicial;
+        bool hayAtravesables = false;
+        bool desdeAnterior = false; // La celda anterior de la fila se puede atravesar
+        int nuevoInicio = 0;
+        int nuevoFin = 0;
+        for (int columna = inicio; columna >= 0 && columna < columnas; columna += pasoColumna) {
+            bool enRango = (columna - inicio) * pasoColumna >= 0 && (fin - columna) * pasoColumna >= 0;
+            bool desdePrevia = primeraFila ? columna == columnaInicial : enRango && buffer.previa[columna];
+            if (!desdePrevia && !desdeAnterior && (columna - fin) * pasoColumna > 0) break;
+
+            int celda = fila * columnas + columna;
+            bool atravesable = (desdePrevia || desdeAnterior) && libre(fila, columna);
+            if (atravesable && celda != indice && idCelda[celda] >= 0) {
+                encontrados.push_back(celda);
+                atravesable = false; // El camino directo termina en el primer subobjetivo
+            }
+            buffer.actual[columna] = atravesable;
+            if (atravesable) {
+                if (!hayAtravesables) nuevoInicio = columna;
+                nuevoFin = columna;
+                hayAtravesables = true;
+            }
+            desdeAnterior = atravesable;
+        }
+        if (!hayAtravesables) break;
+        std::swap(buffer.previa, buffer.actual);
+        inicio = nuevoInicio;
+        fin = nuevoFin;
+    }
+}
+
+// Método que añade un subobjetivo nuevo en la celda y devuelve su identificador
+int GrafoSubobjetivos::agregarSubobjetivo(int indice) {
+    int id;
+    if (!idsLibres.empty()) {
+        id = idsLibres.back();
+        idsLibres.pop_back();
+        celdaId[id] = indice;
+    } else {
+        id = (int)celdaId.size();
+        celdaId.push_back(indice);
+        aristas.emplace_back();
+    }
+    idCelda[indice] = id;
+    return id;
+}
+
+// Método que elimina el subobjetivo de la celda y sus aristas
+void GrafoSubobjetivos::eliminarSubobjetivo(int indice) {
+    int id = idCelda[indice];
+    for (int vecino : aristas[id]) {
+        std::vector<int>& lista = aristas[vecino];
+        lista.erase(std::remove(lista.begin(), lista.end(), id), lista.end());
+    }
+    aristas[id].clear();
+    celdaId[id] = -1;
+    idCelda[indice] = -1;
+    idsLibres.push_back(id);
+}
+
+// Método que vuelve a calcular las aristas de los subobjetivos indicados
+void GrafoSubobjetivos::recalcularAristas(const std::vector<int>& ids) {
+    std::vector<char> recalculado(celdaId.size(), 0);
+    for (int id : ids) {
+        recalculado[id] = 1;
+        for (int vecino : aristas[id]) {
+            std::vector<int>& lista = aristas[vecino];
+            lista.erase(std::remove(lista.begin(), lista.end(), id), lista.end());
+        }
+        aristas[id].clear();
+    }
+
+    BufferInundacion buffer;
+    std::vector<int> encontrados;
+    for (int id : ids) {
+        encontrados.clear();
+        for (const auto& cuadrante : CUADRANTES) {
+            inundarCuadrante(celdaId[id], cuadrante[0], cuadrante[1], buffer, encontrados);
+        }
+        std::sort(encontrados.begin(), encontrados.end());
+        encontrados.erase(std::unique(encontrados.begin(), encontrados.end()), encontrados.end());
+        for (int celda : encontrados) {
+            int vecino = idCelda[celda];
+            aristas[id].push_back(vecino);
+            // La alcanzabilidad directa es simétrica: si el vecino no se recalcula, le añadimos la arista
+            if (!recalculado[vecino]) {
+                aristas[vecino].push_back(id);
+            }
+        }
+    }
+}
+
+// Método que construye el grafo completo a partir de las celdas bloqueadas de la grilla
+void GrafoSubobjetivos::construir(const Grid& grid) {
+    filas = grid.obtenerFilas();
+    columnas = grid.obtenerColumnas();
+    size_t total = (size_t)filas * columnas;
+    bloqueadas.redimensionar(total);
+    for (int i = 0; i < filas; i++) {
+        for (int j = 0; j < columnas; j++) {
+            if (grid.obtenerCelda(i, j).estado == BLOQUEADO) {
+                bloqueadas.marcar((size_t)i * columnas + j);
+            }
+        }
+    }
+
+    idCelda.assign(total, -1);
+    celdaId.clear();
+    idsLibres.clear();
+    aristas.clear();
+    for (int i = 0; i < filas; i++) {
+        for (int j = 0; j < columnas; j++) {
+            if (esEsquina(i, j)) {
+                agregarSubobjetivo(i * columnas + j);
+            }
+        }
+    }
+
+    // Cada subobjetivo calcula sus propias aristas: los recorridos solo leen el mapa, así que se reparten entre hilos
+    unsigned hilos = std::max(1u, std::thread::hardware_concurrency());
+    hilos = (unsigned)std::min<size_t>(hilos, std::max<size_t>(1, celdaId.size() / 256));
+    auto tarea = [&](unsigned primero) {
+        BufferInundacion buffer;
+        std::vector<int> encontrados;
+        for (size_t id = primero; id < celdaId.size(); id += hilos) {
+            encontrados.clear();
+            for (const auto& cuadrante : CUADRANTES) {
+                inundarCuadrante(celdaId[id], cuadrante[0], cuadrante[1], buffer, encontrados);
+            }
+            std::sort(encontrados.begin(), encontrados.end());
+            encontrados.erase(std::unique(encontrados.begin(), encontrados.end()), encontrados.end());
+            for (int celda : encontrados) {
+                aristas[id].push_back(idCelda[celda]);
+            }
+        }
+    };
+    std::vector<std::thread> trabajadores;
+    for (unsigned k = 1; k < hilos; k++) {
+        trabajadores.emplace_back(tarea, k);
+    }
+    tarea(0);
+    for (std::thread& trabajador : trabajadores) {
+        trabajador.join();
+    }
+
+    version = grid.obtenerVersion();
+    construido = true;
+}
+
+// Método que actualiza el grafo tras cambiar el estado de una celda en la grilla
+void GrafoSubobjetivos::actualizarCelda(const Grid& grid, int fila, int columna) {
+    if (!construido) {
+        construir(grid);
+        return;
+    }
+    int indice = fila * columnas + columna;
+    bool bloqueada = grid.obtenerCelda(fila, columna).estado == BLOQUEADO;
+    if (bloqueada == bloqueadas.contiene(indice)) {
+        version = grid.obtenerVersion();
+        return;
+    }
+
+    // Celdas cuyo carácter de subobjetivo puede cambiar: la editada y sus 8 vecinas
+    std::vector<int> afectadas;
+    for (int i = fila - 1; i <= fila + 1; i++) {
+        for (int j = columna - 1; j <= columna + 1; j++) {
+            if (i >= 0 && i < filas && j >= 0 && j < columnas) {
+                afectadas.push_back(i * columnas + j);
+            }
+        }
+    }
+
+    // Recorrido inverso (la alcanzabilidad directa es simétrica): los subobjetivos que llegaban
+    // directamente a una celda afectada antes del cambio, y los que llegan después
+    BufferInundacion buffer;
+    std::vector<int> subobjetivos;
+    auto recorrerAfectadas = [&]() {
+        for (int celda : afectadas) {
+            if (idCelda[celda] >= 0) subobjetivos.push_back(celda);
+            for (const auto& cuadrante : CUADRANTES) {
+                inundarCuadrante(celda, cuadrante[0], cuadrante[1], buffer, subobjetivos);
+            }
+        }
+    };
+    recorrerAfectadas();
+
+    if (bloqueada) {
+        bloqueadas.marcar(indice);
+    } else {
+        bloqueadas.desmarcar(indice);
+    }
+    for (int celda : afectadas) {
+        bool esSubobjetivo = esEsquina(celda / columnas, celda % columnas);
+        if (esSubobjetivo && idCelda[celda] < 0) {
+            agregarSubobjetivo(celda);
+        } else if (!esSubobjetivo && idCelda[celda] >= 0) {
+            eliminarSubobjetivo(celda);
+        }
+    }
+    recorrerAfectadas();
+
+    std::vector<int> ids;
+    for (int celda : subobjetivos) {
+        if (idCelda[celda] >= 0) ids.push_back(idCelda[celda]);
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    recalcularAristas(ids);
+    version = grid.obtenerVersion();
+}
+
+// Método que indica si el grafo corresponde a la versión actual del mapa de la grilla
+bool GrafoSubobjetivos::sincronizado(const Grid& grid) const {
+    return construido && version == grid.obtenerVersion()
+        && filas == grid.obtenerFilas() && columnas == grid.obtenerColumnas();
+}
+
+// Método que devuelve los subobjetivos alcanzables directamente desde una celda libre
+void GrafoSubobjetivos::conectar(int indice, std::vector<int>& subobjetivos) const {
+    subobjetivos.clear();
+    if (idCelda[indice] >= 0) {
+        subobjetivos.push_back(indice);
+        return;
+    }
+    BufferInundacion buffer;
+    for (const auto& cuadrante : CUADRANTES) {
+        inundarCuadrante(indice, cuadrante[0], cuadrante[1], buffer, subobjetivos);
+    }
+    std::sort(subobjetivos.begin(), subobjetivos.end());
+    subobjetivos.erase(std::unique(subobjetivos.begin(), subobjetivos.end()), subobjetivos.end());
+}
+
+// Método que busca un camino monótono entre dos celdas dentro del rectángulo que las contiene
+bool GrafoSubobjetivos::caminoMonotono(int desde, int hasta, std::vector<int>& ruta) const {
+    int filaDesde = desde / columnas, columnaDesde = desde % columnas;
+    int filaHasta = hasta / columnas, columnaHasta = hasta % columnas;
+    int pasoFila = filaHasta >= filaDesde ? 1 : -1;
+    int pasoColumna = columnaHasta >= columnaDesde ? 1 : -1;
+    int alto = std::abs(filaHasta - filaDesde) + 1;
+    int ancho = std::abs(columnaHasta - columnaDesde) + 1;
+
+    // alcanzada[k] indica si la celda k del rectángulo (relativa a 'desde') se alcanza monótonamente
+    std::vector<char> alcanzada((size_t)alto * ancho, 0);
+    for (int k = 0; k < alto; k++) {
+        for (int l = 0; l < ancho; l++) {
+            if (!libre(filaDesde + k * pasoFila, columnaDesde + l * pasoColumna)) continue;
+            alcanzada[(size_t)k * ancho + l] = (k == 0 && l == 0)
+                || (k > 0 && alcanzada[(size_t)(k - 1) * ancho + l])
+                || (l > 0 && alcanzada[(size_t)k * ancho + l - 1]);
+        }
+    }
+    if (!alcanzada[(size_t)alto * ancho - 1]) return false;
+
+    // Retrocedemos desde 'hasta' eligiendo cualquier predecesor alcanzado
+    std::vector<int> tramo;
+    int k = alto - 1, l = ancho - 1;
+    while (k > 0 || l > 0) {
+        tramo.push_back((filaDesde + k * pasoFila) * columnas + columnaDesde + l * pasoColumna);
+        if (k > 0 && alcanzada[(size_t)(k - 1) * ancho + l]) {
+            k--;
+        } else {
+            l--;
+        }
+    }
+    ruta.insert(ruta.end(), tramo.rbegin(), tramo.rend());
+    return true;
+}
+
+// Métodos para consultar el tamaño del grafo
+size_t GrafoSubobjetivos::numeroSubobjetivos() const {
+    return celdaId.size() - idsLibres.size();
+}
+
+size_t GrafoSubobjetivos::numeroAristas() const {
+    size_t total = 0;
+    for (const std::vector<int>& lista : aristas) total += lista.size();
+    return total / 2;
+}
+
+size_t GrafoSubobjetivos::bytes() const {
+    size_t total = bloqueadas.bytes() + (idCelda.size() + celdaId.size() + idsLibres.size()) * sizeof(int);
+    for (const std::vector<int>& lista : aristas) total += lista.capacity() * sizeof(int);
+    return total;
+}
+
+// Función de búsqueda óptima sobre el grafo de subobjetivos: conecta el origen y el destino
+// a sus subobjetivos directos, ejecuta A* en el grafo y rellena los tramos monótonos
+bool Grid::buscarConSubobjetivos(const GrafoSubobjetivos& grafo, Celda& origen, Celda& destino) {
+    // Si el grafo no corresponde al mapa actual, respondemos con BFS
+    if (!grafo.sincronizado(*this)) {
+        return BFS(origen, destino);
+    }
+    MedicionMemoria memoria;
+    EstadisticasBusqueda medidas;
+    int inicio = indiceCelda(origen);
+    int meta = indiceCelda(destino);
+    auto manhattan = [&](int a, int b) {
+        return (uint32_t)(std::abs(a / columnas - b / columnas) + std::abs(a % columnas - b % columnas));
+    };
+
+    // Si el destino se alcanza en línea monótona, la ruta directa ya es mínima
+    std::vector<int> ruta = {inicio};
+    if (grafo.caminoMonotono(inicio, meta, ruta)) {
+        marcarRutaIndices(ruta);
+        estadisticas.bytesAuxiliares = memoria.bytesPico();
+        estadisticas.bytesVivos = memoria.bytesVivos();
+        estadisticas.asignaciones = memoria.asignaciones();
+        return true;
+    }
+
+    std::vector<int> subobjetivosOrigen, subobjetivosDestino;
+    grafo.conectar(inicio, subobjetivosOrigen);
+    grafo.conectar(meta, subobjetivosDestino);
+
+    // Nodos: identificadores de subobjetivo, más el origen (n) y el destino (n + 1) como nodos virtuales
+    int n = (int)grafo.capacidadIds();
+    int nodoOrigen = n, nodoDestino = n + 1;
+    std::unordered_map<int, uint32_t> hastaDestino; // Coste de cada subobjetivo directo del destino al destino
+    for (int celda : subobjetivosDestino) {
+        hastaDestino[grafo.identificador(celda)] = manhattan(celda, meta);
+    }
+    auto celdaNodo = [&](int nodo) {
+        return nodo == nodoOrigen ? inicio : nodo == nodoDestino ? meta : grafo.celdaDe(nodo);
+    };
+
+    std::vector<uint32_t, AsignadorContador<uint32_t>> g(n + 2, UINT32_MAX);
+    std::vector<int, AsignadorContador<int>> padre(n + 2, -1);
+    typedef std::pair<uint32_t, int> EntradaCola; // (f, nodo)
+    std::priority_queue<EntradaCola, std::vector<EntradaCola, AsignadorContador<EntradaCola>>,
+                        std::greater<EntradaCola>> abiertos;
+    g[nodoOrigen] = 0;
+    abiertos.push({manhattan(inicio, meta), nodoOrigen});
+    medidas.insercionesCola++;
+
+    auto relajar = [&](int desde, int hacia, uint32_t coste) {
+        medidas.nodosGenerados++;
+        if (g[desde] + coste < g[hacia]) {
+            g[hacia] = g[desde] + coste;
+            padre[hacia] = desde;
+            abiertos.push({g[hacia] + manhattan(celdaNodo(hacia), meta), hacia});
+            medidas.insercionesCola++;
+        }
+    };
+
+    while (!abiertos.empty()) {
+        EntradaCola entrada = abiertos.top();
+        abiertos.pop();
+        medidas.extraccionesCola++;
+        int nodo = entrada.second;
+        if (entrada.first != g[nodo] + manhattan(celdaNodo(nodo), meta)) continue; // Entrada obsoleta
+        if (nodo == nodoDestino) break;
+        medidas.nodosExpandidos++;
+
+        if (nodo == nodoOrigen) {
+            for (int celda : subobjetivosOrigen) relajar(nodo, grafo.identificador(celda), manhattan(inicio, celda));
+        } else {
+            for (int vecino : grafo.vecinos(nodo)) {
+                relajar(nodo, vecino, manhattan(grafo.celdaDe(nodo), grafo.celdaDe(vecino)));
+            }
+            auto directo = hastaDestino.find(nodo);
+            if (directo != hastaDestino.end()) relajar(nodo, nodoDestino, directo->second);
+        }
+        medidas.registrarFrontera(abiertos.size());
+    }
+
+    // Rellenamos cada tramo monótono entre subobjetivos consecutivos
+    ruta.clear();
+    if (g[nodoDestino] != UINT32_MAX) {
+        std::vector<int> cadena;
+        for (int nodo = nodoDestino; nodo != -1; nodo = padre[nodo]) {
+            cadena.push_back(celdaNodo(nodo));
+        }
+        std::reverse(cadena.begin(), cadena.end());
+        ruta.push_back(inicio);
+        for (size_t k = 1; k < cadena.size(); k++) {
+            if (cadena[k] != cadena[k - 1]) grafo.caminoMonotono(cadena[k - 1], cadena[k], ruta);
+        }
+    }
+    marcarRutaIndices(ruta);
+    size_t longitud = estadisticas.longitudRuta;
+    estadisticas = medidas;
+    estadisticas.longitudRuta = longitud;
+    estadisticas.bytesAuxiliares = memoria.bytesPico();
+    estadisticas.bytesVivos = memoria.bytesVivos();
+    estadisticas.asignaciones = memoria.asignaciones();
+    return !ruta.empty();
+}
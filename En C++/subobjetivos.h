@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "direcciones.h"
+
+class Grid;
+
+// Memoria de trabajo de un recorrido monótono (una marca por columna en la fila anterior y en la actual)
+struct BufferInundacion {
+    std::vector<char> previa;
+    std::vector<char> actual;
+};
+
+// Clase con el grafo de subobjetivos simple (SSG) de una grilla 4-conexa.
+// Los subobjetivos son las esquinas de los obstáculos: celdas libres con una diagonal bloqueada
+// cuyas dos celdas compartidas están libres. Dos subobjetivos se unen si uno alcanza al otro
+// por un camino monótono (longitud igual a la distancia de Manhattan) sin pasar por otro subobjetivo.
+// Toda ruta mínima se puede descomponer en tramos monótonos entre subobjetivos, así que la
+// consulta solo busca en este grafo pequeño y después rellena cada tramo.
+class GrafoSubobjetivos {
+private:
+    int filas = 0;
+    int columnas = 0;
+    uint64_t version = 0;     // Versión del mapa con la que está sincronizado
+    bool construido = false;
+    MapaBits bloqueadas;      // Copia del mapa de celdas bloqueadas (por filas)
+    std::vector<int> idCelda;     // Identificador de subobjetivo de cada celda (-1 si no lo es)
+    std::vector<int> celdaId;     // Celda de cada identificador (-1 si el identificador está libre)
+    std::vector<int> idsLibres;   // Identificadores reutilizables tras las ediciones
+    std::vector<std::vector<int>> aristas; // Subobjetivos alcanzables directamente desde cada uno
+
+    // Método que indica si la celda está dentro de la grilla y libre
+    bool libre(int fila, int columna) const;
+
+    // Método que indica si la celda libre es una esquina de obstáculo
+    bool esEsquina(int fila, int columna) const;
+
+    // Método que recorre las celdas alcanzables desde una celda moviéndose solo en el sentido
+    // (pasoFila, pasoColumna); añade los subobjetivos encontrados y no atraviesa ninguno
+    void inundarCuadrante(int indice, int pasoFila, int pasoColumna, BufferInundacion& buffer,
+                          std::vector<int>& encontrados) const;
+
+    // Método que añade un subobjetivo nuevo en la celda y devuelve su identificador
+    int agregarSubobjetivo(int indice);
+
+    // Método que elimina el subobjetivo de la celda y sus aristas
+    void eliminarSubobjetivo(int indice);
+
+    // Método que vuelve a calcular las aristas de los subobjetivos indicados
+    void recalcularAristas(const std::vector<int>& ids);
+
+public:
+    // Método que construye el grafo completo a partir de las celdas bloqueadas de la grilla
+    void construir(const Grid& grid);
+
+    // Método que actualiza el grafo tras cambiar el estado de una celda en la grilla.
+    // Solo se recalculan los subobjetivos que alcanzaban (o ahora alcanzan) directamente las celdas afectadas.
+    void actualizarCelda(const Grid& grid, int fila, int columna);
+
+    // Método que indica si el grafo corresponde a la versión actual del mapa de la grilla
+    bool sincronizado(const Grid& grid) const;
+
+    // Método que devuelve los subobjetivos alcanzables directamente desde una celda libre
+    // (índices de celda; si la celda es un subobjetivo, solo ella misma)
+    void conectar(int indice, std::vector<int>& subobjetivos) const;
+
+    // Método que busca un camino monótono entre dos celdas y añade a la ruta sus celdas sin incluir
+    // la primera; devuelve false si no existe (la distancia real es mayor que la de Manhattan)
+    bool caminoMonotono(int desde, int hasta, std::vector<int>& ruta) const;
+
+    // Métodos de acceso al grafo
+    int identificador(int indice) const { return idCelda[indice]; }
+    int celdaDe(int id) const { return celdaId[id]; }
+    size_t capacidadIds() const { return celdaId.size(); }
+    const std::vector<int>& vecinos(int id) const { return aristas[id]; }
+    int obtenerColumnas() const { return columnas; }
+
+    // Métodos para consultar el tamaño del grafo
+    size_t numeroSubobjetivos() const;
+    size_t numeroAristas() const;
+    size_t bytes() const;
+};
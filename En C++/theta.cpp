@@ -0,0 +1,121 @@
+#include <cmath>
+#include <functional>
+#include "entidades.h"
+
+// Desplazamientos de los 8 vecinos: primero los 4 cardinales y después las diagonales
+const int DESPLAZAMIENTO_OCTAL[8][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}, {-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+
+// Función de búsqueda Lazy Theta*: A* sobre 8 vecinos cuyo padre puede ser cualquier celda visible.
+// Al generar un vecino se supone que ve al padre de la celda expandida (sin comprobarlo); la línea
+// de visión solo se comprueba al expandirlo y, si falla, se toma el mejor vecino ya cerrado.
+bool Grid::ThetaPerezoso(Celda& origen, Celda& destino, std::vector<int>& puntos) {
+    reiniciar();
+    estadisticas.reiniciar();
+    MedicionMemoria memoria;
+    EstadisticasBusqueda medidas;
+    puntos.clear();
+    const MapaVisibilidad& mapa = mapaVisibilidad();
+    int inicio = indiceCelda(origen);
+    int meta = indiceCelda(destino);
+
+    auto distancia = [&](int a, int b) {
+        double df = a / columnas - b / columnas;
+        double dc = a % columnas - b % columnas;
+        return std::sqrt(df * df + dc * dc);
+    };
+    // Movimiento a uno de los 8 vecinos; en diagonal no se cortan esquinas de celdas bloqueadas
+    auto vecino = [&](int celda, int d) {
+        int nuevaFila = celda / columnas + DESPLAZAMIENTO_OCTAL[d][0];
+        int nuevaColumna = celda % columnas + DESPLAZAMIENTO_OCTAL[d][1];
+        if (nuevaFila < 0 || nuevaFila >= filas || nuevaColumna < 0 || nuevaColumna >= columnas) return -1;
+        if (mapa.bloqueada(nuevaFila, nuevaColumna)) return -1;
+        if (d >= 4 && (mapa.bloqueada(nuevaFila, celda % columnas) || mapa.bloqueada(celda / columnas, nuevaColumna))) {
+            return -1;
+        }
+        return nuevaFila * columnas + nuevaColumna;
+    };
+
+    size_t total = (size_t)filas * columnas;
+    std::vector<double, AsignadorContador<double>> g(total, INFINITY);
+    std::vector<int, AsignadorContador<int>> padre(total, -1);
+    MarcasCeldas cerrada(total, false);
+    typedef std::pair<double, int> EntradaCola; // (f, celda)
+    std::priority_queue<EntradaCola, std::vector<EntradaCola, AsignadorContador<EntradaCola>>,
+                        std::greater<EntradaCola>> abiertos;
+    g[inicio] = 0;
+    padre[inicio] = inicio;
+    abiertos.push({distancia(inicio, meta), inicio});
+    medidas.insercionesCola++;
+
+    bool encontrada = false;
+    while (!abiertos.empty()) {
+        int actual = abiertos.top().second;
+        abiertos.pop();
+        medidas.extraccionesCola++;
+        if (cerrada[actual]) continue; // Entrada obsoleta
+
+        // Comprobación diferida: un padre vecino en cruz siempre es visible; uno en diagonal puede
+        // cortar una esquina bloqueada (lo hereda de otra celda), así que también se comprueba
+        int p = padre[actual];
+        int df = std::abs(p / columnas - actual / columnas), dc = std::abs(p % columnas - actual % columnas);
+        if (df + dc > 1) {
+            medidas.comprobacionesVisibilidad++;
+            if (!mapa.lineaVisible(p / columnas, p % columnas, actual / columnas, actual % columnas)) {
+                g[actual] = INFINITY;
+                for (int d = 0; d < 8; d++) {
+                    int v = vecino(actual, d);
+                    if (v < 0 || !cerrada[v]) continue;
+                    double coste = g[v] + distancia(v, actual);
+                    if (coste < g[actual]) {
+                        g[actual] = coste;
+                        padre[actual] = v;
+                    }
+                }
+            }
+        }
+        cerrada[actual] = true;
+        if (actual == meta) {
+            encontrada = true;
+            break;
+        }
+        medidas.nodosExpandidos++;
+
+        // Cada vecino hereda como padre provisional el padre de la celda expandida
+        p = padre[actual];
+        for (int d = 0; d < 8; d++) {
+            int v = vecino(actual, d);
+            if (v < 0 || cerrada[v]) continue;
+            medidas.nodosGenerados++;
+            double coste = g[p] + distancia(p, v);
+            if (coste < g[v]) {
+                g[v] = coste;
+                padre[v] = p;
+                abiertos.push({coste + distancia(v, meta), v});
+                medidas.insercionesCola++;
+            }
+        }
+        medidas.registrarFrontera(abiertos.size());
+    }
+
+    // Puntos de paso desde el origen y celdas que recorren los segmentos entre ellos
+    std::vector<int> ruta;
+    if (encontrada) {
+        for (int celda = meta; celda != inicio; celda = padre[celda]) {
+            puntos.push_back(celda);
+        }
+        puntos.push_back(inicio);
+        std::reverse(puntos.begin(), puntos.end());
+        ruta.push_back(inicio);
+        for (size_t k = 1; k < puntos.size(); k++) {
+            trazarSegmento(puntos[k - 1] / columnas, puntos[k - 1] % columnas,
+                           puntos[k] / columnas, puntos[k] % columnas, columnas, ruta);
+        }
+    }
+    marcarRutaIndices(ruta); // Misma representación RUTA que el resto de búsquedas
+    medidas.longitudRuta = estadisticas.longitudRuta;
+    estadisticas = medidas;
+    estadisticas.bytesAuxiliares = memoria.bytesPico();
+    estadisticas.bytesVivos = memoria.bytesVivos();
+    estadisticas.asignaciones = memoria.asignaciones();
+    return encontrada;
+}
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cstdlib>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "entidades.h"
+#include "visibilidad.h"
+
+// Función que devuelve la parte entera por defecto de a / b (b > 0)
+static long long divisionSuelo(long long a, long long b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+// Función que devuelve la parte entera por exceso de a / b (b > 0)
+static long long divisionTecho(long long a, long long b) {
+    return -divisionSuelo(-a, b);
+}
+
+// Método que devuelve la máscara de visibilidad del mapa actual (se reconstruye si el mapa cambió)
+const MapaVisibilidad& Grid::mapaVisibilidad() {
+    if (!visibilidad.sincronizado(*this)) {
+        visibilidad.construir(*this);
+    }
+    return visibilidad;
+}
+
+// Método que suaviza una ruta por tensado de cuerda: desde cada punto de paso se avanza hasta la celda
+// más lejana de la ruta que se ve en línea recta. La búsqueda es exponencial y después binaria,
+// así que cada punto de paso cuesta O(log n) comprobaciones aunque la ruta tenga miles de pasos.
+std::vector<int> Grid::suavizarRuta(const std::vector<int>& ruta) {
+    std::vector<int> puntos;
+    if (ruta.empty()) return puntos;
+    const MapaVisibilidad& mapa = mapaVisibilidad();
+    auto visible = [&](size_t a, size_t b) {
+        estadisticas.comprobacionesVisibilidad++;
+        return mapa.lineaVisible(ruta[a] / columnas, ruta[a] % columnas, ruta[b] / columnas, ruta[b] % columnas);
+    };
+    size_t ultimo = ruta.size() - 1;
+    size_t ancla = 0;
+    puntos.push_back(ruta[0]);
+    while (ancla < ultimo) {
+        // Las celdas consecutivas de la ruta son vecinas, así que ancla + 1 siempre es visible
+        size_t visto = ancla + 1;
+        size_t oculto = ultimo + 1;
+        for (size_t salto = 2; visto < ultimo; salto *= 2) {
+            size_t candidato = std::min(ancla + salto, ultimo);
+            if (!visible(ancla, candidato)) {
+                oculto = candidato;
+                break;
+            }
+            visto = candidato;
+        }
+        while (oculto - visto > 1) {
+            size_t medio = visto + (oculto - visto) / 2;
+            if (visible(ancla, medio)) visto = medio;
+            else oculto = medio;
+        }
+        puntos.push_back(ruta[visto]);
+        ancla = visto;
+    }
+    return puntos;
+}
+
+// Método que copia las celdas bloqueadas de la grilla a la máscara de bits
+void MapaVisibilidad::construir(const Grid& grid) {
+    filas = grid.obtenerFilas();
+    columnas = grid.obtenerColumnas();
+    palabrasFila = (columnas + 63) / 64;
+    bloqueadas.assign((size_t)filas * palabrasFila, 0);
+    for (int i = 0; i < filas; i++) {
+        uint64_t* fila = &bloqueadas[(size_t)i * palabrasFila];
+        for (int j = 0; j < columnas; j++) {
+            if (grid.obtenerCelda(i, j).estado == BLOQUEADO) {
+                fila[j >> 6] |= 1ull << (j & 63);
+            }
+        }
+    }
+    version = grid.obtenerVersion();
+    construido = true;
+}
+
+// Método que indica si la máscara corresponde a la versión actual del mapa de la grilla
+bool MapaVisibilidad::sincronizado(const Grid& grid) const {
+    return construido && version == grid.obtenerVersion()
+        && filas == grid.obtenerFilas() && columnas == grid.obtenerColumnas();
+}
+
+// Método que indica si las columnas [desde, hasta] de una fila están todas libres
+bool MapaVisibilidad::tramoLibre(int fila, int desde, int hasta) const {
+    const uint64_t* palabras = &bloqueadas[(size_t)fila * palabrasFila];
+    int primera = desde >> 6;
+    int ultima = hasta >> 6;
+    uint64_t mascaraInicio = ~0ull << (desde & 63);
+    uint64_t mascaraFin = ~0ull >> (63 - (hasta & 63));
+    if (primera == ultima) {
+        return (palabras[primera] & mascaraInicio & mascaraFin) == 0;
+    }
+    if (palabras[primera] & mascaraInicio) return false;
+    int w = primera + 1;
+#ifdef __SSE2__
+    // Palabras intermedias de 4 en 4 (256 celdas) con registros de 128 bits
+    const __m128i cero = _mm_setzero_si128();
+    for (; w + 3 < ultima; w += 4) {
+        __m128i bloque = _mm_or_si128(_mm_loadu_si128((const __m128i*)(palabras + w)),
+                                      _mm_loadu_si128((const __m128i*)(palabras + w + 2)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(bloque, cero)) != 0xFFFF) return false;
+    }
+#endif
+    for (; w < ultima; w++) {
+        if (palabras[w]) return false;
+    }
+    return (palabras[ultima] & mascaraFin) == 0;
+}
+
+// Método que indica si el segmento entre los centros de dos celdas no toca ninguna celda bloqueada.
+// En la fila k (contando desde la primera) el segmento va del parámetro (2k - 1) / 2df al (2k + 1) / 2df,
+// así que las columnas que cubre se calculan con aritmética entera sin errores de redondeo.
+bool MapaVisibilidad::lineaVisible(int fila0, int columna0, int fila1, int columna1) const {
+    if (fila0 > fila1) {
+        std::swap(fila0, fila1);
+        std::swap(columna0, columna1);
+    }
+    int df = fila1 - fila0;
+    int dc = columna1 - columna0;
+    int minima = std::min(columna0, columna1);
+    int maxima = std::max(columna0, columna1);
+    if (df == 0) {
+        return tramoLibre(fila0, minima, maxima);
+    }
+    for (int k = 0; k <= df; k++) {
+        long long a = (long long)dc * (k == 0 ? 0 : 2 * k - 1);
+        long long b = (long long)dc * (k == df ? 2 * df : 2 * k + 1);
+        if (a > b) std::swap(a, b);
+        // Una columna está cubierta si el segmento entra en [c - 1/2, c + 1/2] (bordes incluidos)
+        int desde = columna0 + (int)divisionTecho(a - df, 2LL * df);
+        int hasta = columna0 + (int)divisionSuelo(b + df, 2LL * df);
+        if (!tramoLibre(fila0 + k, std::max(desde, minima), std::min(hasta, maxima))) return false;
+    }
+    return true;
+}
+
+// Función que añade a la lista las celdas que atraviesa un segmento, en pasos de 4 vecinos:
+// en cada paso se cruza el borde (vertical u horizontal) que el segmento alcanza antes
+void trazarSegmento(int fila0, int columna0, int fila1, int columna1, int columnas, std::vector<int>& celdas) {
+    long long df = std::abs(fila1 - fila0);
+    long long dc = std::abs(columna1 - columna0);
+    int pasoFila = fila1 > fila0 ? 1 : -1;
+    int pasoColumna = columna1 > columna0 ? 1 : -1;
+    int fila = fila0, columna = columna0;
+    for (long long i = 0, j = 0; i < df || j < dc;) {
+        if ((1 + 2 * j) * df < (1 + 2 * i) * dc) {
+            columna += pasoColumna;
+            j++;
+        } else {
+            fila += pasoFila;
+            i++;
+        }
+        celdas.push_back(fila * columnas + columna);
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Grid;
+
+// Clase con la máscara de celdas bloqueadas empaquetada en bits (una fila por bloque de palabras
+// de 64 bits) para comprobar la línea de visión entre centros de celdas. La línea se recorre fila
+// a fila: en cada fila cubre un tramo contiguo de columnas que se comprueba con máscaras de
+// palabra completa en lugar de celda a celda.
+class MapaVisibilidad {
+private:
+    int filas = 0;
+    int columnas = 0;
+    int palabrasFila = 0;    // Palabras de 64 bits por fila
+    uint64_t version = 0;    // Versión del mapa con la que está sincronizado
+    bool construido = false;
+    std::vector<uint64_t> bloqueadas; // Bit activo = celda bloqueada
+
+public:
+    // Método que copia las celdas bloqueadas de la grilla a la máscara de bits
+    void construir(const Grid& grid);
+
+    // Método que indica si la máscara corresponde a la versión actual del mapa de la grilla
+    bool sincronizado(const Grid& grid) const;
+
+    // Método que indica si la celda está bloqueada
+    bool bloqueada(int fila, int columna) const {
+        return (bloqueadas[(size_t)fila * palabrasFila + (columna >> 6)] >> (columna & 63)) & 1;
+    }
+
+    // Método que indica si las columnas [desde, hasta] de una fila están todas libres
+    bool tramoLibre(int fila, int desde, int hasta) const;
+
+    // Método que indica si el segmento entre los centros de dos celdas no toca ninguna celda bloqueada
+    // (si pasa justo por una esquina, las cuatro celdas que la comparten deben estar libres)
+    bool lineaVisible(int fila0, int columna0, int fila1, int columna1) const;
+
+    // Método que devuelve los bytes ocupados por la máscara
+    size_t bytes() const {
+        return bloqueadas.size() * sizeof(uint64_t);
+    }
+};
+
+// Función que añade a la lista los índices (por filas) de las celdas que atraviesa un segmento,
+// en pasos de 4 vecinos y sin incluir la primera celda
+void trazarSegmento(int fila0, int columna0, int fila1, int columna1, int columnas, std::vector<int>& celdas);